@@ -39,6 +39,7 @@
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
@@ -95,6 +96,14 @@ namespace client {
         /// or more interface objects but no remote handler.
         void m_connectNeededCallbacks();
 
+        /// @brief Before a partial tree update: records what each connected
+        /// path currently resolves to.
+        void m_recordHandlerSources();
+
+        /// @brief After a partial tree update: reconnects only those paths
+        /// that now resolve differently, plus any still unconnected.
+        void m_reconnectChangedCallbacks();
+
         /// @brief Access the client context's logger.
         util::log::LoggerPtr const &logger() const;
 
@@ -115,6 +124,10 @@ namespace client {
 
         /// @brief The client context that owns us.
         common::ClientContext *m_ctx;
+
+        /// @brief Summary of the resolved source of each connected path,
+        /// from before a partial tree update.
+        std::unordered_map<std::string, std::string> m_sourcesBeforeUpdate;
     };
 } // namespace client
 } // namespace osvr
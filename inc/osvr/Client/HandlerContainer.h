@@ -40,10 +40,19 @@ namespace client {
     /// @brief Wrapper for a container of handlers.
     class HandlerContainer {
       public:
+        /// @brief Updates all handlers, then applies and calls back for any
+        /// reports they held on to, in that order, so state set from one
+        /// message is complete before any callback for it runs.
         void update() {
             for (auto const &handler : m_handlers) {
                 handler->update();
             }
+            for (auto const &handler : m_handlers) {
+                handler->applyPendingState();
+            }
+            for (auto const &handler : m_handlers) {
+                handler->triggerPendingCallbacks();
+            }
         }
 
         void add(RemoteHandlerPtr const &handler) {
@@ -40,7 +40,21 @@ namespace client {
     class RemoteHandler {
       public:
         virtual ~RemoteHandler();
+        /// @brief Receives new reports. Most handlers also deliver them to
+        /// their interfaces right away.
         virtual void update() = 0;
+
+        /// @brief For handlers that hold on to reports received in update():
+        /// sets interface state from them.
+        ///
+        /// Called on every handler after all have been updated, and before
+        /// any triggerPendingCallbacks(), so callbacks for reports that
+        /// arrived together (such as a batch) see all of their state.
+        virtual void applyPendingState();
+
+        /// @brief For handlers that hold on to reports received in update():
+        /// calls the callbacks for them.
+        virtual void triggerPendingCallbacks();
     };
     typedef shared_ptr<RemoteHandler> RemoteHandlerPtr;
 } // namespace client
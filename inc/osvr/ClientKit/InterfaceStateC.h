@@ -74,6 +74,25 @@ OSVR_CALLBACK_METHODS(NaviPosition)
 
 #undef OSVR_CALLBACK_METHODS
 
+/** @brief Get the pose of an interface predicted for a given time, returning
+    failure if it has no pose state.
+
+    Pass the time your frame's photons will actually reach the eye, for
+    instance, to compensate for transport and rendering latency. The
+    prediction extrapolates the last pose received with a constant-velocity
+    model. It uses the velocity reports the device sends, if it does, and
+    otherwise estimates the velocity from consecutive poses. With no motion
+    known, it is the last pose.
+
+    @param iface The interface.
+    @param targetTime The time to predict the pose for.
+    @param [out] state The predicted pose.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrGetPredictedPoseState(OSVR_ClientInterface iface,
+                          struct OSVR_TimeValue const *targetTime,
+                          OSVR_PoseState *state);
+
 OSVR_EXTERN_C_END
 
 #endif
@@ -237,7 +237,7 @@ namespace common {
             /// Safe to do without violating strict aliasing because ElementType
             /// is a character type.
             ElementType const *src = reinterpret_cast<ElementType const *>(&v);
-            m_buf.insert(m_buf.end(), src, src + sizeof(T));
+            append(src, sizeof(T));
         }
 
         /// @brief Append the binary representation of a value, after adding the
@@ -253,7 +253,11 @@ namespace common {
 
         /// @brief Append a byte-array's contents
         void append(ElementType const *v, size_t const n) {
-            m_buf.insert(m_buf.end(), v, v + n);
+            // Cheaper than a range insert for the small appends that make up
+            // most messages.
+            auto const existing = m_buf.size();
+            m_buf.resize(existing + n);
+            std::copy(v, v + n, m_buf.begin() + existing);
         }
 
         /// @brief Append a byte-array's contents, after adding the necessary
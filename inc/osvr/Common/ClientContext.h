@@ -43,6 +43,7 @@
 #include <boost/any.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <map>
@@ -109,6 +110,11 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     OSVR_COMMON_EXPORT void
     setRoomToWorldTransform(osvr::common::Transform const &xform);
 
+    /// @brief Gets a counter that changes every time the room to world
+    /// transform is set, so that handlers can cache transforms composed with
+    /// it and only recompute them when needed.
+    OSVR_COMMON_EXPORT std::size_t getRoomToWorldTransformGeneration() const;
+
     /// @brief Returns the specialized deleter for this object.
     OSVR_COMMON_EXPORT osvr::common::ClientContextDeleter getDeleter() const;
 
@@ -168,6 +174,7 @@ struct OSVR_ClientContextObject : boost::noncopyable {
 
     osvr::util::MultipleKeyedOwnershipContainer m_ownedObjects;
     osvr::common::ClientContextDeleter m_deleter;
+    std::size_t m_roomToWorldGeneration = 0;
 
     /// Logger for the use of OSVR libraries on behalf of the client
     osvr::util::log::LoggerPtr m_logger;
@@ -31,6 +31,7 @@
 #include <osvr/Common/ClientInterfacePtr.h>
 #include <osvr/Common/InterfaceState.h>
 #include <osvr/Common/InterfaceCallbacks.h>
+#include <osvr/Common/PosePredictor.h>
 #include <osvr/Common/StateType.h>
 #include <osvr/Common/ReportStateTraits.h>
 #include <osvr/Common/Tracing.h>
@@ -93,6 +94,16 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
             "Should only call setState if we're keeping state for this report "
             "type!");
         m_state.setStateFromReport(timestamp, report);
+        m_predictor.update(timestamp, report);
+    }
+
+    /// @brief If this interface has pose state, predicts its pose at @p target
+    /// (such as when a frame will be displayed) from the last pose and its
+    /// velocity, and returns true.
+    bool getPredictedPose(OSVR_TimeValue const &target,
+                          OSVR_PoseState &pose) const {
+        osvr::common::tracing::markGetState(m_path);
+        return m_predictor.predict(target, pose);
     }
     /// @}
 
@@ -133,6 +144,7 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     std::string const m_path;
     osvr::common::InterfaceCallbacks m_callbacks;
     osvr::common::InterfaceState m_state;
+    osvr::common::PosePredictor m_predictor;
     boost::any m_data;
 };
 
@@ -141,12 +141,12 @@ namespace common {
             : detail::IntegerByteOrderSwap<T> {};
 #endif
 
-#if 0
-        /// @todo not sure how to do this on arm mixed-endian.
-        template<>
-        struct NetworkByteOrderTraits<float, void> : detail::TypePunByteOrder<float, uint32_t> {
-        };
-#endif
+        /// @brief A float is a single word, so (unlike a double) word order
+        /// doesn't come into it even on mixed-endian systems: byte order is
+        /// the same as for a 32-bit integer.
+        template <>
+        struct NetworkByteOrderTraits<float, void>
+            : detail::TypePunByteOrder<float, uint32_t> {};
 
 #if defined(OSVR_FLOAT_ORDER_MIXED)
         template <> struct NetworkByteOrderTraits<double, void> {
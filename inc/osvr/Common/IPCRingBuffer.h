@@ -36,6 +36,8 @@
 
 // Standard includes
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -62,6 +64,13 @@ namespace common {
     /// segment name and signalling new data, and no guarantee that the data you
     /// were notified about won't be overwritten - just that if you're currently
     /// accessing data, we won't overwrite that.
+    ///
+    /// Readers may additionally register a cursor in the shared bookkeeping
+    /// (see registerReader()): they can then consume entries in order with
+    /// getNext(), block for new entries with waitForNext() instead of relying
+    /// on the outside channel, and the producer can see via
+    /// getAllReaderStats() how far behind each of them is and how many
+    /// entries each has missed.
     class IPCRingBuffer : public enable_shared_from_this<IPCRingBuffer> {
       public:
         typedef uint8_t BackendType;
@@ -69,6 +78,7 @@ namespace common {
         typedef uint16_t entry_count_type;
         typedef uint32_t entry_size_type;
         typedef uint32_t abi_level_type;
+        typedef uint8_t reader_count_type;
         class Options {
           public:
             OSVR_COMMON_EXPORT Options();
@@ -81,31 +91,42 @@ namespace common {
 
             /// @brief sets the name, after sanitizing the input string.
             /// @return *this for chained method idiom.
-            Options &setName(std::string const &name);
+            OSVR_COMMON_EXPORT Options &setName(std::string const &name);
             std::string const &getName() const { return m_name; }
 
             /// @brief Sets the alignment for each entry, which must be a power
             /// of 2 (rounded up to the nearest if it's not).
             /// @return *this for chained method idiom.
-            Options &setAlignment(alignment_type alignment);
+            OSVR_COMMON_EXPORT Options &
+            setAlignment(alignment_type alignment);
             alignment_type getAlignment() const { return m_alignment; }
 
             /// @brief Sets the number of entries in the ring buffer.
             /// @return *this for chained method idiom.
-            Options &setEntries(entry_count_type entries);
+            OSVR_COMMON_EXPORT Options &
+            setEntries(entry_count_type entries);
             entry_count_type getEntries() const { return m_entries; }
 
             /// @brief Sets the size of each entry in the ring buffer.
             /// @return *this for chained method idiom.
-            Options &setEntrySize(entry_size_type entrySize);
+            OSVR_COMMON_EXPORT Options &
+            setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Sets the maximum number of reader cursors that may be
+            /// registered at once. Only used when creating.
+            /// @return *this for chained method idiom.
+            OSVR_COMMON_EXPORT Options &
+            setMaxReaders(reader_count_type readers);
+            reader_count_type getMaxReaders() const { return m_maxReaders; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
             alignment_type m_alignment = 16;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
+            reader_count_type m_maxReaders = 8;
         };
 
         /// @brief Gets an integer representing a unique arrangement of the
@@ -154,6 +175,22 @@ namespace common {
 
         typedef shared_ptr<value_type> smart_pointer_type;
 
+        /// @brief The state of a registered reader cursor.
+        struct ReaderStats {
+            /// @brief Whether this reader slot is in use.
+            bool active = false;
+            /// @brief The sequence number the reader will consume next.
+            sequence_type next = 0;
+            /// @brief Number of entries the reader has consumed.
+            uint64_t consumed = 0;
+            /// @brief Number of entries that were overwritten or skipped
+            /// before the reader got to them.
+            uint64_t missed = 0;
+            /// @brief Number of published entries the reader has yet to
+            /// consume, at the time of the snapshot.
+            sequence_type lag = 0;
+        };
+
         /// @brief A class providing write access to the next available element
         /// in the ring buffer, owning the appropriate mutex locks and providing
         /// access to the sequence number.
@@ -166,12 +203,17 @@ namespace common {
             BufferWriteProxy &operator=(BufferWriteProxy const &) = delete;
 
             /// @brief move-constructible
-            BufferWriteProxy(BufferWriteProxy &&other) {
+            BufferWriteProxy(BufferWriteProxy &&other)
+                : m_buf(nullptr), m_seq(0) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
             }
 
             /// @brief move-assignable
             BufferWriteProxy &operator=(BufferWriteProxy &&other) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
                 return *this;
             }
@@ -239,6 +281,10 @@ namespace common {
         /// the buffer. You're responsible for doing the copying and, once you
         /// let the returned object exit scope, the notification (possibly with
         /// sequence number)
+        ///
+        /// Only the element itself stays locked while you hold the proxy, so
+        /// it's fine to fill it in place (e.g. decode straight into it):
+        /// readers of other elements are not held up.
         OSVR_COMMON_EXPORT BufferWriteProxy put();
 
         /// @brief Gets access to an element in the buffer by sequence number:
@@ -250,6 +296,38 @@ namespace common {
         /// also contains the associated sequence number.
         OSVR_COMMON_EXPORT BufferReadProxy getLatest();
 
+        /// @brief Registers a reader cursor for this handle, positioned at the
+        /// next entry to be published. Subsequent get() calls also advance the
+        /// cursor. Released automatically when this object is destroyed.
+        ///
+        /// @returns false if all reader slots are taken.
+        OSVR_COMMON_EXPORT bool registerReader();
+
+        /// @brief Whether this handle has a registered reader cursor.
+        OSVR_COMMON_EXPORT bool hasReaderCursor() const;
+
+        /// @brief Gets the entry at this handle's reader cursor, and advances
+        /// it. If the producer has overwritten entries the reader hadn't
+        /// consumed yet, skips ahead to the oldest available one and counts
+        /// the rest as missed.
+        ///
+        /// Returns an invalid proxy if there is nothing new or if no cursor is
+        /// registered.
+        OSVR_COMMON_EXPORT BufferReadProxy getNext();
+
+        /// @brief Blocks until an entry past this handle's reader cursor has
+        /// been published, or the timeout elapses.
+        ///
+        /// @returns true if there is a new entry to get with getNext().
+        OSVR_COMMON_EXPORT bool waitForNext(uint32_t timeoutMilliseconds);
+
+        /// @brief Gets the state of this handle's reader cursor.
+        OSVR_COMMON_EXPORT ReaderStats getReaderStats() const;
+
+        /// @brief Gets the state of every reader slot, for instance so the
+        /// producer can tell which readers are falling behind.
+        OSVR_COMMON_EXPORT std::vector<ReaderStats> getAllReaderStats() const;
+
         /// @brief Destructor.
         OSVR_COMMON_EXPORT ~IPCRingBuffer();
 
@@ -33,12 +33,16 @@
 #include <osvr/Util/ImagingReportTypesC.h>
 #include <osvr/Common/IPCRingBuffer.h>
 #include <osvr/Common/ImagingComponentConfig.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
+#include <osvr/Util/UniquePtr.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <vrpn_BaseClass.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -69,8 +73,28 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+        class ImageWireRequest
+            : public MessageRegistration<ImageWireRequest> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
+    /// @brief Counters for the image data sent over a single transport.
+    struct ImagingTransportStats {
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+    };
+
+    /// @brief Counters for the image data sent for a single sensor, by
+    /// transport.
+    struct ImagingSensorStats {
+        ImagingTransportStats wire;
+        ImagingTransportStats sharedMemory;
+        ImagingTransportStats inProcessMemory;
+    };
+
     /// @brief BaseDevice component
     class ImagingComponent : public DeviceComponent {
       public:
@@ -94,10 +118,47 @@ namespace common {
         messages::ImagePlacedInProcessMemory imagePlacedInProcessMemory;
 #endif
 
+        /// @brief Message from client to server, asking for a sensor's images
+        /// to be sent on the wire because shared memory isn't usable by that
+        /// client. Must be repeated periodically to stay in effect.
+        messages::ImageWireRequest imageWireRequest;
+
         OSVR_COMMON_EXPORT void sendImageData(
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
 
+        /// @brief Claims storage for the next frame from the given sensor, so
+        /// the image can be written directly into it (in shared memory, where
+        /// available) rather than copied there by sendImageData().
+        ///
+        /// The storage stays claimed until sendAcquiredImageData() is called
+        /// for the same sensor; acquiring again before then abandons the
+        /// earlier frame.
+        ///
+        /// @return A buffer of the size described by the metadata, or nullptr
+        /// if storage could not be obtained.
+        OSVR_COMMON_EXPORT OSVR_ImageBufferElement *
+        acquireImageBuffer(OSVR_ImagingMetadata const &metadata,
+                           OSVR_ChannelCount sensor);
+
+        /// @brief Sends the frame written into the buffer returned by the most
+        /// recent acquireImageBuffer() for that sensor.
+        ///
+        /// @return false if there was no acquired buffer to send.
+        OSVR_COMMON_EXPORT bool
+        sendAcquiredImageData(OSVR_ChannelCount sensor,
+                              OSVR_TimeValue const &timestamp);
+
+        /// @brief Gets the counters for the data sent for a sensor, by
+        /// transport.
+        OSVR_COMMON_EXPORT ImagingSensorStats
+        getSensorStats(OSVR_ChannelCount sensor) const;
+
+        /// @brief Server side: gets the state of the shared memory readers of a
+        /// sensor's images, to see which ones are falling behind.
+        OSVR_COMMON_EXPORT std::vector<IPCRingBuffer::ReaderStats>
+        getSharedMemoryReaderStats(OSVR_ChannelCount sensor) const;
+
         typedef std::function<void(ImageData const &,
                                    util::time::TimeValue const &)> ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
@@ -112,6 +173,19 @@ namespace common {
                                             OSVR_ChannelCount sensor,
                                             OSVR_TimeValue const &timestamp);
 
+        /// @brief Gets the ring buffer for the sensor, (re-)creating it if
+        /// required to fit the metadata.
+        /// @return nullptr if the ring buffer could not be created.
+        IPCRingBuffer *m_getShmBuf(OSVR_ImagingMetadata const &metadata,
+                                   OSVR_ChannelCount sensor);
+
+        /// @brief Notifies clients of an image placed in shared memory.
+        void m_sendSharedMemoryNotification(OSVR_ImagingMetadata metadata,
+                                            IPCRingBuffer::sequence_type seq,
+                                            OSVR_ChannelCount sensor,
+                                            IPCRingBuffer const &shm,
+                                            OSVR_TimeValue const &timestamp);
+
         /// @return true if we could send it.
         bool m_sendImageDataOnTheWire(OSVR_ImagingMetadata metadata,
                                       OSVR_ImageBufferElement *imageData,
@@ -124,11 +198,31 @@ namespace common {
                                                OSVR_ImageBufferElement *imageData,
                                                OSVR_ChannelCount sensor,
                                                OSVR_TimeValue const &timestamp);
+
+        /// @brief Hands ownership of the buffer to the in-process message.
+        void m_sendInProcessNotification(OSVR_ImagingMetadata metadata,
+                                         util::AlignedImageBufferPtr &&buffer,
+                                         OSVR_ChannelCount sensor,
+                                         OSVR_TimeValue const &timestamp);
 #endif
 
         static int VRPN_CALLBACK
         m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p);
 
+        static int VRPN_CALLBACK
+        m_handleImageWireRequest(void *userdata, vrpn_HANDLERPARAM p);
+
+        /// @brief Server side: whether any client has recently asked for the
+        /// sensor's images on the wire.
+        bool m_isWireRequested(OSVR_ChannelCount sensor) const;
+
+        /// @brief Client side: ask the server for the sensor's images on the
+        /// wire, unless we've done so recently.
+        void m_requestWire(OSVR_ChannelCount sensor);
+
+        /// @brief Gets the stats for a sensor, growing the vector if needed.
+        ImagingSensorStats &m_getStats(OSVR_ChannelCount sensor);
+
         static int VRPN_CALLBACK
         m_handleImagePlacedInSharedMemory(void *userdata, vrpn_HANDLERPARAM p);
 
@@ -145,6 +239,30 @@ namespace common {
         bool m_gotOne;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+
+        /// @brief A frame claimed by acquireImageBuffer() and not yet sent.
+        struct AcquiredFrame {
+            OSVR_ImagingMetadata metadata;
+            OSVR_ImageBufferElement *buffer = nullptr;
+            /// @brief Ring buffer the frame was claimed from.
+            IPCRingBufferPtr shm;
+            /// @brief Holds the ring buffer element locked while it is filled.
+            unique_ptr<IPCRingBuffer::BufferWriteProxy> proxy;
+#ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+            util::AlignedImageBufferPtr inProcessBuffer;
+#endif
+        };
+        /// @brief One for each sensor
+        std::vector<AcquiredFrame> m_acquired;
+
+        /// @brief Server side: when a client last asked for each sensor's
+        /// images on the wire. One for each sensor, sized on construction.
+        std::vector<util::time::TimeValue> m_wireRequested;
+        /// @brief Client side: when we last asked for each sensor's images on
+        /// the wire.
+        std::vector<util::time::TimeValue> m_wireRequestSent;
+        /// @brief One for each sensor
+        std::vector<ImagingSensorStats> m_stats;
     };
 } // namespace common
 } // namespace osvr
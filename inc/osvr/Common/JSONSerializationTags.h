@@ -37,6 +37,7 @@
 // Standard includes
 #include <string>
 #include <stdexcept>
+#include <cstdint>
 
 namespace osvr {
 namespace common {
@@ -97,6 +98,175 @@ namespace common {
         struct SerializationTraits<JsonOnlyMessageTag, void>
             : JSONSerializationTraitsBase<JsonOnlyMessageTag,
                                           StringOnlyMessageTag> {};
+
+        /// @brief A tag for serializing JSON in a compact binary form rather
+        /// than as text, so that the receiving end doesn't have to run the
+        /// JSON parser.
+        struct JsonBinaryTag {};
+
+        /// @brief Traits invoked by using JsonBinaryTag: each value is a type
+        /// byte (the Json::ValueType) followed by its data, with arrays and
+        /// objects prefixed by their element count.
+        template <>
+        struct SerializationTraits<JsonBinaryTag, void>
+            : BaseSerializationTraits<Json::Value> {
+            typedef BaseSerializationTraits<Json::Value> Base;
+            typedef JsonBinaryTag tag_type;
+            typedef uint8_t type_code;
+            typedef uint32_t count_type;
+
+            template <typename BufferType>
+            static void serialize(BufferType &buf, Base::param_type val,
+                                  tag_type const &tag) {
+                serializeRaw(buf, static_cast<type_code>(val.type()));
+                switch (val.type()) {
+                case Json::nullValue:
+                    break;
+                case Json::intValue:
+                    serializeRaw(buf, static_cast<int64_t>(val.asLargestInt()));
+                    break;
+                case Json::uintValue:
+                    serializeRaw(buf,
+                                 static_cast<uint64_t>(val.asLargestUInt()));
+                    break;
+                case Json::realValue:
+                    serializeRaw(buf, val.asDouble());
+                    break;
+                case Json::stringValue:
+                    serializeRaw(buf, val.asString());
+                    break;
+                case Json::booleanValue:
+                    serializeRaw(buf, val.asBool());
+                    break;
+                case Json::arrayValue:
+                    serializeRaw(buf, static_cast<count_type>(val.size()));
+                    for (auto const &elt : val) {
+                        serialize(buf, elt, tag);
+                    }
+                    break;
+                case Json::objectValue:
+                    serializeRaw(buf, static_cast<count_type>(val.size()));
+                    for (auto it = val.begin(), e = val.end(); it != e; ++it) {
+                        serializeRaw(buf, it.name());
+                        serialize(buf, *it, tag);
+                    }
+                    break;
+                }
+            }
+
+            template <typename BufferReaderType>
+            static void deserialize(BufferReaderType &buf,
+                                    Base::reference_type val,
+                                    tag_type const &tag) {
+                type_code type;
+                deserializeRaw(buf, type);
+                switch (type) {
+                case Json::nullValue:
+                    val = Json::Value();
+                    break;
+                case Json::intValue: {
+                    int64_t v;
+                    deserializeRaw(buf, v);
+                    val = static_cast<Json::LargestInt>(v);
+                    break;
+                }
+                case Json::uintValue: {
+                    uint64_t v;
+                    deserializeRaw(buf, v);
+                    /// Match what the JSON parser would have given us.
+                    auto maxInt =
+                        static_cast<uint64_t>(Json::Value::maxLargestInt);
+                    if (v <= maxInt) {
+                        val = static_cast<Json::LargestInt>(v);
+                    } else {
+                        val = static_cast<Json::LargestUInt>(v);
+                    }
+                    break;
+                }
+                case Json::realValue: {
+                    double v;
+                    deserializeRaw(buf, v);
+                    val = v;
+                    break;
+                }
+                case Json::stringValue: {
+                    std::string v;
+                    deserializeRaw(buf, v);
+                    val = v;
+                    break;
+                }
+                case Json::booleanValue: {
+                    bool v;
+                    deserializeRaw(buf, v);
+                    val = v;
+                    break;
+                }
+                case Json::arrayValue: {
+                    count_type n;
+                    deserializeRaw(buf, n);
+                    val = Json::Value(Json::arrayValue);
+                    for (count_type i = 0; i < n; ++i) {
+                        deserialize(buf, val[i], tag);
+                    }
+                    break;
+                }
+                case Json::objectValue: {
+                    count_type n;
+                    deserializeRaw(buf, n);
+                    val = Json::Value(Json::objectValue);
+                    std::string name;
+                    for (count_type i = 0; i < n; ++i) {
+                        deserializeRaw(buf, name);
+                        deserialize(buf, val[name], tag);
+                    }
+                    break;
+                }
+                default:
+                    throw std::runtime_error(
+                        "Unknown value type in binary JSON!");
+                }
+            }
+
+            static size_t spaceRequired(size_t existingBytes,
+                                        Base::param_type val,
+                                        tag_type const &tag) {
+                auto bytes = existingBytes;
+                bytes += getBufferSpaceRequiredRaw(bytes, type_code());
+                switch (val.type()) {
+                case Json::nullValue:
+                    break;
+                case Json::intValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, int64_t());
+                    break;
+                case Json::uintValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, uint64_t());
+                    break;
+                case Json::realValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, double());
+                    break;
+                case Json::stringValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, val.asString());
+                    break;
+                case Json::booleanValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, OSVR_CBool());
+                    break;
+                case Json::arrayValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, count_type());
+                    for (auto const &elt : val) {
+                        bytes += spaceRequired(bytes, elt, tag);
+                    }
+                    break;
+                case Json::objectValue:
+                    bytes += getBufferSpaceRequiredRaw(bytes, count_type());
+                    for (auto it = val.begin(), e = val.end(); it != e; ++it) {
+                        bytes += getBufferSpaceRequiredRaw(bytes, it.name());
+                        bytes += spaceRequired(bytes, *it, tag);
+                    }
+                    break;
+                }
+                return bytes - existingBytes;
+            }
+        };
     } // namespace serialization
 
 } // namespace common
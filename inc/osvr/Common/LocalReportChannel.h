@@ -0,0 +1,150 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LocalReportChannel_h_GUID_3B8E1F27_6C4D_4A95_B1D2_7E09A5C3F648
+#define INCLUDED_LocalReportChannel_h_GUID_3B8E1F27_6C4D_4A95_B1D2_7E09A5C3F648
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/UniquePtr.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace common {
+    class LocalReportChannel;
+    /// @brief Pointer type for holding a local report channel.
+    typedef shared_ptr<LocalReportChannel> LocalReportChannelPtr;
+
+    /// @brief A tracker report as carried by a LocalReportChannel: plain data,
+    /// so it can be copied straight into and out of shared memory.
+    struct LocalTrackerReport {
+        enum class Type : uint8_t { Pose, Velocity, Acceleration };
+        Type type;
+        OSVR_ChannelCount sensor;
+        OSVR_TimeValue timestamp;
+        union {
+            OSVR_PoseState pose;
+            OSVR_VelocityState velocity;
+            OSVR_AccelerationState acceleration;
+        };
+    };
+
+    /// @brief Carries one device's tracker reports to clients on the same
+    /// host through shared memory, instead of packing them as VRPN messages,
+    /// sending them over a socket (or a loopback connection) and parsing them
+    /// back out.
+    ///
+    /// A fixed-size broadcast ring with a single writer (the device, on the
+    /// server) and any number of readers, none of which ever take a lock: each
+    /// slot carries a sequence number that the writer bumps before and after
+    /// filling it, so a reader can tell if it copied a slot mid-write. A
+    /// reader that falls more than a ring's worth behind skips ahead, counting
+    /// the reports it missed, and never holds up the writer.
+    ///
+    /// Channels live in a namespace, so that more than one server (or joint
+    /// client/server process) on a host can each have their own.
+    class LocalReportChannel : boost::noncopyable {
+      public:
+        typedef uint64_t sequence_type;
+
+        /// @brief The namespace used by a server listening on the given port
+        /// (0 for the default port).
+        OSVR_COMMON_EXPORT static std::string getServerNamespace(int port = 0);
+
+        /// @brief Makes up a namespace that nothing else on the host will be
+        /// using, for a server and client that share a process.
+        OSVR_COMMON_EXPORT static std::string makeUniqueNamespace();
+
+        /// @brief Given the server part of a device name (a host, possibly
+        /// with a port), returns the namespace that server would publish local
+        /// reports in, or an empty string if it's not on this host.
+        OSVR_COMMON_EXPORT static std::string
+        getNamespaceForServer(std::string const &server);
+
+        /// @brief Named constructor, for the device: creates the channel,
+        /// replacing any stale one of the same name.
+        ///
+        /// @return an empty pointer if shared memory (or lock-free 64-bit
+        /// atomics) aren't available, in which case reports should go by the
+        /// usual connection.
+        OSVR_COMMON_EXPORT static LocalReportChannelPtr
+        create(std::string const &ns, std::string const &deviceName,
+               uint32_t capacity = 256);
+
+        /// @brief Named constructor, for a client: opens an existing channel
+        /// and positions this reader at the next report to be sent.
+        ///
+        /// @return an empty pointer if there's no such channel.
+        OSVR_COMMON_EXPORT static LocalReportChannelPtr
+        open(std::string const &ns, std::string const &deviceName);
+
+        /// @brief Publishes a report. Only valid on the channel returned by
+        /// create(), and only from one thread at a time.
+        OSVR_COMMON_EXPORT void send(LocalTrackerReport const &report);
+
+        /// @brief Copies out the next report this reader hasn't seen yet.
+        ///
+        /// @return false if there's nothing new.
+        OSVR_COMMON_EXPORT bool receive(LocalTrackerReport &report);
+
+        /// @brief Number of reports this reader skipped because they were
+        /// overwritten before it got to them.
+        OSVR_COMMON_EXPORT sequence_type getMissed() const;
+
+        /// @brief The name of the underlying shared memory segment.
+        OSVR_COMMON_EXPORT std::string const &getName() const;
+
+        /// @brief False once the device has closed the channel, so nothing
+        /// more will be sent on it. (A device that crashed never gets to say
+        /// so: see getGeneration().)
+        OSVR_COMMON_EXPORT bool isWriterOpen() const;
+
+        /// @brief Identifies this instance of the channel: one created again
+        /// under the same name, say by a restarted server, has a different
+        /// generation, though a reader still attached to the old one can only
+        /// find out by opening the name again.
+        OSVR_COMMON_EXPORT uint64_t getGeneration() const;
+
+        OSVR_COMMON_EXPORT ~LocalReportChannel();
+
+      private:
+        class Impl;
+        LocalReportChannel(unique_ptr<Impl> &&impl);
+        unique_ptr<Impl> m_impl;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_LocalReportChannel_h_GUID_3B8E1F27_6C4D_4A95_B1D2_7E09A5C3F648
@@ -35,11 +35,17 @@
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
     /// @brief A tree representation, with path/url syntax, of the known OSVR
     /// system.
+    ///
+    /// Paths looked up through getNodeByPath() are cached, so repeated lookups
+    /// of the same path are a single hash lookup. Since nodes are never
+    /// removed from a tree, the cache only needs to be dropped when the tree
+    /// is reset().
     class PathTree : boost::noncopyable {
       public:
         /// @brief Constructor
@@ -87,8 +93,15 @@ namespace common {
         PathNode const &getRoot() const { return *m_root; }
 
       private:
+        /// @brief Looks up a path in the cache, returning nullptr if not
+        /// found.
+        PathNode *m_getCached(std::string const &path) const;
+
         /// @brief Root node of the tree.
         PathNodePtr m_root;
+
+        /// @brief Full path to node cache.
+        std::unordered_map<std::string, PathNode *> m_pathCache;
     };
 
     /// @brief Make node an alias pointing to source, with the given priority,
@@ -36,6 +36,8 @@
 // Standard includes
 #include <map>
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -50,11 +52,30 @@ namespace common {
         OSVR_COMMON_EXPORT void setEventCallback(PathTreeEvents e,
                                                  callback_type const &callback);
 
+        /// @brief The paths of the nodes touched by a partial update.
+        using paths_argument = std::vector<std::string> const &;
+
+        /// @brief Notify of an update that only touches the given paths: calls
+        /// the partial callback for the event if one is set, otherwise the
+        /// regular one.
+        void notifyPartialEvent(PathTreeEvents e, callback_argument arg,
+                                paths_argument paths) const;
+
+        using partial_callback_type =
+            std::function<void(callback_argument, paths_argument)>;
+        /// @brief Set a callback for updates that only touch some nodes of the
+        /// tree, in place. Observers that don't set one get the regular
+        /// callback, as if the whole tree were being replaced.
+        OSVR_COMMON_EXPORT void
+        setPartialEventCallback(PathTreeEvents e,
+                                partial_callback_type const &callback);
+
       protected:
         PathTreeObserver() = default;
 
       private:
         std::map<PathTreeEvents, callback_type> m_handlers;
+        std::map<PathTreeEvents, partial_callback_type> m_partialHandlers;
     };
 } // namespace common
 } // namespace osvr
@@ -40,10 +40,13 @@
 namespace osvr {
 namespace common {
     /// @brief Object responsible for owning a path tree (specifically a
-    /// "downstream"/client path tree), replacing its contents from
+    /// "downstream"/client path tree), replacing or updating its contents from
     /// JSON-serialized data, and notifying a collection of observers of such
     /// events.
     ///
+    /// Once the tree has been populated, both replacements and deltas are
+    /// applied in place, and observers are told which paths were touched.
+    ///
     /// @sa osvr::common::PathTreeObserver
     class PathTreeOwner : private boost::noncopyable {
       public:
@@ -67,8 +70,21 @@ namespace common {
 
         /// @brief Replace the entirety of the path tree from the given
         /// serialized array of nodes.
+        ///
+        /// If the tree was already populated, only the nodes that differ are
+        /// updated, and observers get partial-update events for those paths.
         OSVR_COMMON_EXPORT void replaceTree(Json::Value const &nodes);
 
+        /// @brief Apply a versioned delta (as sent by
+        /// SystemComponent::sendTreeUpdate()) to the tree.
+        ///
+        /// A delta with equal base and new versions and no changes marks the
+        /// version of the most recent full tree.
+        ///
+        /// @return false if the delta didn't apply to our version of the tree
+        /// (and so was ignored).
+        OSVR_COMMON_EXPORT bool applyTreeDelta(Json::Value const &delta);
+
         /// @brief Access the path tree object itself
         PathTree &get() { return m_tree; }
 
@@ -76,9 +92,16 @@ namespace common {
         PathTree const &get() const { return m_tree; }
 
       private:
+        /// @brief Applies an unversioned delta in place and notifies
+        /// observers.
+        void m_applyDelta(Json::Value const &delta);
+
         PathTree m_tree;
         std::vector<PathTreeObserverWeakPtr> m_observers;
         bool m_valid = false;
+        /// @brief Whether we know which version of the server tree we have.
+        bool m_haveVersion = false;
+        Json::UInt m_version = 0;
     };
 } // namespace common
 } // namespace osvr
@@ -34,7 +34,10 @@
 #include <json/value.h>
 
 // Standard includes
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -49,6 +52,70 @@ namespace common {
 
     /// @brief Deserialize a path tree from a JSON array of objects
     OSVR_COMMON_EXPORT void jsonToPathTree(PathTree &tree, Json::Value nodes);
+
+    /// @brief The version of the binary path tree format: a client and server
+    /// only use the binary format if they agree on this.
+    OSVR_COMMON_EXPORT std::uint8_t getPathTreeBinaryFormatVersion();
+
+    /// @brief Serialize a path tree to a compact binary form: each node as
+    /// its parent's index, its name, its element type, and its element data,
+    /// with any JSON data in binary rather than text form.
+    ///
+    /// Intended for sending over the wire - use pathTreeToJson() for anything
+    /// meant to be read or edited.
+    OSVR_COMMON_EXPORT std::string pathTreeToBinary(PathTree const &tree);
+
+    /// @brief Deserialize a path tree from the output of pathTreeToBinary(),
+    /// adding or updating its nodes in the given tree.
+    /// @throws std::runtime_error if the data is malformed or of a different
+    /// format version.
+    OSVR_COMMON_EXPORT void binaryToPathTree(PathTree &tree, const char *data,
+                                             std::size_t len);
+
+    /// @brief Deserialize the output of pathTreeToBinary() straight to the
+    /// JSON array of objects that pathTreeToJson() would have produced for the
+    /// same tree, skipping the text parse.
+    /// @throws std::runtime_error if the data is malformed or of a different
+    /// format version.
+    OSVR_COMMON_EXPORT Json::Value binaryToPathTreeJson(const char *data,
+                                                        std::size_t len);
+
+    namespace tree_delta_keys {
+        /// @brief The key in a path tree delta for the array of added or
+        /// changed node objects.
+        OSVR_COMMON_EXPORT const char *nodes();
+        /// @brief The key in a path tree delta for the array of paths of
+        /// removed nodes.
+        OSVR_COMMON_EXPORT const char *removed();
+        /// @brief The key in a versioned path tree delta for the tree version
+        /// it applies to.
+        OSVR_COMMON_EXPORT const char *baseVersion();
+        /// @brief The key in a versioned path tree delta for the tree version
+        /// it results in.
+        OSVR_COMMON_EXPORT const char *version();
+    } // namespace tree_delta_keys
+
+    /// @brief Compute the difference between two serialized path trees (as
+    /// returned by pathTreeToJson()).
+    ///
+    /// @return A JSON object with an array of the added or changed node
+    /// objects, and an array of the paths of nodes no longer present.
+    OSVR_COMMON_EXPORT Json::Value pathTreeDelta(Json::Value const &oldNodes,
+                                                 Json::Value const &newNodes);
+
+    /// @brief Whether a delta from pathTreeDelta() contains no changes.
+    OSVR_COMMON_EXPORT bool isPathTreeDeltaEmpty(Json::Value const &delta);
+
+    /// @brief Get the paths of all nodes touched by a delta from
+    /// pathTreeDelta().
+    OSVR_COMMON_EXPORT std::vector<std::string>
+    getPathTreeDeltaPaths(Json::Value const &delta);
+
+    /// @brief Apply a delta from pathTreeDelta() to a path tree in place.
+    /// Removed nodes are reset to NullElement, since nodes are never taken out
+    /// of a tree.
+    OSVR_COMMON_EXPORT void applyPathTreeDelta(PathTree &tree,
+                                               Json::Value const &delta);
 } // namespace common
 } // namespace osvr
 
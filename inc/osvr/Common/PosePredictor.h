@@ -0,0 +1,104 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PosePredictor_h_GUID_3E9B0C52_7A41_4D16_B8F3_5C20D6A9E147
+#define INCLUDED_PosePredictor_h_GUID_3E9B0C52_7A41_4D16_B8F3_5C20D6A9E147
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief Lightweight constant-velocity model of an interface's pose, used
+    /// to answer "where will it be at time t" on the client.
+    ///
+    /// Fed from the same reports that set interface state. Velocity comes from
+    /// velocity reports while the device keeps sending them; otherwise, it's
+    /// estimated from the last two poses.
+    class PosePredictor {
+      public:
+        OSVR_COMMON_EXPORT PosePredictor();
+
+        /// @name Feeding the model
+        /// @brief Overloaded on report type, so it can be called with any
+        /// report: those that don't bear on pose are ignored.
+        /// @{
+        OSVR_COMMON_EXPORT void update(OSVR_TimeValue const &timestamp,
+                                       OSVR_PoseReport const &report);
+        OSVR_COMMON_EXPORT void update(OSVR_TimeValue const &timestamp,
+                                       OSVR_VelocityReport const &report);
+        template <typename ReportType>
+        void update(OSVR_TimeValue const &, ReportType const &) {}
+        /// @}
+
+        bool hasPose() const { return m_hasPose; }
+
+        /// @brief Predicts the pose at @p target from the last pose and
+        /// velocity. With no velocity known yet, that's just the last pose.
+        ///
+        /// Extrapolation is capped at a fraction of a second past the last
+        /// pose, so a device that stops reporting doesn't send its pose
+        /// flying off, and targets before the last pose get the last pose.
+        ///
+        /// @return false if no pose has been received.
+        OSVR_COMMON_EXPORT bool predict(OSVR_TimeValue const &target,
+                                        OSVR_PoseState &pose) const;
+
+      private:
+        /// @brief A velocity taken from velocity reports, used in place of
+        /// the estimate from poses for as long as it keeps up with them.
+        struct ReportedVelocity {
+            bool valid;
+            OSVR_TimeValue timestamp;
+            OSVR_Vec3 value;
+        };
+        /// @brief The reported velocity if it's recent enough compared to the
+        /// last pose, otherwise the estimate.
+        OSVR_Vec3 const &m_choose(ReportedVelocity const &reported,
+                                  OSVR_Vec3 const &estimated) const;
+
+        bool m_hasPose;
+        OSVR_TimeValue m_poseTime;
+        OSVR_PoseState m_pose;
+
+        /// @brief Meters per second, room space.
+        ReportedVelocity m_reportedLinear;
+        OSVR_Vec3 m_estimatedLinear;
+        /// @brief Rotation per second as a quaternion log map (half the
+        /// angular velocity vector), room space.
+        ReportedVelocity m_reportedAngular;
+        OSVR_Vec3 m_estimatedAngular;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PosePredictor_h_GUID_3E9B0C52_7A41_4D16_B8F3_5C20D6A9E147
@@ -69,6 +69,27 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class TreeDeltaFromServer
+            : public MessageRegistration<TreeDeltaFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class BinaryTreeFormatRequestToServer
+            : public MessageRegistration<BinaryTreeFormatRequestToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class BinaryTreeFromServer
+            : public MessageRegistration<BinaryTreeFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -110,15 +131,75 @@ namespace common {
                                    util::time::TimeValue const &)> JsonHandler;
         OSVR_COMMON_EXPORT void registerReplaceTreeHandler(JsonHandler cb);
 
+        /// @brief Send the whole tree, followed by a version marker for
+        /// clients that understand tree deltas.
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @brief Message from server, updating only the changed nodes of the
+        /// client's configuration.
+        messages::TreeDeltaFromServer treeDeltaOut;
+
+        /// @brief Send only the nodes that changed since the last tree sent,
+        /// as a versioned delta. Sends the whole tree if none has been sent
+        /// yet, and nothing if there are no changes.
+        OSVR_COMMON_EXPORT void sendTreeUpdate(PathTree &tree);
+
+        OSVR_COMMON_EXPORT void registerTreeDeltaHandler(JsonHandler cb);
+
+        /// @brief Message from client, asking for replacement trees to also
+        /// be sent in binary form, in the format version given.
+        messages::BinaryTreeFormatRequestToServer binaryTreeRequestIn;
+
+        /// @brief Message from server, with the whole tree in binary form.
+        /// Sent immediately before the JSON tree, once a client has asked for
+        /// it.
+        messages::BinaryTreeFromServer binaryTreeOut;
+
+        /// @brief Client side: ask the server to send binary trees. Once one
+        /// arrives, it is passed to the replace tree handlers (as JSON) and
+        /// the JSON copy that follows it is skipped without being parsed.
+        ///
+        /// Should be called on each (re-)connection. Servers that don't
+        /// understand the request just keep sending JSON.
+        OSVR_COMMON_EXPORT void requestBinaryTree();
+
+        typedef std::function<void()> BinaryTreeRequestHandler;
+        /// @brief Server side: register a callback for when a client has
+        /// requested binary trees in a format we can produce - the tree
+        /// should be sent again.
+        OSVR_COMMON_EXPORT void
+        registerBinaryTreeRequestHandler(BinaryTreeRequestHandler cb);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDelta(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleBinaryTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleBinaryTreeRequest(void *userdata, vrpn_HANDLERPARAM p);
+
+        void m_sendTreeDelta(Json::Value &delta, Json::UInt base);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<JsonHandler> m_treeDeltaHandlers;
+        std::vector<BinaryTreeRequestHandler> m_binaryTreeRequestHandlers;
+
+        /// @brief Client side: whether we've asked for binary trees.
+        bool m_requestedBinaryTree = false;
+        /// @brief Client side: whether the next JSON tree is a copy of a
+        /// binary tree we've already handled.
+        bool m_skipNextJsonTree = false;
+        /// @brief Server side: whether any client has asked for binary trees.
+        bool m_sendBinaryTree = false;
+
+        /// @brief Server side: the tree as last sent, and its version.
+        Json::Value m_sentTree;
+        bool m_haveSentTree = false;
+        Json::UInt m_treeVersion = 0;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,224 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerComponent_h_GUID_6F4A2C19_D83E_4B70_9A15_C2E7B06D81F3
+#define INCLUDED_TrackerComponent_h_GUID_6F4A2C19_D83E_4B70_9A15_C2E7B06D81F3
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/DeviceComponent.h>
+#include <osvr/Common/SerializationTags.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <vrpn_BaseClass.h>
+
+// Standard includes
+#include <functional>
+#include <vector>
+
+namespace osvr {
+namespace common {
+
+    /// @brief The precision in which a device's native tracker messages carry
+    /// their values.
+    enum class TrackerPrecision : uint8_t { Double = 0, Float = 1 };
+
+    namespace messages {
+        class TrackerPoseRecord
+            : public MessageRegistration<TrackerPoseRecord> {
+          public:
+            class MessageSerialization;
+
+            static const char *identifier();
+        };
+
+        class TrackerVelocityRecord
+            : public MessageRegistration<TrackerVelocityRecord> {
+          public:
+            class MessageSerialization;
+
+            static const char *identifier();
+        };
+
+        class TrackerAccelerationRecord
+            : public MessageRegistration<TrackerAccelerationRecord> {
+          public:
+            class MessageSerialization;
+
+            static const char *identifier();
+        };
+
+        class TrackerPoseBatchRecord
+            : public MessageRegistration<TrackerPoseBatchRecord> {
+          public:
+            class MessageSerialization;
+
+            static const char *identifier();
+        };
+    } // namespace messages
+
+    /// @brief BaseDevice component carrying tracker reports in OSVR's own
+    /// message format, which clients decode straight into report structures.
+    ///
+    /// Tracker devices send these alongside the VRPN tracker messages, which
+    /// are kept for older clients and anything else speaking VRPN.
+    class TrackerComponent : public DeviceComponent {
+      public:
+        /// @brief Factory method
+        ///
+        /// Required to ensure that allocation and deallocation stay on the same
+        /// side of a DLL line.
+        static OSVR_COMMON_EXPORT shared_ptr<TrackerComponent>
+        create(TrackerPrecision precision = TrackerPrecision::Double);
+
+        /// @brief Message from server to client, containing a pose.
+        messages::TrackerPoseRecord poseRecord;
+
+        /// @brief Message from server to client, containing linear and/or
+        /// angular velocity.
+        messages::TrackerVelocityRecord velocityRecord;
+
+        /// @brief Message from server to client, containing linear and/or
+        /// angular acceleration.
+        messages::TrackerAccelerationRecord accelerationRecord;
+
+        /// @brief Message from server to client, containing poses for any
+        /// number of sensors, all as of the same time.
+        messages::TrackerPoseBatchRecord poseBatchRecord;
+
+        /// @brief Sets the precision used by messages sent from now on:
+        /// single precision halves their size, at the cost of resolution.
+        OSVR_COMMON_EXPORT void setPrecision(TrackerPrecision precision);
+        TrackerPrecision getPrecision() const { return m_precision; }
+
+        /// @name Sending reports
+        /// @brief Mirror connection::TrackerServerInterface. Position-only and
+        /// orientation-only reports are merged with the rest of the last pose
+        /// sent for that sensor, while velocity and acceleration messages only
+        /// carry (and mark valid) the parts supplied.
+        /// @{
+        OSVR_COMMON_EXPORT void sendReport(OSVR_PositionState const &val,
+                                           OSVR_ChannelCount sensor,
+                                           OSVR_TimeValue const &timestamp);
+        OSVR_COMMON_EXPORT void sendReport(OSVR_OrientationState const &val,
+                                           OSVR_ChannelCount sensor,
+                                           OSVR_TimeValue const &timestamp);
+        OSVR_COMMON_EXPORT void sendReport(OSVR_PoseState const &val,
+                                           OSVR_ChannelCount sensor,
+                                           OSVR_TimeValue const &timestamp);
+
+        OSVR_COMMON_EXPORT void sendVelReport(OSVR_VelocityState const &val,
+                                              OSVR_ChannelCount sensor,
+                                              OSVR_TimeValue const &timestamp);
+        OSVR_COMMON_EXPORT void
+        sendVelReport(OSVR_LinearVelocityState const &val,
+                      OSVR_ChannelCount sensor,
+                      OSVR_TimeValue const &timestamp);
+        OSVR_COMMON_EXPORT void
+        sendVelReport(OSVR_AngularVelocityState const &val,
+                      OSVR_ChannelCount sensor,
+                      OSVR_TimeValue const &timestamp);
+
+        OSVR_COMMON_EXPORT void
+        sendAccelReport(OSVR_AccelerationState const &val,
+                        OSVR_ChannelCount sensor,
+                        OSVR_TimeValue const &timestamp);
+        OSVR_COMMON_EXPORT void
+        sendAccelReport(OSVR_LinearAccelerationState const &val,
+                        OSVR_ChannelCount sensor,
+                        OSVR_TimeValue const &timestamp);
+        OSVR_COMMON_EXPORT void
+        sendAccelReport(OSVR_AngularAccelerationState const &val,
+                        OSVR_ChannelCount sensor,
+                        OSVR_TimeValue const &timestamp);
+
+        /// @brief Sends poses for many sensors in one message, with a single
+        /// timestamp, for clients to apply all at once.
+        OSVR_COMMON_EXPORT void
+        sendPoseBatch(std::vector<OSVR_PoseReport> const &reports,
+                      OSVR_TimeValue const &timestamp);
+        /// @}
+
+        typedef std::function<void(OSVR_PoseReport const &,
+                                   util::time::TimeValue const &)>
+            PoseHandler;
+        typedef std::function<void(OSVR_VelocityReport const &,
+                                   util::time::TimeValue const &)>
+            VelocityHandler;
+        typedef std::function<void(OSVR_AccelerationReport const &,
+                                   util::time::TimeValue const &)>
+            AccelerationHandler;
+        typedef std::function<void(std::vector<OSVR_PoseReport> const &,
+                                   util::time::TimeValue const &)>
+            PoseBatchHandler;
+        OSVR_COMMON_EXPORT void registerPoseHandler(PoseHandler cb);
+        OSVR_COMMON_EXPORT void registerVelocityHandler(VelocityHandler cb);
+        OSVR_COMMON_EXPORT void
+        registerAccelerationHandler(AccelerationHandler cb);
+        OSVR_COMMON_EXPORT void registerPoseBatchHandler(PoseBatchHandler cb);
+
+      private:
+        TrackerComponent(TrackerPrecision precision);
+        virtual void m_parentSet();
+
+        static int VRPN_CALLBACK m_handlePoseRecord(void *userdata,
+                                                    vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK m_handleVelocityRecord(void *userdata,
+                                                        vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleAccelerationRecord(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK m_handlePoseBatchRecord(void *userdata,
+                                                         vrpn_HANDLERPARAM p);
+
+        /// @brief The last pose sent for a sensor, starting out as identity.
+        OSVR_PoseState &m_getPose(OSVR_ChannelCount sensor);
+
+        void m_sendPose(OSVR_ChannelCount sensor, OSVR_PoseState const &pose,
+                        OSVR_TimeValue const &timestamp);
+        void m_sendVelocity(OSVR_ChannelCount sensor,
+                            OSVR_VelocityState const &state,
+                            OSVR_TimeValue const &timestamp);
+        void m_sendAcceleration(OSVR_ChannelCount sensor,
+                                OSVR_AccelerationState const &state,
+                                OSVR_TimeValue const &timestamp);
+
+        TrackerPrecision m_precision;
+        /// @brief Reused for every message sent, so it's only allocated once.
+        Buffer<> m_buf;
+        std::vector<OSVR_PoseState> m_poses;
+        std::vector<PoseHandler> m_poseCb;
+        std::vector<VelocityHandler> m_velocityCb;
+        std::vector<AccelerationHandler> m_accelerationCb;
+        std::vector<PoseBatchHandler> m_poseBatchCb;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerComponent_h_GUID_6F4A2C19_D83E_4B70_9A15_C2E7B06D81F3
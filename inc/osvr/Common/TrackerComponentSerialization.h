@@ -0,0 +1,265 @@
+/** @file
+    @brief Header defining the serialization of the native tracker messages
+   sent by TrackerComponent.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerComponentSerialization_h_GUID_0B7D95E2_41C8_4F3A_8E66_A9D2F1C3574B
+#define INCLUDED_TrackerComponentSerialization_h_GUID_0B7D95E2_41C8_4F3A_8E66_A9D2F1C3574B
+
+// Internal Includes
+#include <osvr/Common/TrackerComponent.h>
+#include <osvr/Common/SerializationTraits.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace messages {
+        namespace detail {
+            typedef serialization::EnumAsIntegerTag<TrackerPrecision, uint8_t>
+                TrackerPrecisionTag;
+
+            /// @brief Processes an array of values in the given precision.
+            /// Values go through a float when needed, so this works for
+            /// serialization and deserialization alike.
+            template <typename T>
+            inline void processTrackerValues(T &p, TrackerPrecision precision,
+                                             double *values, std::size_t n) {
+                if (precision == TrackerPrecision::Float) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        float val = static_cast<float>(values[i]);
+                        p(val);
+                        values[i] = val;
+                    }
+                } else {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        p(values[i]);
+                    }
+                }
+            }
+
+            template <typename T>
+            inline void processTrackerValues(T &p, TrackerPrecision precision,
+                                             OSVR_Vec3 &val) {
+                processTrackerValues(p, precision, val.data, 3);
+            }
+
+            template <typename T>
+            inline void processTrackerValues(T &p, TrackerPrecision precision,
+                                             OSVR_Quaternion &val) {
+                processTrackerValues(p, precision, val.data, 4);
+            }
+
+            template <typename T>
+            inline void processTrackerValues(T &p, TrackerPrecision precision,
+                                             OSVR_IncrementalQuaternion &val) {
+                processTrackerValues(p, precision, val.incrementalRotation);
+                processTrackerValues(p, precision, &val.dt, 1);
+            }
+
+            inline OSVR_CBool normalizeValid(OSVR_CBool valid) {
+                return valid ? OSVR_TRUE : OSVR_FALSE;
+            }
+        } // namespace detail
+
+        /// Sensor, precision, then position and orientation.
+        class TrackerPoseRecord::MessageSerialization {
+          public:
+            MessageSerialization(OSVR_PoseReport const &report,
+                                 TrackerPrecision precision)
+                : m_report(report), m_precision(precision) {}
+
+            MessageSerialization()
+                : m_report(), m_precision(TrackerPrecision::Double) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_report.sensor);
+                p(m_precision, detail::TrackerPrecisionTag());
+                detail::processTrackerValues(p, m_precision,
+                                             m_report.pose.translation);
+                detail::processTrackerValues(p, m_precision,
+                                             m_report.pose.rotation);
+            }
+
+            OSVR_PoseReport const &getReport() const { return m_report; }
+
+          private:
+            OSVR_PoseReport m_report;
+            TrackerPrecision m_precision;
+        };
+
+        /// Sensor, precision, validity flags, then just the valid parts.
+        class TrackerVelocityRecord::MessageSerialization {
+          public:
+            MessageSerialization(OSVR_VelocityReport const &report,
+                                 TrackerPrecision precision)
+                : m_report(report), m_precision(precision) {
+                auto &state = m_report.state;
+                state.linearVelocityValid =
+                    detail::normalizeValid(state.linearVelocityValid);
+                state.angularVelocityValid =
+                    detail::normalizeValid(state.angularVelocityValid);
+            }
+
+            MessageSerialization()
+                : m_report(), m_precision(TrackerPrecision::Double) {}
+
+            template <typename T> void processMessage(T &p) {
+                auto &state = m_report.state;
+                p(m_report.sensor);
+                p(m_precision, detail::TrackerPrecisionTag());
+                p(state.linearVelocityValid);
+                p(state.angularVelocityValid);
+                if (state.linearVelocityValid) {
+                    detail::processTrackerValues(p, m_precision,
+                                                 state.linearVelocity);
+                }
+                if (state.angularVelocityValid) {
+                    detail::processTrackerValues(p, m_precision,
+                                                 state.angularVelocity);
+                }
+            }
+
+            OSVR_VelocityReport const &getReport() const { return m_report; }
+
+          private:
+            OSVR_VelocityReport m_report;
+            TrackerPrecision m_precision;
+        };
+
+        /// Sensor, precision, validity flags, then just the valid parts.
+        class TrackerAccelerationRecord::MessageSerialization {
+          public:
+            MessageSerialization(OSVR_AccelerationReport const &report,
+                                 TrackerPrecision precision)
+                : m_report(report), m_precision(precision) {
+                auto &state = m_report.state;
+                state.linearAccelerationValid =
+                    detail::normalizeValid(state.linearAccelerationValid);
+                state.angularAccelerationValid =
+                    detail::normalizeValid(state.angularAccelerationValid);
+            }
+
+            MessageSerialization()
+                : m_report(), m_precision(TrackerPrecision::Double) {}
+
+            template <typename T> void processMessage(T &p) {
+                auto &state = m_report.state;
+                p(m_report.sensor);
+                p(m_precision, detail::TrackerPrecisionTag());
+                p(state.linearAccelerationValid);
+                p(state.angularAccelerationValid);
+                if (state.linearAccelerationValid) {
+                    detail::processTrackerValues(p, m_precision,
+                                                 state.linearAcceleration);
+                }
+                if (state.angularAccelerationValid) {
+                    detail::processTrackerValues(p, m_precision,
+                                                 state.angularAcceleration);
+                }
+            }
+
+            OSVR_AccelerationReport const &getReport() const {
+                return m_report;
+            }
+
+          private:
+            OSVR_AccelerationReport m_report;
+            TrackerPrecision m_precision;
+        };
+
+        /// Precision, count, then sensor and pose for each entry.
+        class TrackerPoseBatchRecord::MessageSerialization {
+          public:
+            MessageSerialization(std::vector<OSVR_PoseReport> const &reports,
+                                 TrackerPrecision precision)
+                : m_reports(reports), m_precision(precision),
+                  m_payloadLength(0), m_valid(true) {}
+
+            /// @brief Constructor for deserializing a message of the given
+            /// length: the count read from it is checked against the length
+            /// before making room for that many entries.
+            explicit MessageSerialization(std::size_t payloadLength)
+                : m_precision(TrackerPrecision::Double),
+                  m_payloadLength(payloadLength), m_valid(true) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_precision, detail::TrackerPrecisionTag());
+                auto count = static_cast<uint32_t>(m_reports.size());
+                p(count);
+                if (p.isDeserialize() && !m_fits(count)) {
+                    m_valid = false;
+                    m_reports.clear();
+                    return;
+                }
+                /// No-op when serializing; makes room when deserializing.
+                m_reports.resize(count);
+                for (auto &report : m_reports) {
+                    p(report.sensor);
+                    detail::processTrackerValues(p, m_precision,
+                                                 report.pose.translation);
+                    detail::processTrackerValues(p, m_precision,
+                                                 report.pose.rotation);
+                }
+            }
+
+            std::vector<OSVR_PoseReport> const &getReports() const {
+                return m_reports;
+            }
+
+            /// @brief False if the count read didn't fit in the message, in
+            /// which case no entries were read.
+            bool isValid() const { return m_valid; }
+
+          private:
+            /// @brief Whether the rest of the message is long enough for
+            /// count entries.
+            bool m_fits(uint32_t count) const {
+                /// Precision padded out to the alignment of the count.
+                static const std::size_t HEADER_BYTES = 2 * sizeof(uint32_t);
+                /// Sensor (padded out to the alignment of doubles, if need
+                /// be), three translation and four rotation values.
+                auto entryBytes =
+                    (m_precision == TrackerPrecision::Float)
+                        ? sizeof(uint32_t) + 7 * sizeof(float)
+                        : sizeof(double) + 7 * sizeof(double);
+                if (m_payloadLength < HEADER_BYTES) {
+                    return count == 0;
+                }
+                return count <= (m_payloadLength - HEADER_BYTES) / entryBytes;
+            }
+            std::vector<OSVR_PoseReport> m_reports;
+            TrackerPrecision m_precision;
+            std::size_t m_payloadLength;
+            bool m_valid;
+        };
+    } // namespace messages
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerComponentSerialization_h_GUID_0B7D95E2_41C8_4F3A_8E66_A9D2F1C3574B
@@ -39,6 +39,8 @@
 #include <boost/noncopyable.hpp>
 #include <boost/optional.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 // Standard includes
 #include <string>
@@ -112,6 +114,21 @@ namespace connection {
         /// Someone needs to call this method frequently.
         OSVR_CONNECTION_EXPORT void process();
 
+        /// @brief Notify whoever is running this connection's main loop that
+        /// there is work waiting for it (for instance, data queued by an
+        /// async device thread).
+        ///
+        /// Safe to call from any thread.
+        OSVR_CONNECTION_EXPORT void signalWork();
+
+        /// @brief Block until signalWork() is called or the timeout elapses,
+        /// whichever comes first. A signal that arrived since the last call
+        /// returns immediately.
+        ///
+        /// @param microseconds Maximum time to wait.
+        /// @returns true if work was signalled, false on timeout.
+        OSVR_CONNECTION_EXPORT bool waitForWork(int microseconds);
+
         /// @brief Register a function to be called when a client connects or
         /// pings.
         OSVR_CONNECTION_EXPORT void
@@ -178,6 +195,13 @@ namespace connection {
         OSVR_CONNECTION_EXPORT virtual const char *getConnectionKindID();
         /// @}
 
+        /// @brief The namespace in which devices on this connection also
+        /// publish their tracker reports through shared memory, for clients on
+        /// the same host (see common::LocalReportChannel), or an empty string
+        /// if they don't.
+        OSVR_CONNECTION_EXPORT std::string const &
+        getLocalReportNamespace() const;
+
       protected:
         /// @brief (Subclass implementation) Register (or retrieve registration)
         /// of a message type.
@@ -197,6 +221,10 @@ namespace connection {
         /// block.
         virtual void m_process() = 0;
 
+        /// @brief (For subclasses) Have devices publish their reports locally
+        /// in the given namespace.
+        void m_setLocalReportNamespace(std::string const &ns);
+
         /// brief Constructor
         Connection();
 
@@ -204,6 +232,14 @@ namespace connection {
         DeviceList m_devices;
         std::vector<std::function<void()> > m_descriptorHandlers;
         util::log::LoggerPtr m_log;
+        std::string m_localReportNamespace;
+
+        /// @name Work signalling
+        /// @{
+        boost::mutex m_workMutex;
+        boost::condition_variable m_workCondition;
+        bool m_workPending = false;
+        /// @}
     };
 } // namespace connection
 } // namespace osvr
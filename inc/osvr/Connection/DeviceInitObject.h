@@ -86,6 +86,12 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     OSVR_CONNECTION_EXPORT void
     setTracker(osvr::connection::TrackerServerInterface **iface);
 
+    /// @brief Request that an async device token created with these options
+    /// queue raw data sends (up to the given number of messages) rather than
+    /// blocking for the main thread: clears the boost::optional if 0 is
+    /// passed. Has no effect on sync devices.
+    OSVR_CONNECTION_EXPORT void setAsyncSendQueueCapacity(size_t capacity);
+
     /// @brief Add a server interface pointer to our list, which will get
     /// registered when the device is created.
     OSVR_CONNECTION_EXPORT void
@@ -148,6 +154,9 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     boost::optional<OSVR_ChannelCount> getAnalogs() const { return m_analogs; }
     boost::optional<OSVR_ChannelCount> getButtons() const { return m_buttons; }
     bool getTracker() const { return m_tracker; }
+    boost::optional<size_t> getAsyncSendQueueCapacity() const {
+        return m_asyncSendQueueCapacity;
+    }
     osvr::connection::ServerInterfaceList const &getServerInterfaces() const {
         return m_serverInterfaces;
     }
@@ -167,6 +176,7 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     osvr::connection::ButtonServerInterface **m_buttonIface;
     bool m_tracker;
     osvr::connection::TrackerServerInterface **m_trackerIface;
+    boost::optional<size_t> m_asyncSendQueueCapacity;
     osvr::connection::ServerInterfaceList m_serverInterfaces;
     osvr::common::DeviceComponentList m_components;
     std::vector<OSVR_DeviceTokenObject **> m_tokenInterest;
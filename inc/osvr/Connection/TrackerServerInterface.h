@@ -79,6 +79,13 @@ namespace connection {
         sendAccelReport(OSVR_AngularAccelerationState const &val,
                         OSVR_ChannelCount sensor,
                         util::time::TimeValue const &timestamp) = 0;
+
+        /// @brief Publishes a pose only to clients on this host that read
+        /// local reports, sending no VRPN message: for poses that go to other
+        /// clients some other way, such as in a native batch message.
+        virtual void publishLocalReport(OSVR_PoseState const &,
+                                        OSVR_ChannelCount,
+                                        util::time::TimeValue const &) {}
     };
 
 } // namespace connection
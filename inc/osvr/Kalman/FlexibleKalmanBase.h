@@ -126,14 +126,49 @@ namespace kalman {
 
     } // namespace types
 
-    /// Computes P-
-    ///
-    /// Usage is optional, most likely called from the process model
-    /// `updateState()`` method.
+    /// @name State transition structure tags
+    /// @brief A process model may name one of these as its nested
+    /// `StateTransitionStructure` type, so that predictErrorCovariance() can
+    /// pick a kernel for it at compile time.
+    /// @{
+    /// Nothing known about A: it's formed and multiplied out in full. This is
+    /// assumed for process models that don't say otherwise.
+    struct DenseStateTransition {};
+    /// A state made of n values followed by their n derivatives, under a
+    /// (possibly damped) constant-derivative model: A = [I, dt I; 0, D] with
+    /// D diagonal. The process model must provide
+    /// `getVelocityAttenuation(dt)`, returning the diagonal of D.
+    struct ConstantVelocityStateTransition {};
+    /// @}
+
+    namespace types {
+        namespace detail {
+            template <typename...> struct make_void { using type = void; };
+            template <typename T, typename = void>
+            struct StateTransitionStructure_impl {
+                using type = DenseStateTransition;
+            };
+            template <typename T>
+            struct StateTransitionStructure_impl<
+                T, typename make_void<
+                       typename T::StateTransitionStructure>::type> {
+                using type = typename T::StateTransitionStructure;
+            };
+        } // namespace detail
+        /// Given a process model, get the tag describing the structure of its
+        /// state transition matrix.
+        template <typename ProcessModelType>
+        using StateTransitionStructure =
+            typename detail::StateTransitionStructure_impl<
+                ProcessModelType>::type;
+    } // namespace types
+
+    /// Computes P- the general way, as A P A^T + Q.
     template <typename StateType, typename ProcessModelType>
     inline types::DimSquareMatrix<StateType>
     predictErrorCovariance(StateType const &state,
-                           ProcessModelType &processModel, double dt) {
+                           ProcessModelType &processModel, double dt,
+                           DenseStateTransition) {
         types::DimSquareMatrix<StateType> A =
             processModel.getStateTransitionMatrix(state, dt);
         // OSVR_KALMAN_DEBUG_OUTPUT("State transition matrix", A);
@@ -149,6 +184,63 @@ namespace kalman {
                processModel.getSampledProcessNoiseCovariance(dt);
     }
 
+    /// Computes P- for a constant-velocity style process model, block by
+    /// block: with A = [I, dt I; 0, D],
+    ///
+    /// A P A^T = [P11 + dt (P12 + P21) + dt^2 P22, (P12 + dt P22) D;
+    ///            D (P21 + dt P22), D P22 D]
+    ///
+    /// which takes a few scaled additions of the half-size blocks in place
+    /// of two full-size matrix products.
+    template <typename StateType, typename ProcessModelType>
+    inline types::DimSquareMatrix<StateType>
+    predictErrorCovariance(StateType const &state,
+                           ProcessModelType &processModel, double dt,
+                           ConstantVelocityStateTransition) {
+        static const types::DimensionType n =
+            types::Dimension<StateType>::value;
+        static_assert(n % 2 == 0, "A constant-velocity state must be made of "
+                                  "values and their derivatives, so must have "
+                                  "an even dimension.");
+        static const types::DimensionType half = n / 2;
+        using Block = types::SquareMatrix<half>;
+        types::Vector<half> d = processModel.getVelocityAttenuation(dt);
+        types::DimSquareMatrix<StateType> const &P = state.errorCovariance();
+        Block P22 = P.template bottomRightCorner<half, half>();
+        Block P12 = P.template topRightCorner<half, half>();
+        Block P21 = P.template bottomLeftCorner<half, half>();
+
+        types::DimSquareMatrix<StateType> ret;
+        ret.template topLeftCorner<half, half>() =
+            P.template topLeftCorner<half, half>() + dt * (P12 + P21) +
+            (dt * dt) * P22;
+        ret.template topRightCorner<half, half>() =
+            (P12 + dt * P22) * d.asDiagonal();
+        ret.template bottomLeftCorner<half, half>() =
+            d.asDiagonal() * (P21 + dt * P22);
+        ret.template bottomRightCorner<half, half>() =
+            d.asDiagonal() * P22 * d.asDiagonal();
+        OSVR_KALMAN_DEBUG_OUTPUT(
+            "Process Noise Covariance Q",
+            processModel.getSampledProcessNoiseCovariance(dt));
+        ret += processModel.getSampledProcessNoiseCovariance(dt);
+        return ret;
+    }
+
+    /// Computes P-
+    ///
+    /// Usage is optional, most likely called from the process model
+    /// `updateState()`` method. The kernel used is chosen by the process
+    /// model's StateTransitionStructure.
+    template <typename StateType, typename ProcessModelType>
+    inline types::DimSquareMatrix<StateType>
+    predictErrorCovariance(StateType const &state,
+                           ProcessModelType &processModel, double dt) {
+        return predictErrorCovariance(
+            state, processModel, dt,
+            types::StateTransitionStructure<ProcessModelType>{});
+    }
+
 } // namespace kalman
 } // namespace osvr
 
@@ -0,0 +1,179 @@
+/** @file
+    @brief Header for applying a set of measurements to a state in a single
+   Kalman correction.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FlexibleKalmanBatchCorrection_h_GUID_9C2E5F43_7A18_4D6B_B0E9_35F1C8A7D264
+#define INCLUDED_FlexibleKalmanBatchCorrection_h_GUID_9C2E5F43_7A18_4D6B_B0E9_35F1C8A7D264
+
+// Internal Includes
+#include "FlexibleKalmanBase.h"
+
+// Library/third-party includes
+#include <Eigen/Cholesky>
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace kalman {
+    /// How a batch correction updates the error covariance.
+    enum class CovarianceUpdate {
+        /// The posterior covariance straight from the solve:
+        /// (P^-1 + H^T R^-1 H)^-1
+        Standard,
+        /// The Joseph form, (I - KH) P (I - KH)^T + K R K^T, which stays
+        /// symmetric and positive semi-definite despite round-off in K.
+        Joseph
+    };
+
+    /// Collects measurements of a state, each with noise independent of the
+    /// others, and applies them all in a single correction. All are
+    /// linearized about the state as it was before the correction.
+    ///
+    /// Equivalent to stacking the measurement Jacobians and residuals into one
+    /// big measurement with a block-diagonal covariance, but rather than
+    /// solving a system the size of all the measurements put together, each
+    /// measurement's contribution (H^T R^-1 H and H^T R^-1 dz) is summed as it
+    /// is added. The one solve at the end is then the size of the state, no
+    /// matter how many measurements there are, and nothing is allocated.
+    template <typename StateType> class BatchCorrection {
+      public:
+        static const types::DimensionType STATE_DIMENSION =
+            types::Dimension<StateType>::value;
+        using StateVector = types::DimVector<StateType>;
+        using StateSquareMatrix = types::DimSquareMatrix<StateType>;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        BatchCorrection() { clear(); }
+
+        /// Forget all measurements added so far.
+        void clear() {
+            m_information = StateSquareMatrix::Zero();
+            m_informationVector = StateVector::Zero();
+            m_count = 0;
+        }
+
+        /// Number of measurements added since construction or clear().
+        std::size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+
+        /// Adds a measurement given its Jacobian (m x n), residual (m) and
+        /// covariance (m x m), where n is the state dimension and m that of
+        /// this measurement.
+        ///
+        /// @return false, and the measurement is ignored, if the covariance
+        /// isn't positive definite.
+        template <typename JacobianType, typename ResidualType,
+                  typename CovarianceType>
+        bool add(Eigen::MatrixBase<JacobianType> const &H,
+                 Eigen::MatrixBase<ResidualType> const &residual,
+                 Eigen::MatrixBase<CovarianceType> const &R) {
+            static const auto m = JacobianType::RowsAtCompileTime;
+            EIGEN_STATIC_ASSERT(JacobianType::ColsAtCompileTime ==
+                                    STATE_DIMENSION,
+                                YOU_MIXED_MATRICES_OF_DIFFERENT_SIZES);
+            EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(ResidualType, m);
+            Eigen::LLT<types::SquareMatrix<m>> covariance(R);
+            if (covariance.info() != Eigen::Success) {
+                return false;
+            }
+            // With R = L L^T, H^T R^-1 H = (L^-1 H)^T (L^-1 H): a rank-m
+            // update of just the upper triangle.
+            types::Matrix<m, STATE_DIMENSION> whitenedH =
+                covariance.matrixL().solve(H);
+            types::Vector<m> whitenedResidual =
+                covariance.matrixL().solve(residual);
+            m_information.template selfadjointView<Eigen::Upper>().rankUpdate(
+                whitenedH.transpose());
+            m_informationVector += whitenedH.transpose() * whitenedResidual;
+            ++m_count;
+            return true;
+        }
+
+        /// Adds a measurement of the kind kalman::correct() takes, linearized
+        /// about the given state.
+        template <typename MeasurementType>
+        bool add(StateType &state, MeasurementType &meas) {
+            return add(meas.getJacobian(state), meas.getResidual(state),
+                       meas.getCovariance(state));
+        }
+
+        /// Corrects the state with all the measurements added. Does not clear
+        /// them.
+        ///
+        /// @return false, leaving the state untouched, if the prior error
+        /// covariance or the posterior information matrix isn't positive
+        /// definite.
+        bool correct(StateType &state, CovarianceUpdate update =
+                                           CovarianceUpdate::Standard) const {
+            if (empty()) {
+                return true;
+            }
+            StateSquareMatrix P = state.errorCovariance();
+            Eigen::LLT<StateSquareMatrix> prior(P);
+            if (prior.info() != Eigen::Success) {
+                return false;
+            }
+            StateSquareMatrix identity = StateSquareMatrix::Identity();
+            StateSquareMatrix information =
+                m_information.template selfadjointView<Eigen::Upper>();
+            Eigen::LLT<StateSquareMatrix> posterior(prior.solve(identity) +
+                                                    information);
+            if (posterior.info() != Eigen::Success) {
+                return false;
+            }
+            StateSquareMatrix newP = posterior.solve(identity);
+            OSVR_KALMAN_DEBUG_OUTPUT("batch state correction",
+                                     (newP * m_informationVector).transpose());
+
+            // With the gain K = P+ H^T R^-1, the correction is K dz, and KH
+            // and K R K^T both come out of the information matrix.
+            StateVector stateCorrection = newP * m_informationVector;
+            if (update == CovarianceUpdate::Joseph) {
+                StateSquareMatrix IKH = identity - newP * information;
+                newP = IKH * P * IKH.transpose() +
+                       newP * information * newP.transpose();
+            }
+
+            state.setStateVector(state.stateVector() + stateCorrection);
+            state.setErrorCovariance(0.5 * newP + 0.5 * newP.transpose());
+
+            // Let the state do any cleanup it has to (like fixing externalized
+            // quaternions)
+            state.postCorrect();
+            return true;
+        }
+
+      private:
+        /// Sum of H^T R^-1 H: only the upper triangle is kept up to date.
+        StateSquareMatrix m_information;
+        /// Sum of H^T R^-1 dz
+        StateVector m_informationVector;
+        std::size_t m_count;
+    };
+
+} // namespace kalman
+} // namespace osvr
+
+#endif // INCLUDED_FlexibleKalmanBatchCorrection_h_GUID_9C2E5F43_7A18_4D6B_B0E9_35F1C8A7D264
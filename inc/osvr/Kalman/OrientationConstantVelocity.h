@@ -44,6 +44,7 @@ namespace kalman {
         using StateVector = orient_externalized_rotation::StateVector;
         using StateSquareMatrix =
             orient_externalized_rotation::StateSquareMatrix;
+        using StateTransitionStructure = ConstantVelocityStateTransition;
         using NoiseAutocorrelation = types::Vector<3>;
         OrientationConstantVelocityProcessModel(double orientationNoise = 0.1) {
             setNoiseAutocorrelation(orientationNoise);
@@ -61,6 +62,11 @@ namespace kalman {
             return orient_externalized_rotation::stateTransitionMatrix(dt);
         }
 
+        /// The diagonal of the velocity block of A: no damping here.
+        types::Vector<3> getVelocityAttenuation(double) const {
+            return types::Vector<3>::Ones();
+        }
+
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
             auto Pminus = predictErrorCovariance(s, *this, dt);
@@ -82,7 +88,7 @@ namespace kalman {
             for (std::size_t xIndex = 0; xIndex < dim / 2; ++xIndex) {
                 auto xDotIndex = xIndex + dim / 2;
                 // xIndex is 'i' and xDotIndex is 'j' in eq. 4.8
-                const auto mu = getMu(xDotIndex);
+                const auto mu = getMu(xIndex);
                 cov(xIndex, xIndex) = mu * dt3;
                 auto symmetric = mu * dt2;
                 cov(xIndex, xDotIndex) = symmetric;
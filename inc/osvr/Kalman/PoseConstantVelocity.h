@@ -43,6 +43,7 @@ namespace kalman {
         using State = pose_externalized_rotation::State;
         using StateVector = pose_externalized_rotation::StateVector;
         using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
+        using StateTransitionStructure = ConstantVelocityStateTransition;
         using NoiseAutocorrelation = types::Vector<6>;
         PoseConstantVelocityProcessModel(double positionNoise = 0.01,
                                          double orientationNoise = 0.1) {
@@ -63,6 +64,11 @@ namespace kalman {
             return pose_externalized_rotation::stateTransitionMatrix(dt);
         }
 
+        /// The diagonal of the velocity block of A: no damping here.
+        types::Vector<6> getVelocityAttenuation(double) const {
+            return types::Vector<6>::Ones();
+        }
+
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
             auto Pminus = predictErrorCovariance(s, *this, dt);
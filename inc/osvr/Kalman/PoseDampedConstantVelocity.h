@@ -45,6 +45,7 @@ namespace kalman {
         using State = pose_externalized_rotation::State;
         using StateVector = pose_externalized_rotation::StateVector;
         using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
+        using StateTransitionStructure = ConstantVelocityStateTransition;
         using BaseProcess = PoseConstantVelocityProcessModel;
         using NoiseAutocorrelation = BaseProcess::NoiseAutocorrelation;
         PoseDampedConstantVelocityProcessModel(double damping = 0.1,
@@ -77,6 +78,12 @@ namespace kalman {
                 stateTransitionMatrixWithVelocityDamping(dt, m_damp);
         }
 
+        /// The diagonal of the velocity block of A.
+        types::Vector<6> getVelocityAttenuation(double dt) const {
+            return types::Vector<6>::Constant(
+                pose_externalized_rotation::computeAttenuation(m_damp, dt));
+        }
+
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
             auto Pminus = predictErrorCovariance(s, *this, dt);
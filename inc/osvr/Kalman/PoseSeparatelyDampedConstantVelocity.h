@@ -46,6 +46,7 @@ namespace kalman {
         using State = pose_externalized_rotation::State;
         using StateVector = pose_externalized_rotation::StateVector;
         using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
+        using StateTransitionStructure = ConstantVelocityStateTransition;
         using BaseProcess = PoseConstantVelocityProcessModel;
         using NoiseAutocorrelation = BaseProcess::NoiseAutocorrelation;
         PoseSeparatelyDampedConstantVelocityProcessModel(
@@ -82,6 +83,17 @@ namespace kalman {
                                                                  m_oriDamp);
         }
 
+        /// The diagonal of the velocity block of A.
+        types::Vector<6> getVelocityAttenuation(double dt) const {
+            types::Vector<6> ret;
+            ret << types::Vector<3>::Constant(
+                pose_externalized_rotation::computeAttenuation(m_posDamp, dt)),
+                types::Vector<3>::Constant(
+                    pose_externalized_rotation::computeAttenuation(m_oriDamp,
+                                                                   dt));
+            return ret;
+        }
+
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
             auto Pminus = predictErrorCovariance(s, *this, dt);
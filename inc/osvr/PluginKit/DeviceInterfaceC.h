@@ -245,6 +245,28 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
                                OSVR_OUT_PTR OSVR_DeviceToken *device)
     OSVR_FUNC_NONNULL((1, 2, 3, 4));
 
+/** @brief Request that raw data sent from the asynchronous device created with
+    these options be queued rather than waiting for the main thread.
+
+    By default, each osvrDeviceSendData() or osvrDeviceSendTimestampedData()
+    call from an async device blocks until the server main loop grants it
+    permission to send. With a send queue, those calls instead copy the message
+    into a bounded lock-free queue and return immediately; the whole queue is
+    flushed each time the main loop services the device. If the queue is full,
+    the message is dropped and the drop is logged.
+
+    Reports sent through the built-in interface types (tracker, analog, etc.)
+    are not affected.
+
+    @param options The DeviceInitOptions for your device.
+    @param capacity Maximum number of messages that may be waiting. Passing 0
+    restores the default blocking behavior.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceAsyncSetSendQueueCapacity(OSVR_IN_PTR OSVR_DeviceInitOptions options,
+                                    OSVR_IN size_t capacity)
+    OSVR_FUNC_NONNULL((1));
+
 /** @} */
 
 /** @brief Request a thread sleep for at least the given number of microseconds.
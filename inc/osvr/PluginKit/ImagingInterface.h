@@ -120,17 +120,8 @@ namespace pluginkit {
                     "Must initialize the imaging interface before using it!");
             }
             cv::Mat const &frame(message.getFrame());
-            util::NumberTypeData typedata =
-                util::opencvNumberTypeData(frame.type());
-            OSVR_ImagingMetadata metadata;
-            metadata.channels = frame.channels();
-            metadata.depth = typedata.getSize();
-            metadata.width = frame.cols;
-            metadata.height = frame.rows;
-            metadata.type = typedata.isFloatingPoint()
-                                ? OSVR_IVT_FLOATING_POINT
-                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
-                                                       : OSVR_IVT_UNSIGNED_INT);
+            OSVR_ImagingMetadata metadata =
+                m_makeMetadata(frame.size(), frame.type());
 
             OSVR_ReturnCode ret = osvrDeviceImagingReportFrame(
                 dev, m_iface, metadata, message.getBuf(), message.getSensor(),
@@ -140,7 +131,57 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Gets a cv::Mat header over storage for the next frame from
+        /// a sensor, so you can capture or decode directly into it instead
+        /// of making an ImagingMessage (which involves extra copies).
+        ///
+        /// Only valid until the matching sendAcquiredFrame() call: do not
+        /// keep it or reallocate it.
+        cv::Mat acquireFrame(DeviceToken &dev, cv::Size size, int type,
+                             OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ImageBufferElement *buf = NULL;
+            OSVR_ReturnCode ret = osvrDeviceImagingAcquireFrameBuffer(
+                dev, m_iface, m_makeMetadata(size, type), sensor, &buf);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not acquire imaging buffer!");
+            }
+            return cv::Mat(size, type, buf);
+        }
+
+        /// @brief Sends the frame written into the cv::Mat returned by the
+        /// most recent acquireFrame() for that sensor.
+        void sendAcquiredFrame(DeviceToken &dev,
+                               OSVR_TimeValue const &timestamp,
+                               OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret = osvrDeviceImagingReportAcquiredFrame(
+                dev, m_iface, sensor, &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not send imaging message!");
+            }
+        }
+
       private:
+        static OSVR_ImagingMetadata m_makeMetadata(cv::Size size, int type) {
+            util::NumberTypeData typedata = util::opencvNumberTypeData(type);
+            OSVR_ImagingMetadata metadata;
+            metadata.channels = CV_MAT_CN(type);
+            metadata.depth = typedata.getSize();
+            metadata.width = size.width;
+            metadata.height = size.height;
+            metadata.type = typedata.isFloatingPoint()
+                                ? OSVR_IVT_FLOATING_POINT
+                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
+                                                       : OSVR_IVT_UNSIGNED_INT);
+            return metadata;
+        }
         OSVR_ImagingDeviceInterface m_iface;
     };
     /// @}
@@ -96,6 +96,45 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 4, 6));
+
+/** @brief Obtain a buffer to write the next frame for a sensor into directly,
+    avoiding the copy made by osvrDeviceImagingReportFrame().
+
+    Where shared-memory transport is in use, the buffer is the next slot of the
+    shared memory ring buffer, so your driver can decode straight into memory
+    that clients read from. The buffer remains owned by OSVR: fill it, then
+    call osvrDeviceImagingReportAcquiredFrame() for the same sensor. Acquiring
+    again for a sensor before reporting abandons the earlier buffer.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param metadata Image metadata, describing the frame you will write.
+    @param sensor Sensor number, usually 0
+    @param [out] buffer Will contain a pointer to at least
+    width * height * channels * depth bytes of aligned memory.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingAcquireFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingMetadata metadata, OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_OUT_PTR OSVR_ImageBufferElement **buffer)
+    OSVR_FUNC_NONNULL((1, 2, 5));
+
+/** @brief Report the frame written into the buffer from the most recent
+    osvrDeviceImagingAcquireFrameBuffer() call for a sensor.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+    @param timestamp Timestamp correlating to frame.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingReportAcquiredFrame(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) OSVR_FUNC_NONNULL((1, 2, 4));
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
@@ -67,6 +67,20 @@ osvrDeviceTrackerConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                            OSVR_OUT_PTR OSVR_TrackerDeviceInterface *iface)
     OSVR_FUNC_NONNULL((1, 2));
 
+/** @brief Choose the precision of the native tracker messages sent for this
+   device (the VRPN-compatible messages sent alongside them are unaffected).
+
+   Single precision makes the messages about half the size, at the cost of
+   resolution. Defaults to double precision.
+
+    @param iface The tracker interface object.
+    @param singlePrecision Whether to send single-precision values.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSetSinglePrecision(
+    OSVR_INOUT_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN OSVR_CBool singlePrecision) OSVR_FUNC_NONNULL((1));
+
 /** @brief Report the full rigid body pose of a sensor, automatically generating
    a timestamp.
 */
@@ -205,6 +219,62 @@ OSVR_ReturnCode osvrDeviceTrackerSendAngularAccelerationTimestamped(
     OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @name Batched pose reports
+    @brief For devices that update many sensors at the same instant (mocap
+   suits, gloves): begin a batch, set the pose of each sensor updated, then
+   commit. Clients receive all the poses in a single message with a shared
+   timestamp, and apply them all before calling any callbacks, so they never
+   see a skeleton that is only partly updated.
+    @{
+*/
+
+/** @brief Choose whether committing a batch also sends each pose as its own
+   VRPN tracker message.
+
+   Off by default, so a batch costs a single message. Turn it on only if
+   clients that predate native tracker messages (or other VRPN clients) need
+   to see this device's batched poses.
+
+    @param iface The tracker interface object.
+    @param perSensorReports Whether to also send per-sensor VRPN reports.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSetBatchLegacyReports(
+    OSVR_INOUT_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN OSVR_CBool perSensorReports) OSVR_FUNC_NONNULL((1));
+
+/** @brief Begin a batch of pose reports, all to be sent with the supplied
+   timestamp. Fails if a batch is already in progress on this interface.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceTrackerBeginBatch(OSVR_IN_PTR OSVR_DeviceToken dev,
+                            OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                            OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3));
+
+/** @brief Add the full rigid body pose of a sensor to the batch in progress.
+   Nothing is sent until the batch is committed. Fails if no batch is in
+   progress.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceTrackerBatchSetPose(OSVR_IN_PTR OSVR_DeviceToken dev,
+                              OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                              OSVR_IN_PTR OSVR_PoseState const *val,
+                              OSVR_IN OSVR_ChannelCount sensor)
+    OSVR_FUNC_NONNULL((1, 2, 3));
+
+/** @brief Send all the poses set since osvrDeviceTrackerBeginBatch() and end
+   the batch. Fails if no batch is in progress.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceTrackerCommitBatch(OSVR_IN_PTR OSVR_DeviceToken dev,
+                             OSVR_IN_PTR OSVR_TrackerDeviceInterface iface)
+    OSVR_FUNC_NONNULL((1, 2));
+/** @} */
+
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
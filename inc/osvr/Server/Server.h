@@ -242,6 +242,24 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
+        /// @brief Switches the server loop between sleeping a fixed amount
+        /// of time each loop (the default) and waiting for a wakeup signal.
+        ///
+        /// In event-driven mode, the loop blocks until an async device has
+        /// data to send, a call from another thread has been serviced, or
+        /// wakeUp() is called. Because network traffic can't wake the loop,
+        /// it still runs at least once per sleep time (or once per
+        /// millisecond if the sleep time is 0).
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void setEventDrivenLoop(bool eventDriven);
+
+        /// @brief Wakes the server loop if it is waiting in event-driven mode,
+        /// for instance when a mainloop method has work to do.
+        ///
+        /// Safe to call from any thread.
+        OSVR_SERVER_EXPORT void wakeUp();
+
 #if 0
         /// @brief Returns the amount of time (in microseconds) that the server
         /// loop sleeps each loop.
@@ -36,7 +36,7 @@
 // Standard includes
 #include <string>
 #include <vector>
-#include <algorithm>
+#include <unordered_map>
 #include <stdexcept>
 
 namespace osvr {
@@ -66,6 +66,8 @@ namespace util {
         /// - A "get or create" method is provided that guarantees the return a
         /// child of the given name (default-constructing one if it doesn't
         /// exist)
+        /// - Child lookup by name is hashed, so it doesn't depend on the
+        /// number of children.
         ///
         /// @todo methods to remove a child (by pointer and by name)
         template <typename ValueType>
@@ -197,6 +199,10 @@ namespace util {
             /// @brief Ownership of children
             ChildList m_children;
 
+            typedef std::unordered_map<std::string, weak_ptr_type> ChildIndex;
+            /// @brief Children by name, for lookup.
+            ChildIndex m_childIndex;
+
             /// @brief Name
             std::string const m_name;
 
@@ -302,22 +308,18 @@ namespace util {
         template <typename ValueType>
         inline typename TreeNode<ValueType>::weak_ptr_type
         TreeNode<ValueType>::m_getChildByName(std::string const &name) const {
-            /// @todo Don't use a linear search here - use an unordered map or
-            /// something.
-            auto it = std::find_if(
-                begin(m_children), end(m_children),
-                [&](ptr_type const &n) { return n->getName() == name; });
-            weak_ptr_type ret = nullptr;
-            if (it != end(m_children)) {
-                ret = (*it).get();
+            auto it = m_childIndex.find(name);
+            if (it == m_childIndex.end()) {
+                return nullptr;
             }
-            return ret;
+            return it->second;
         }
 
         template <typename ValueType>
         inline void TreeNode<ValueType>::m_addChild(
             typename TreeNode<ValueType>::ptr_type const &child) {
             m_children.push_back(child);
+            m_childIndex.emplace(child->getName(), child.get());
         }
 
         template <typename ValueType>
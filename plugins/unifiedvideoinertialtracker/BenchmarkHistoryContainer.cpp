@@ -0,0 +1,186 @@
+/** @file
+    @brief Implementation of a benchmark for the history containers: replays
+   the history traffic of a tracked body with a 1 kHz IMU and 100 Hz video
+   through the deque-based and ring-buffer containers, checking that they
+   agree and timing each.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "CannedIMUMeasurement.h"
+#include "HistoryContainer.h"
+#include "ModelTypes.h"
+#include "RingBufferHistoryContainer.h"
+#include "StateHistory.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace osvr::vbtracker;
+using osvr::util::time::TimeValue;
+
+namespace {
+using BodyStateHistoryEntry = StateHistoryEntry<BodyState>;
+
+/// What happens at one IMU tick: a measurement, and possibly the arrival of
+/// video results for a frame taken some time earlier.
+struct Event {
+    TimeValue imuTime;
+    bool video;
+    TimeValue frameTime;
+};
+
+TimeValue microsecondsToTime(std::int64_t us) {
+    TimeValue ret;
+    ret.seconds = us / 1000000;
+    ret.microseconds = static_cast<std::int32_t>(us % 1000000);
+    return ret;
+}
+
+/// Makes a schedule of IMU reports at about 1 kHz, with video results every
+/// tenth report, each for a frame taken 20 to 40 ms earlier.
+std::vector<Event> makeEvents(std::size_t count) {
+    std::vector<Event> ret;
+    std::mt19937 gen(5489u);
+    std::uniform_int_distribution<int> jitter(-100, 100);
+    std::uniform_int_distribution<int> latency(20000, 40000);
+    std::int64_t us = 1000000;
+    for (std::size_t i = 0; i < count; ++i) {
+        us += 1000 + jitter(gen);
+        Event ev{microsecondsToTime(us), i % 10 == 9, TimeValue{}};
+        if (ev.video) {
+            ev.frameTime = microsecondsToTime(us - latency(gen));
+        }
+        ret.push_back(ev);
+    }
+    return ret;
+}
+
+/// Results to compare between containers.
+struct Checksum {
+    std::size_t found = 0;
+    std::size_t popped = 0;
+    std::size_t replayed = 0;
+    std::size_t pruned = 0;
+    std::size_t finalStates = 0;
+    std::size_t finalImu = 0;
+    bool operator==(Checksum const &o) const {
+        return found == o.found && popped == o.popped &&
+               replayed == o.replayed && pruned == o.pruned &&
+               finalStates == o.finalStates && finalImu == o.finalImu;
+    }
+};
+
+/// Mirrors what TrackedBody does with its state and IMU histories.
+template <typename StateHistory, typename ImuHistory>
+Checksum replay(std::vector<Event> const &events, StateHistory &states,
+                ImuHistory &imu, BodyState const &state,
+                CannedIMUMeasurement const &meas) {
+    Checksum ret;
+    BodyStateHistoryEntry entry(state);
+    for (auto const &ev : events) {
+        imu.push_newest(ev.imuTime, meas);
+        states.push_newest(ev.imuTime, entry);
+        if (!ev.video) {
+            continue;
+        }
+        /// Look up the state as of the frame, replace everything after it
+        /// with the new estimate and replay the IMU since.
+        auto it = states.closest_not_newer(ev.frameTime);
+        if (it == states.end()) {
+            continue;
+        }
+        ++ret.found;
+        ret.popped += states.pop_after(ev.frameTime);
+        if (states.is_valid_to_push_newest(ev.frameTime)) {
+            states.push_newest(ev.frameTime, entry);
+        }
+        for (auto const &imuEntry : imu.get_range_newer_than(ev.frameTime)) {
+            if (states.is_valid_to_push_newest(imuEntry.first)) {
+                states.push_newest(imuEntry.first, entry);
+            }
+            ++ret.replayed;
+        }
+        /// Nothing older than this frame is needed again.
+        ret.pruned += states.pop_before(ev.frameTime);
+        ret.pruned += imu.pop_before(ev.frameTime);
+    }
+    ret.finalStates = states.size();
+    ret.finalImu = imu.size();
+    return ret;
+}
+
+typedef std::chrono::high_resolution_clock clock_type;
+} // namespace
+
+int main() {
+    static const std::size_t EVENTS = 200000;
+    static const int ITERATIONS = 5;
+    auto events = makeEvents(EVENTS);
+    BodyState state;
+    CannedIMUMeasurement meas;
+    meas.setAngVel(Eigen::Vector3d::Zero(), Eigen::Vector3d::Constant(1e-8));
+
+    Checksum dequeSum;
+    Checksum ringSum;
+    clock_type::duration dequeTime{0};
+    clock_type::duration ringTime{0};
+    for (int i = 0; i < ITERATIONS; ++i) {
+        {
+            HistoryContainer<BodyStateHistoryEntry> states;
+            HistoryContainer<CannedIMUMeasurement> imu;
+            auto begin = clock_type::now();
+            dequeSum = replay(events, states, imu, state, meas);
+            dequeTime += clock_type::now() - begin;
+        }
+        {
+            RingBufferHistoryContainer<BodyStateHistoryEntry> states(1024,
+                                                                     0.25);
+            RingBufferHistoryContainer<CannedIMUMeasurement> imu(1024, 0.25);
+            auto begin = clock_type::now();
+            ringSum = replay(events, states, imu, state, meas);
+            ringTime += clock_type::now() - begin;
+        }
+    }
+
+    auto perEventNanoseconds = [&](clock_type::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() /
+               (double(ITERATIONS) * EVENTS);
+    };
+    bool match = dequeSum == ringSum;
+    std::cout << EVENTS << " IMU reports, " << ringSum.found
+              << " video updates, " << ringSum.replayed
+              << " IMU reports replayed: "
+              << (match ? "containers agree" : "MISMATCH") << "\n";
+    std::cout << "Deque history:       " << perEventNanoseconds(dequeTime)
+              << " ns/report\n";
+    std::cout << "Ring buffer history: " << perEventNanoseconds(ringTime)
+              << " ns/report" << std::endl;
+    return match ? 0 : 1;
+}
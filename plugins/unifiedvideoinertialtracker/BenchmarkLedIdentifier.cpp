@@ -0,0 +1,244 @@
+/** @file
+    @brief Implementation of a benchmark for the LED identifier: replays
+   brightness sequences through it and through the previous string-search
+   identifier, checking that they agree and timing each per frame.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HDKLedIdentifier.h"
+#include "IdentifierHelpers.h"
+#include "LED.h"
+#include "MakeHDKTrackingSystem.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+/// @brief The identification algorithm as it was before the bitmask table:
+/// threshold into a string and search each doubled pattern for it.
+class ReferenceIdentifier {
+  public:
+    explicit ReferenceIdentifier(PatternStringList const &patterns) {
+        for (auto &pat : patterns) {
+            if (pat.empty() || pat.find_first_not_of("*.") != pat.npos) {
+                m_patterns.emplace_back();
+                continue;
+            }
+            m_length = pat.size();
+            auto wrapped = pat + pat;
+            wrapped.pop_back();
+            m_patterns.push_back(std::move(wrapped));
+        }
+    }
+    int getId(BrightnessList &brightnesses) const {
+        if (m_length == 0 || brightnesses.size() < m_length) {
+            return Led::SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA;
+        }
+        truncateBrightnessListTo(brightnesses, m_length);
+        Brightness minVal, maxVal;
+        std::tie(minVal, maxVal) = findMinMaxBrightness(brightnesses);
+        if (maxVal - minVal <= 0.3) {
+            return Led::SENTINEL_INSUFFICIENT_EXTREMA_DIFFERENCE;
+        }
+        auto bits =
+            getBitsUsingThreshold(brightnesses, (minVal + maxVal) / 2);
+        for (size_t i = 0; i < m_patterns.size(); i++) {
+            if (!m_patterns[i].empty() &&
+                m_patterns[i].find(bits) != std::string::npos) {
+                return static_cast<int>(i);
+            }
+        }
+        return Led::SENTINEL_NO_PATTERN_RECOGNIZED_DESPITE_SUFFICIENT_DATA;
+    }
+
+  private:
+    std::size_t m_length = 0;
+    PatternList m_patterns;
+};
+
+/// @brief A blob's brightness over time, and which target it belongs to.
+struct Sequence {
+    std::size_t target;
+    std::vector<Brightness> brightnesses;
+};
+
+/// @brief Reads recorded sequences: one blob per line, the target index
+/// followed by its brightness in each frame.
+std::vector<Sequence> readSequences(std::string const &fn) {
+    std::vector<Sequence> ret;
+    std::ifstream is(fn);
+    std::string line;
+    while (std::getline(is, line)) {
+        std::istringstream ls(line);
+        Sequence seq;
+        if (!(ls >> seq.target)) {
+            continue;
+        }
+        Brightness b;
+        while (ls >> b) {
+            seq.brightnesses.push_back(b);
+        }
+        ret.push_back(std::move(seq));
+    }
+    return ret;
+}
+
+/// @brief Makes sequences like those seen from an HDK: each beacon blinking
+/// its pattern from a random starting point with noisy brightness, plus a
+/// steady light and a flickering reflection per target.
+std::vector<Sequence>
+synthesizeSequences(std::vector<PatternStringList> const &targets,
+                    std::size_t frames) {
+    std::vector<Sequence> ret;
+    std::mt19937 gen(5489u);
+    std::normal_distribution<Brightness> noise(0.f, 0.15f);
+    std::uniform_real_distribution<Brightness> flicker(1.f, 5.f);
+    for (std::size_t t = 0; t < targets.size(); ++t) {
+        for (auto &pat : targets[t]) {
+            if (pat.empty() || pat.find_first_not_of("*.") != pat.npos) {
+                continue;
+            }
+            Sequence seq{t, {}};
+            auto phase = std::uniform_int_distribution<std::size_t>(
+                0, pat.size() - 1)(gen);
+            for (std::size_t f = 0; f < frames; ++f) {
+                auto bright = pat[(f + phase) % pat.size()] == '*';
+                seq.brightnesses.push_back((bright ? 4.f : 2.f) + noise(gen));
+            }
+            ret.push_back(std::move(seq));
+        }
+        Sequence steady{t, {}};
+        Sequence reflection{t, {}};
+        for (std::size_t f = 0; f < frames; ++f) {
+            steady.brightnesses.push_back(3.f + noise(gen) / 10);
+            reflection.brightnesses.push_back(flicker(gen));
+        }
+        ret.push_back(std::move(steady));
+        ret.push_back(std::move(reflection));
+    }
+    return ret;
+}
+
+typedef std::chrono::high_resolution_clock clock_type;
+} // namespace
+
+int main(int argc, char *argv[]) {
+    /// Two targets, as on the HDK: 40 beacons in all.
+    std::vector<PatternStringList> targets = {
+        OsvrHdkLedIdentifier_SENSOR0_PATTERNS,
+        OsvrHdkLedIdentifier_SENSOR1_PATTERNS};
+
+    std::vector<Sequence> sequences;
+    if (argc > 1) {
+        std::cout << "Replaying brightness sequences from " << argv[1]
+                  << std::endl;
+        sequences = readSequences(argv[1]);
+    } else {
+        sequences = synthesizeSequences(targets, 2000);
+    }
+    std::size_t frames = 0;
+    for (auto &seq : sequences) {
+        if (seq.target >= targets.size()) {
+            std::cerr << "Sequence for unknown target " << seq.target
+                      << std::endl;
+            return -1;
+        }
+        frames = std::max(frames, seq.brightnesses.size());
+    }
+
+    std::vector<std::unique_ptr<OsvrHdkLedIdentifier> > identifiers;
+    std::vector<ReferenceIdentifier> references;
+    for (auto &patterns : targets) {
+        identifiers.emplace_back(new OsvrHdkLedIdentifier(patterns));
+        references.emplace_back(patterns);
+        std::cout << "Target " << identifiers.size() - 1 << ": "
+                  << identifiers.back()->getNumAmbiguousCodes()
+                  << " ambiguous codes" << std::endl;
+    }
+
+    std::vector<BrightnessHistory> histories(sequences.size());
+    std::vector<BrightnessList> lists(sequences.size());
+    std::vector<int> ids(sequences.size());
+    clock_type::duration tableTime{0};
+    clock_type::duration referenceTime{0};
+    std::size_t mismatches = 0;
+    std::size_t identified = 0;
+    for (std::size_t f = 0; f < frames; ++f) {
+        auto begin = clock_type::now();
+        for (std::size_t i = 0; i < sequences.size(); ++i) {
+            auto &seq = sequences[i];
+            if (f >= seq.brightnesses.size()) {
+                continue;
+            }
+            histories[i].push_back(seq.brightnesses[f]);
+            bool lastBright = false;
+            ids[i] = identifiers[seq.target]
+                         ->getId(ZeroBasedBeaconId(-1), histories[i],
+                                 lastBright, false)
+                         .value();
+        }
+        auto middle = clock_type::now();
+        for (std::size_t i = 0; i < sequences.size(); ++i) {
+            auto &seq = sequences[i];
+            if (f >= seq.brightnesses.size()) {
+                continue;
+            }
+            lists[i].push_back(seq.brightnesses[f]);
+            auto id = references[seq.target].getId(lists[i]);
+            if (id != ids[i]) {
+                ++mismatches;
+            }
+            if (id >= 0) {
+                ++identified;
+            }
+        }
+        auto end = clock_type::now();
+        tableTime += middle - begin;
+        referenceTime += end - middle;
+    }
+
+    auto perFrameMicroseconds = [&](clock_type::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / frames;
+    };
+    std::cout << sequences.size() << " blobs on " << targets.size()
+              << " targets, " << frames << " frames, " << identified
+              << " identifications, " << mismatches << " mismatches\n";
+    std::cout << "Bitmask table identifier: "
+              << perFrameMicroseconds(tableTime) << " us/frame\n";
+    std::cout << "String search identifier: "
+              << perFrameMicroseconds(referenceTime) << " us/frame"
+              << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,392 @@
+/** @file
+    @brief Implementation of a regression benchmark for RANSAC pose
+   estimation: replays recorded or synthetic frames of identified beacons,
+   with occlusions, through the estimator as it was (OpenCV's RANSAC with a
+   fixed five iterations) and as it is now, unseeded and seeded, reporting how
+   quickly each re-acquires the target, how accurately, and at what cost.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseEstimator_RANSAC.h"
+#include "LED.h"
+#include "LedIdentifier.h"
+#include "MakeHDKTrackingSystem.h"
+#include "HDKData.h"
+#include "cvToEigen.h"
+
+// Library/third-party includes
+#include <opencv2/calib3d/calib3d.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+/// Frames per second, for converting re-acquisition times.
+static const double FRAME_RATE = 100.;
+
+/// "Identifies" each blob as the beacon whose id the benchmark stashed in its
+/// brightness.
+class StashedIdIdentifier : public LedIdentifier {
+  public:
+    ZeroBasedBeaconId getId(ZeroBasedBeaconId, BrightnessHistory const &bright,
+                            bool &lastBright, bool) const override {
+        lastBright = false;
+        return ZeroBasedBeaconId(static_cast<int>(bright.back()));
+    }
+};
+
+/// An identified blob, in the image coordinates used for tracking.
+struct Blob {
+    int id;
+    cv::Point2f loc;
+};
+
+struct Frame {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    std::vector<Blob> blobs;
+    bool haveTruth = false;
+    Eigen::Vector3d xlate;
+    Eigen::Quaterniond quat;
+};
+using FrameList = std::vector<Frame, Eigen::aligned_allocator<Frame>>;
+
+/// @brief Reads recorded frames: one blob per line, the frame number
+/// followed by the zero-based beacon id and image location (as used for
+/// tracking) it was identified as.
+FrameList readFrames(std::string const &fn) {
+    FrameList ret;
+    std::ifstream is(fn);
+    std::string line;
+    while (std::getline(is, line)) {
+        std::istringstream ls(line);
+        std::size_t frame;
+        Blob blob;
+        if (!(ls >> frame >> blob.id >> blob.loc.x >> blob.loc.y)) {
+            continue;
+        }
+        if (frame >= ret.size()) {
+            ret.resize(frame + 1);
+        }
+        ret[frame].blobs.push_back(blob);
+    }
+    return ret;
+}
+
+/// @brief Makes frames of an HDK face plate bobbing and turning in front of
+/// the camera, with noisy blob locations, the odd misidentified beacon, and
+/// the whole target occluded for 30 frames out of every 250.
+FrameList synthesizeFrames(std::vector<Eigen::Vector3d> const &beacons,
+                           std::vector<Eigen::Vector3d> const &directions,
+                           CameraParameters const &camParams,
+                           std::size_t frames) {
+    FrameList ret(frames);
+    std::mt19937 gen(5489u);
+    std::normal_distribution<float> noise(0.f, 0.3f);
+    std::uniform_real_distribution<double> uniform;
+    std::uniform_int_distribution<int> anyBeacon(
+        0, static_cast<int>(beacons.size()) - 1);
+    for (std::size_t f = 0; f < frames; ++f) {
+        auto &frame = ret[f];
+        auto t = f / FRAME_RATE;
+        frame.haveTruth = true;
+        frame.xlate = Eigen::Vector3d(0.1 * std::sin(0.7 * t),
+                                      0.05 * std::sin(1.1 * t),
+                                      0.7 + 0.15 * std::sin(0.3 * t));
+        frame.quat =
+            Eigen::AngleAxisd(0.6 * std::sin(0.9 * t),
+                              Eigen::Vector3d::UnitY()) *
+            Eigen::AngleAxisd(0.3 * std::sin(1.3 * t),
+                              Eigen::Vector3d::UnitX());
+        if (f % 250 >= 220) {
+            continue;
+        }
+        for (std::size_t i = 0; i < beacons.size(); ++i) {
+            Eigen::Vector3d pt = frame.quat * beacons[i] + frame.xlate;
+            Eigen::Vector3d dir = frame.quat * directions[i];
+            if (dir.dot(-pt.normalized()) < 0.3) {
+                /// Facing away from the camera.
+                continue;
+            }
+            cv::Point2f loc(static_cast<float>(camParams.focalLengthX() *
+                                                   pt.x() / pt.z() +
+                                               camParams.principalPoint().x),
+                            static_cast<float>(camParams.focalLengthY() *
+                                                   pt.y() / pt.z() +
+                                               camParams.principalPoint().y));
+            if (loc.x < 0 || loc.y < 0 ||
+                loc.x >= camParams.imageSize.width ||
+                loc.y >= camParams.imageSize.height) {
+                continue;
+            }
+            auto id = static_cast<int>(i);
+            if (uniform(gen) < 0.05) {
+                id = anyBeacon(gen);
+            }
+            frame.blobs.push_back(
+                Blob{id, loc + cv::Point2f(noise(gen), noise(gen))});
+        }
+    }
+    return ret;
+}
+
+/// The estimator as it was: OpenCV's RANSAC, with five iterations.
+bool referenceEstimate(CameraParameters const &camParams,
+                       LedPtrList const &leds, BeaconStateVec const &beacons,
+                       Eigen::Vector3d &xlate, Eigen::Quaterniond &quat) {
+    std::vector<cv::Point3f> objectPoints;
+    std::vector<cv::Point2f> imagePoints;
+    for (auto const &led : leds) {
+        imagePoints.push_back(led->getLocationForTracking());
+        objectPoints.push_back(vec3dToCVPoint3f(
+            beacons[asIndex(makeZeroBased(led->getID()))]->stateVector()));
+    }
+    if (objectPoints.size() < 4) {
+        return false;
+    }
+    cv::Mat inlierIndices;
+    cv::Mat rvec;
+    cv::Mat tvec;
+#if CV_MAJOR_VERSION == 2
+    cv::solvePnPRansac(objectPoints, imagePoints, camParams.cameraMatrix,
+                       camParams.distortionParameters, rvec, tvec, false, 5,
+                       8.0f, static_cast<int>(objectPoints.size()),
+                       inlierIndices);
+#elif CV_MAJOR_VERSION == 3
+    if (!cv::solvePnPRansac(objectPoints, imagePoints, camParams.cameraMatrix,
+                            camParams.distortionParameters, rvec, tvec, false,
+                            5, 8.0f, 0.99, inlierIndices)) {
+        return false;
+    }
+#else
+#error "Unrecognized OpenCV version!"
+#endif
+    if (inlierIndices.rows < 4) {
+        return false;
+    }
+    xlate = cvToVector3d(tvec);
+    quat = cvRotVecToQuat(rvec);
+    return true;
+}
+
+/// Called with the LEDs of a frame, the frame itself (for any truth), and the
+/// last pose estimated (if any) in the in/out parameters.
+using EstimateFunction =
+    std::function<bool(LedPtrList const &, Frame const &, bool haveLast,
+                       Eigen::Vector3d &, Eigen::Quaterniond &)>;
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+void runSequence(std::string const &name, FrameList const &frames,
+                 CameraParameters const &camParams, std::size_t numBeacons,
+                 EstimateFunction const &estimate) {
+    StashedIdIdentifier identifier;
+    std::vector<Led> leds;
+    LedPtrList usable;
+
+    std::size_t attempts = 0;
+    std::size_t successes = 0;
+    std::size_t reacquisitions = 0;
+    std::size_t reacquireFrames = 0;
+    std::size_t maxReacquireFrames = 0;
+    std::size_t comparedPoses = 0;
+    double totalError = 0;
+    double maxError = 0;
+    clock_type::duration estimationTime{0};
+
+    bool haveLast = false;
+    Eigen::Vector3d lastXlate = Eigen::Vector3d::Zero();
+    Eigen::Quaterniond lastQuat = Eigen::Quaterniond::Identity();
+    /// Whether the target has been in view, and a pose estimated, since the
+    /// last time it went out of view.
+    bool tracked = false;
+    /// First frame back in view after being out of view.
+    std::size_t reappeared = 0;
+    bool waitingToReacquire = false;
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        auto const &frame = frames[f];
+        leds.clear();
+        leds.reserve(frame.blobs.size());
+        usable.clear();
+        for (auto const &blob : frame.blobs) {
+            if (blob.id < 0 || blob.id >= static_cast<int>(numBeacons)) {
+                continue;
+            }
+            LedMeasurement meas;
+            /// Led flips the location for tracking, so flip it first.
+            meas.loc =
+                cv::Point2f(camParams.imageSize.width - blob.loc.x,
+                            camParams.imageSize.height - blob.loc.y);
+            meas.imageSize = camParams.imageSize;
+            meas.brightness = static_cast<Brightness>(blob.id);
+            leds.emplace_back(&identifier, meas);
+            usable.push_back(&leds.back());
+        }
+        if (usable.size() < 4) {
+            if (tracked) {
+                tracked = false;
+                waitingToReacquire = true;
+                reappeared = frames.size();
+            }
+            continue;
+        }
+        if (waitingToReacquire && reappeared == frames.size()) {
+            reappeared = f;
+        }
+
+        ++attempts;
+        Eigen::Vector3d xlate = lastXlate;
+        Eigen::Quaterniond quat = lastQuat;
+        auto begin = clock_type::now();
+        auto success = estimate(usable, frame, haveLast, xlate, quat);
+        estimationTime += clock_type::now() - begin;
+        if (!success) {
+            continue;
+        }
+        ++successes;
+        haveLast = true;
+        lastXlate = xlate;
+        lastQuat = quat;
+        tracked = true;
+        if (waitingToReacquire) {
+            waitingToReacquire = false;
+            auto took = f - reappeared + 1;
+            ++reacquisitions;
+            reacquireFrames += took;
+            maxReacquireFrames = std::max(maxReacquireFrames, took);
+        }
+        if (frame.haveTruth) {
+            auto error = (xlate - frame.xlate).norm() * 1000.;
+            ++comparedPoses;
+            totalError += error;
+            maxError = std::max(maxError, error);
+        }
+    }
+
+    std::cout << name << ":\n";
+    std::cout << "  " << successes << " of " << attempts
+              << " frames with enough beacons got a pose\n";
+    if (reacquisitions > 0) {
+        std::cout << "  Re-acquired " << reacquisitions
+                  << " times: mean "
+                  << double(reacquireFrames) / reacquisitions << " frames ("
+                  << 1000. * reacquireFrames / reacquisitions / FRAME_RATE
+                  << " ms), max " << maxReacquireFrames << " frames\n";
+    }
+    if (comparedPoses > 0) {
+        std::cout << "  Position error (mm): mean "
+                  << totalError / comparedPoses << ", max " << maxError
+                  << "\n";
+    }
+    if (attempts > 0) {
+        std::cout << "  "
+                  << std::chrono::duration<double, std::micro>(
+                         estimationTime)
+                             .count() /
+                         attempts
+                  << " us per frame" << std::endl;
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    auto camParams = getSimulatedHDKCameraParameters();
+
+    /// The HDK face plate, in meters, in our coordinate system.
+    std::vector<Eigen::Vector3d> beaconLocations;
+    std::vector<Eigen::Vector3d> beaconDirections;
+    BeaconStateVec beacons;
+    for (std::size_t i = 0; i < OsvrHdkLedLocations_SENSOR0.size(); ++i) {
+        auto pt = transformFromHDKData(OsvrHdkLedLocations_SENSOR0[i]);
+        auto dir = transformFromHDKData(OsvrHdkLedDirections_SENSOR0[i]);
+        beaconLocations.emplace_back(pt.x, pt.y, pt.z);
+        beaconDirections.emplace_back(dir[0], dir[1], dir[2]);
+        beacons.emplace_back(new BeaconState(pt.x, pt.y, pt.z));
+    }
+    std::vector<BeaconData> beaconDebug(beacons.size());
+
+    FrameList frames;
+    if (argc > 1) {
+        std::cout << "Replaying frames from " << argv[1] << std::endl;
+        frames = readFrames(argv[1]);
+    } else {
+        frames = synthesizeFrames(beaconLocations, beaconDirections,
+                                  camParams, 5000);
+    }
+    std::cout << frames.size() << " frames, " << beacons.size()
+              << " beacons" << std::endl;
+
+    runSequence("Reference (OpenCV RANSAC, 5 iterations)", frames, camParams,
+                beacons.size(),
+                [&](LedPtrList const &leds, Frame const &, bool,
+                    Eigen::Vector3d &xlate, Eigen::Quaterniond &quat) {
+                    return referenceEstimate(camParams, leds, beacons, xlate,
+                                             quat);
+                });
+
+    ConfigParams params;
+    RANSACPoseEstimator unseeded(params);
+    runSequence("P3P RANSAC, unseeded", frames, camParams, beacons.size(),
+                [&](LedPtrList const &leds, Frame const &, bool,
+                    Eigen::Vector3d &xlate, Eigen::Quaterniond &quat) {
+                    return unseeded(camParams, leds, beacons, beaconDebug,
+                                    xlate, quat);
+                });
+    std::cout << "  " << unseeded.getStats() << std::endl;
+
+    RANSACPoseEstimator seeded(params);
+    runSequence("P3P RANSAC, seeded with the last pose", frames, camParams,
+                beacons.size(),
+                [&](LedPtrList const &leds, Frame const &, bool haveLast,
+                    Eigen::Vector3d &xlate, Eigen::Quaterniond &quat) {
+                    return seeded(camParams, leds, beacons, beaconDebug, xlate,
+                                  quat, haveLast);
+                });
+    std::cout << "  " << seeded.getStats() << std::endl;
+
+    /// Where we have truth, use its orientation as a stand-in for the IMU.
+    RANSACPoseEstimator imuSeeded(params);
+    runSequence("P3P RANSAC, seeded with the last position and IMU "
+                "orientation",
+                frames, camParams, beacons.size(),
+                [&](LedPtrList const &leds, Frame const &frame, bool haveLast,
+                    Eigen::Vector3d &xlate, Eigen::Quaterniond &quat) {
+                    if (frame.haveTruth) {
+                        quat = frame.quat;
+                    }
+                    return imuSeeded(camParams, leds, beacons, beaconDebug,
+                                     xlate, quat, haveLast);
+                });
+    std::cout << "  " << imuSeeded.getStats() << std::endl;
+    return 0;
+}
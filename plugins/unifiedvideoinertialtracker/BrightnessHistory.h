@@ -0,0 +1,82 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BrightnessHistory_h_GUID_3F0B6A52_51B4_4E0C_9A3D_7C2E8D41B6F0
+#define INCLUDED_BrightnessHistory_h_GUID_3F0B6A52_51B4_4E0C_9A3D_7C2E8D41B6F0
+
+// Internal Includes
+#include "BasicTypes.h"
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <array>
+#include <cstddef>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Fixed-capacity ring of the most recent brightness measurements
+    /// of a blob, oldest first. Once full, adding a measurement discards the
+    /// oldest one, so it never allocates.
+    class BrightnessHistory {
+      public:
+        /// Blink patterns can be at most this long: the identifier encodes
+        /// them as bits in a 32-bit integer.
+        static const std::size_t CAPACITY = 32;
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        void clear() { m_size = 0; }
+
+        void push_back(Brightness val) {
+            m_data[(m_begin + m_size) % CAPACITY] = val;
+            if (m_size == CAPACITY) {
+                m_begin = (m_begin + 1) % CAPACITY;
+            } else {
+                ++m_size;
+            }
+        }
+
+        /// @brief Element i, counting from the oldest.
+        Brightness operator[](std::size_t i) const {
+            BOOST_ASSERT_MSG(i < m_size, "Index out of range!");
+            return m_data[(m_begin + i) % CAPACITY];
+        }
+
+        Brightness back() const {
+            BOOST_ASSERT_MSG(!empty(), "Must be a non-empty history!");
+            return (*this)[m_size - 1];
+        }
+
+      private:
+        std::array<Brightness, CAPACITY> m_data;
+        std::size_t m_begin = 0;
+        std::size_t m_size = 0;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BrightnessHistory_h_GUID_3F0B6A52_51B4_4E0C_9A3D_7C2E8D41B6F0
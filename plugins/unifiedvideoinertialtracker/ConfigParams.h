@@ -79,10 +79,36 @@ namespace vbtracker {
         /// Whether to show the debug windows and debug messages.
         bool debug = false;
 
+        /// When true, once every target is tracked by the Kalman filter, blob
+        /// extraction only looks at regions around where the beacons are
+        /// predicted to appear, and the blobs already being followed, instead
+        /// of the whole frame.
+        bool roiBlobExtraction = false;
+
+        /// With roiBlobExtraction, the whole frame is still searched at least
+        /// this often (in frames), to pick up anything new.
+        int roiFullFrameInterval = 30;
+
+        /// With roiBlobExtraction, the minimum radius (in pixels) searched
+        /// around each predicted beacon location.
+        double roiMargin = 10.;
+
+        /// With roiBlobExtraction, the radius searched around each predicted
+        /// beacon location grows by this many standard deviations of the
+        /// predicted position and orientation uncertainty.
+        double roiSigmas = 3.;
+
         /// How many threads to let OpenCV use. Set to 0 or less to let OpenCV
         /// decide (that is, not set an explicit preference)
         int numThreads = 1;
 
+        /// How many threads (including the tracking thread itself) to use for
+        /// matching blobs to beacons and estimating poses, split up by body,
+        /// each frame. 1 does it all serially on the tracking thread; 0 or
+        /// less uses one per hardware thread. Only helps with several bodies
+        /// in view at once.
+        int bodyEstimationThreads = 1;
+
         /// This is the autocorrelation kernel of the process noise. The first
         /// three elements correspond to position, the second three to
         /// incremental rotation.
@@ -98,6 +124,35 @@ namespace vbtracker {
         /// smaller = faster decay/higher damping. In range [0, 1]
         double angularVelocityDecayCoefficient = 0.9;
 
+        /// The most minimal-sample (P3P) pose hypotheses RANSAC tries in a
+        /// frame when acquiring a target from scratch.
+        int ransacIterations = 5;
+
+        /// The most hypotheses RANSAC tries in a frame when re-acquiring a
+        /// target it lost track of, after first trying the last known pose
+        /// (kept up to date by any IMU) as-is.
+        int ransacReacquireIterations = 20;
+
+        /// RANSAC stops trying hypotheses once one agrees with at least this
+        /// proportion of the identified beacons. In range (0, 1]
+        double ransacEarlyExitInlierRatio = 0.8;
+
+        /// How close (in pixels) a beacon has to reproject to its blob to
+        /// agree with a RANSAC hypothesis.
+        double ransacInlierThreshold = 8.;
+
+        /// When true, a Kalman pose estimate for a video frame older than the
+        /// latest IMU measurement is incorporated by carrying the correction
+        /// it made forward to the current state (a delayed-state update),
+        /// rather than by rolling back the state history and replaying every
+        /// newer IMU measurement. Cheaper, but approximate: it doesn't account
+        /// for how those IMU measurements would have tempered the correction.
+        bool delayedStateVideoFusion = false;
+
+        /// With delayedStateVideoFusion, frames older than this (in seconds)
+        /// relative to the current state are still incorporated by replay.
+        double delayedStateMaxLag = 0.05;
+
         /// The measurement variance (units: m^2) is included in the plugin
         /// along with the coordinates of the beacons. Some beacons are observed
         /// with higher variance than others, due to known difficulties in
@@ -144,6 +199,17 @@ namespace vbtracker {
         /// measurements with a "bad" residual
         double highResidualVariancePenalty = 10.;
 
+        /// When true, the Kalman estimator applies all of a frame's beacon
+        /// measurements to the body state in a single batch correction, rather
+        /// than one correction per beacon. Beacons aren't autocalibrated in
+        /// this mode: instead, the uncertainty in each beacon's position is
+        /// added to that of its measurement.
+        bool batchBeaconCorrection = false;
+
+        /// With batchBeaconCorrection, update the error covariance in the
+        /// Joseph form.
+        bool batchCorrectionJosephForm = false;
+
         /// When true, will stream debug info (variance, pixel measurement,
         /// pixel residual) on up to the first 34 beacons of your first sensor
         /// as analogs.
@@ -78,7 +78,15 @@ namespace vbtracker {
                              "blobMoveThreshold");
         getOptionalParameter(config.blobsKeepIdentity, root,
                              "blobsKeepIdentity");
+        getOptionalParameter(config.roiBlobExtraction, root,
+                             "roiBlobExtraction");
+        getOptionalParameter(config.roiFullFrameInterval, root,
+                             "roiFullFrameInterval");
+        getOptionalParameter(config.roiMargin, root, "roiMargin");
+        getOptionalParameter(config.roiSigmas, root, "roiSigmas");
         getOptionalParameter(config.numThreads, root, "numThreads");
+        getOptionalParameter(config.bodyEstimationThreads, root,
+                             "bodyEstimationThreads");
 #if 0
         getOptionalParameter(config.streamBeaconDebugInfo, root,
                              "streamBeaconDebugInfo");
@@ -102,6 +110,16 @@ namespace vbtracker {
             << " is deprecated/ignored: use 'cameraPosition' for similar "
                "effects with this plugin.";
 
+        /// RANSAC-related parameters
+        getOptionalParameter(config.ransacIterations, root,
+                             "ransacIterations");
+        getOptionalParameter(config.ransacReacquireIterations, root,
+                             "ransacReacquireIterations");
+        getOptionalParameter(config.ransacEarlyExitInlierRatio, root,
+                             "ransacEarlyExitInlierRatio");
+        getOptionalParameter(config.ransacInlierThreshold, root,
+                             "ransacInlierThreshold");
+
         /// Kalman-related parameters
         getOptionalParameter(config.beaconProcessNoise, root,
                              "beaconProcessNoise");
@@ -111,10 +129,18 @@ namespace vbtracker {
                              "linearVelocityDecayCoefficient");
         getOptionalParameter(config.angularVelocityDecayCoefficient, root,
                              "angularVelocityDecayCoefficient");
+        getOptionalParameter(config.delayedStateVideoFusion, root,
+                             "delayedStateVideoFusion");
+        getOptionalParameter(config.delayedStateMaxLag, root,
+                             "delayedStateMaxLag");
         getOptionalParameter(config.measurementVarianceScaleFactor, root,
                              "measurementVarianceScaleFactor");
         getOptionalParameter(config.highResidualVariancePenalty, root,
                              "highResidualVariancePenalty");
+        getOptionalParameter(config.batchBeaconCorrection, root,
+                             "batchBeaconCorrection");
+        getOptionalParameter(config.batchCorrectionJosephForm, root,
+                             "batchCorrectionJosephForm");
 #if 0
         getOptionalParameter(config.boundingBoxFilterRatio, root,
                              "boundingBoxFilterRatio");
@@ -138,6 +164,7 @@ namespace vbtracker {
             getOptionalParameter(config.blobParams.minDistBetweenBlobs, blob,
                                  "minDistBetweenBlobs");
             getOptionalParameter(config.blobParams.minArea, blob, "minArea");
+            getOptionalParameter(config.blobParams.maxArea, blob, "maxArea");
             getOptionalParameter(config.blobParams.filterByCircularity, blob,
                                  "filterByCircularity");
             getOptionalParameter(config.blobParams.minCircularity, blob,
@@ -152,6 +179,8 @@ namespace vbtracker {
                                  "maxThresholdAlpha");
             getOptionalParameter(config.blobParams.thresholdSteps, blob,
                                  "thresholdSteps");
+            getOptionalParameter(config.blobParams.useSimpleBlobDetector,
+                                 blob, "useSimpleBlobDetector");
         }
 
         /// IMU-related parameters
@@ -0,0 +1,145 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FramePipeline.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <ostream>
+
+namespace osvr {
+namespace vbtracker {
+    const char *getPipelineStageName(PipelineStage stage) {
+        switch (stage) {
+        case PipelineStage::Retrieve:
+            return "retrieve";
+        case PipelineStage::ExtractionWait:
+            return "extraction wait";
+        case PipelineStage::Extraction:
+            return "extraction";
+        case PipelineStage::EstimationWait:
+            return "estimation wait";
+        case PipelineStage::Estimation:
+            return "estimation";
+        case PipelineStage::Total:
+            return "total";
+        }
+        return "unknown";
+    }
+
+    /// Upper bound of the first bucket, in milliseconds.
+    static const double FIRST_BUCKET_LIMIT = 0.25;
+
+    double LatencyHistogramData::getBucketLimit(std::size_t bucket) {
+        return FIRST_BUCKET_LIMIT * double(1u << bucket);
+    }
+
+    std::ostream &operator<<(std::ostream &os,
+                             LatencyHistogramData const &data) {
+        os << data.count << " frames";
+        if (data.count == 0) {
+            return os;
+        }
+        os << ", mean " << data.totalMilliseconds / data.count << " ms, max "
+           << data.maxMilliseconds << " ms:";
+        for (std::size_t i = 0; i < LatencyHistogramData::NUM_BUCKETS; ++i) {
+            if (data.buckets[i] == 0) {
+                continue;
+            }
+            if (i + 1 < LatencyHistogramData::NUM_BUCKETS) {
+                os << " <" << LatencyHistogramData::getBucketLimit(i);
+            } else {
+                os << " >=" << LatencyHistogramData::getBucketLimit(i - 1);
+            }
+            os << "ms:" << data.buckets[i];
+        }
+        return os;
+    }
+
+    LatencyHistogram::LatencyHistogram()
+        : m_count(0), m_totalMicroseconds(0), m_maxMicroseconds(0) {
+        for (auto &bucket : m_buckets) {
+            bucket = 0;
+        }
+    }
+
+    void LatencyHistogram::record(PipelineClock::duration latency) {
+        using namespace std::chrono;
+        auto us = duration_cast<microseconds>(latency).count();
+        auto micros = static_cast<std::uint64_t>(us < 0 ? 0 : us);
+        std::size_t bucket = 0;
+        while (bucket + 1 < LatencyHistogramData::NUM_BUCKETS &&
+               micros >= LatencyHistogramData::getBucketLimit(bucket) * 1000.) {
+            ++bucket;
+        }
+        /// Only one thread records, so these needn't be read-modify-write
+        /// atomic operations: they just have to be safe to read elsewhere.
+        auto relaxed = std::memory_order_relaxed;
+        m_buckets[bucket].store(m_buckets[bucket].load(relaxed) + 1, relaxed);
+        m_count.store(m_count.load(relaxed) + 1, relaxed);
+        m_totalMicroseconds.store(m_totalMicroseconds.load(relaxed) + micros,
+                                  relaxed);
+        if (micros > m_maxMicroseconds.load(relaxed)) {
+            m_maxMicroseconds.store(micros, relaxed);
+        }
+    }
+
+    LatencyHistogramData LatencyHistogram::getData() const {
+        LatencyHistogramData ret;
+        for (std::size_t i = 0; i < LatencyHistogramData::NUM_BUCKETS; ++i) {
+            ret.buckets[i] = m_buckets[i].load();
+        }
+        ret.count = m_count.load();
+        ret.totalMilliseconds = m_totalMicroseconds.load() / 1000.;
+        ret.maxMilliseconds = m_maxMicroseconds.load() / 1000.;
+        return ret;
+    }
+
+    void PipelineLatency::recordFrame(PipelineFrame const &frame,
+                                      PipelineClock::time_point estimationBegin,
+                                      PipelineClock::time_point estimated) {
+        auto &self = *this;
+        self[PipelineStage::Retrieve].record(frame.retrieved - frame.grabbed);
+        self[PipelineStage::ExtractionWait].record(frame.extractionBegin -
+                                                   frame.retrieved);
+        self[PipelineStage::Extraction].record(frame.extracted -
+                                               frame.extractionBegin);
+        self[PipelineStage::EstimationWait].record(estimationBegin -
+                                                   frame.extracted);
+        self[PipelineStage::Estimation].record(estimated - estimationBegin);
+        self[PipelineStage::Total].record(estimated - frame.grabbed);
+    }
+
+    PipelineLatencyData PipelineLatency::getData() const {
+        PipelineLatencyData ret;
+        for (std::size_t i = 0; i < NUM_PIPELINE_STAGES; ++i) {
+            ret[i] = m_stages[i].getData();
+        }
+        return ret;
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,187 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FramePipeline_h_GUID_4D7B1E92_A3C6_4F08_9B5E_2C81F6D04A73
+#define INCLUDED_FramePipeline_h_GUID_4D7B1E92_A3C6_4F08_9B5E_2C81F6D04A73
+
+// Internal Includes
+#include "ImageProcessing.h"
+
+// Library/third-party includes
+#include <osvr/Util/TimeValue.h>
+#include <opencv2/core/core.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+
+namespace osvr {
+namespace vbtracker {
+    using PipelineClock = std::chrono::steady_clock;
+
+    /// A video frame making its way from the camera through blob extraction
+    /// to pose estimation, along with when it reached each stage.
+    struct PipelineFrame {
+        /// Our best guess as to when the image was taken.
+        util::time::TimeValue tv;
+        cv::Mat frame;
+        cv::Mat frameGray;
+        ImageOutputDataPtr imageData;
+
+        /// @name Stage timestamps
+        /// @{
+        PipelineClock::time_point grabbed;
+        PipelineClock::time_point retrieved;
+        PipelineClock::time_point extractionBegin;
+        PipelineClock::time_point extracted;
+        /// @}
+    };
+
+    /// A bounded, lock-free, single-producer single-consumer queue of frames
+    /// between pipeline stages. Frames themselves are never allocated or freed
+    /// in the pipeline: a fixed set is passed around by pointer.
+    using PipelineFrameQueue = boost::lockfree::spsc_queue<PipelineFrame *>;
+
+    /// Lets the single consumer of one or more lock-free queues sleep until
+    /// there's something for it, without the producers taking a lock unless
+    /// the consumer is actually asleep.
+    class PipelineWakeup : boost::noncopyable {
+      public:
+        /// Producer side: call after making something available.
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_waiting.load(std::memory_order_relaxed)) {
+                {
+                    /// Can't get in between the consumer checking its
+                    /// predicate and going to sleep.
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                }
+                m_cv.notify_one();
+            }
+        }
+
+        /// Consumer side: returns once pred() is true.
+        template <typename F> void wait(F &&pred) {
+            if (pred()) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_cv.wait(lock, pred);
+            m_waiting.store(false, std::memory_order_relaxed);
+        }
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::atomic<bool> m_waiting{false};
+    };
+
+    /// The intervals in a frame's trip through the pipeline that we keep
+    /// latency histograms of.
+    enum class PipelineStage {
+        /// From the camera grab returning to the image being retrieved.
+        Retrieve,
+        /// Waiting for the blob extraction worker.
+        ExtractionWait,
+        /// Blob extraction (initial image processing).
+        Extraction,
+        /// Waiting for the pose estimation thread.
+        EstimationWait,
+        /// Updating LEDs and pose estimates, and publishing reports.
+        Estimation,
+        /// The whole trip, from the camera grab returning to reports being
+        /// published.
+        Total
+    };
+    static const std::size_t NUM_PIPELINE_STAGES = 6;
+
+    /// Gets a human-readable name for the stage.
+    const char *getPipelineStageName(PipelineStage stage);
+
+    /// A snapshot of a LatencyHistogram.
+    struct LatencyHistogramData {
+        static const std::size_t NUM_BUCKETS = 12;
+        /// Upper bound, in milliseconds, of each bucket but the last, which
+        /// is open-ended. Each is twice the previous.
+        static double getBucketLimit(std::size_t bucket);
+
+        std::array<std::uint64_t, NUM_BUCKETS> buckets;
+        std::uint64_t count = 0;
+        double totalMilliseconds = 0;
+        double maxMilliseconds = 0;
+    };
+
+    /// Prints the count, mean, max and non-empty buckets on one line.
+    std::ostream &operator<<(std::ostream &os,
+                             LatencyHistogramData const &data);
+
+    /// A log-scale histogram of durations, recorded by one thread and
+    /// readable from any.
+    class LatencyHistogram : boost::noncopyable {
+      public:
+        LatencyHistogram();
+        void record(PipelineClock::duration latency);
+        LatencyHistogramData getData() const;
+
+      private:
+        using Counter = std::atomic<std::uint64_t>;
+        std::array<Counter, LatencyHistogramData::NUM_BUCKETS> m_buckets;
+        std::atomic<std::uint64_t> m_count;
+        /// In microseconds, to keep these integers.
+        std::atomic<std::uint64_t> m_totalMicroseconds;
+        std::atomic<std::uint64_t> m_maxMicroseconds;
+    };
+
+    using PipelineLatencyData =
+        std::array<LatencyHistogramData, NUM_PIPELINE_STAGES>;
+
+    /// Latency histograms for each pipeline stage.
+    class PipelineLatency : boost::noncopyable {
+      public:
+        LatencyHistogram &operator[](PipelineStage stage) {
+            return m_stages[static_cast<std::size_t>(stage)];
+        }
+        /// Records the latencies of a frame that has finished estimation.
+        void recordFrame(PipelineFrame const &frame,
+                         PipelineClock::time_point estimationBegin,
+                         PipelineClock::time_point estimated);
+        PipelineLatencyData getData() const;
+
+      private:
+        std::array<LatencyHistogram, NUM_PIPELINE_STAGES> m_stages;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_FramePipeline_h_GUID_4D7B1E92_A3C6_4F08_9B5E_2C81F6D04A73
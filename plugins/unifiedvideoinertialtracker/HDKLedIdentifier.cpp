@@ -25,20 +25,23 @@
 // Internal Includes
 #include "LED.h"
 #include "HDKLedIdentifier.h"
-#include "IdentifierHelpers.h"
 
 // Library/third-party includes
 // - none
 
 // Standard includes
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 namespace osvr {
 namespace vbtracker {
     static const auto VALIDCHARS = "*.";
+    const OsvrHdkLedIdentifier::TableEntry OsvrHdkLedIdentifier::NO_MATCH;
+    const OsvrHdkLedIdentifier::TableEntry OsvrHdkLedIdentifier::AMBIGUOUS;
     OsvrHdkLedIdentifier::~OsvrHdkLedIdentifier() {}
-    // Convert from string encoding representations into lists
-    // of boolean values for use in comparison.
+    // Convert from string encoding representations into a table of every
+    // rotation of every pattern, encoded as bits, for lookup.
     OsvrHdkLedIdentifier::OsvrHdkLedIdentifier(
         const PatternStringList &PATTERNS) {
         // Ensure that we have at least one entry in our list and
@@ -62,13 +65,24 @@ namespace vbtracker {
             return;
         }
 
-        // Decode each string into a new list of boolean values, making
-        // sure each have the correct length.
+        if (d_length > BrightnessHistory::CAPACITY) {
+            throw std::runtime_error("Got a pattern longer than the "
+                                     "brightness history can hold!");
+        }
+        if (PATTERNS.size() >
+            std::size_t(std::numeric_limits<TableEntry>::max())) {
+            throw std::runtime_error("Got too many patterns!");
+        }
+        if (d_length <= MAX_DIRECT_TABLE_LENGTH) {
+            d_table.assign(std::size_t(1) << d_length, NO_MATCH);
+        }
 
-        for (auto &pat : PATTERNS) {
+        const Code mask =
+            d_length == 32 ? ~Code(0) : ((Code(1) << d_length) - 1);
+        for (size_t i = 0; i < PATTERNS.size(); i++) {
+            auto &pat = PATTERNS[i];
             if (pat.empty() || pat.find_first_not_of(VALIDCHARS) != pat.npos) {
                 // This is an intentionally disabled beacon/pattern.
-                d_patterns.emplace_back();
                 continue;
             }
 
@@ -77,37 +91,72 @@ namespace vbtracker {
                 throw std::runtime_error("Got a pattern of incorrect length!");
             }
 
-            // Make a wrapped pattern, which is the original pattern plus
-            // a second copy of the pattern that has all but the last
-            // character in it.  This will enable use to use the string
-            // find() routine to see if any shift of the pattern is a
-            // match.
-            auto wrapped = pat + pat;
-            wrapped.pop_back();
-            d_patterns.push_back(std::move(wrapped));
+            // Encode the pattern with the first (oldest) element in the most
+            // significant bit, the same way getId() encodes brightnesses.
+            Code code = 0;
+            for (auto c : pat) {
+                code = (code << 1) | (c == '*' ? 1 : 0);
+            }
+
+            // Add every rotation of the pattern, since we don't know when the
+            // code started. For the HDK, the codes are rotationally invariant.
+            addCode(code, TableEntry(i));
+            for (size_t r = 1; r < d_length; ++r) {
+                addCode(((code << r) | (code >> (d_length - r))) & mask,
+                        TableEntry(i));
+            }
         }
     }
 
+    void OsvrHdkLedIdentifier::addCode(Code code, TableEntry id) {
+        TableEntry *entry = nullptr;
+        if (d_table.empty()) {
+            entry = &(d_longTable.emplace(code, NO_MATCH).first->second);
+        } else {
+            entry = &(d_table[code]);
+        }
+        if (*entry == NO_MATCH) {
+            *entry = id;
+        } else if (*entry != id && *entry != AMBIGUOUS) {
+            *entry = AMBIGUOUS;
+            ++d_ambiguousCodes;
+        }
+    }
+
+    OsvrHdkLedIdentifier::TableEntry
+    OsvrHdkLedIdentifier::lookup(Code code) const {
+        if (!d_table.empty()) {
+            return d_table[code];
+        }
+        auto it = d_longTable.find(code);
+        return it == end(d_longTable) ? NO_MATCH : it->second;
+    }
+
     ZeroBasedBeaconId
     OsvrHdkLedIdentifier::getId(ZeroBasedBeaconId currentId,
-                                std::list<float> &brightnesses,
+                                BrightnessHistory const &brightnesses,
                                 bool &lastBright, bool blobsKeepId) const {
         // If we don't have at least the required number of frames of data, we
         // don't know anything.
-        if (brightnesses.size() < d_length) {
+        if (0 == d_length || brightnesses.size() < d_length) {
             return ZeroBasedBeaconId(
                 Led::SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
         }
 
         // We only care about the d_length most-recent levels.
-        truncateBrightnessListTo(brightnesses, d_length);
+        const auto first = brightnesses.size() - d_length;
+        const auto last = brightnesses.size();
 
         // Compute the minimum and maximum brightness values.  If
         // they are too close to each other, we have a light rather
         // than an LED.  If not, compute a threshold to separate the
         // 0's and 1's.
-        Brightness minVal, maxVal;
-        std::tie(minVal, maxVal) = findMinMaxBrightness(brightnesses);
+        Brightness minVal = brightnesses[first];
+        Brightness maxVal = minVal;
+        for (auto i = first + 1; i < last; ++i) {
+            minVal = std::min(minVal, brightnesses[i]);
+            maxVal = std::max(maxVal, brightnesses[i]);
+        }
         // Brightness is currently actually keypoint diameter (radius?) in
         // pixels, and it's being under-estimated by OpenCV.
         static const double TODO_MIN_BRIGHTNESS_DIFF = 0.3;
@@ -124,29 +173,20 @@ namespace vbtracker {
             return currentId;
         }
 
-        // Get a list of boolean values for 0's and 1's using
-        // the threshold computed above.
-        auto bits = getBitsUsingThreshold(brightnesses, threshold);
-
-        // Search through the available patterns to see if the passed-in
-        // pattern matches any of them.  If so, return that pattern.  We
-        // need to check all potential rotations of the pattern, since we
-        // don't know when the code started.  For the HDK, the codes are
-        // rotationally invariant.  We do this by making wrapped strings
-        // and seeing if the pattern shows up anywhe in them, relying on
-        // the std::string find method to do efficiently.
-        for (size_t i = 0; i < d_patterns.size(); i++) {
-            if (d_patterns[i].empty()) {
-                /// Skip turned-off patterns.
-                continue;
-            }
-            if (d_patterns[i].find(bits) != std::string::npos) {
-                return ZeroBasedBeaconId(i);
-            }
+        // Threshold into bits, oldest in the most significant bit, and look
+        // up which pattern (if any) has that as one of its rotations.
+        Code code = 0;
+        for (auto i = first; i < last; ++i) {
+            code = (code << 1) | (brightnesses[i] >= threshold ? 1 : 0);
+        }
+        auto id = lookup(code);
+        if (id >= 0) {
+            return ZeroBasedBeaconId(id);
         }
 
-        // No pattern recognized and we should have recognized one, so return
-        // a low negative.  We've used -2 so return -3.
+        // No pattern recognized (or only ambiguously) and we should have
+        // recognized one, so return a low negative.  We've used -2 so return
+        // -3.
         return ZeroBasedBeaconId(
             Led::SENTINEL_NO_PATTERN_RECOGNIZED_DESPITE_SUFFICIENT_DATA);
     }
@@ -32,7 +32,10 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -42,22 +45,43 @@ namespace vbtracker {
         /// @brief Give it a list of patterns to use.  There is a string for
         /// each LED, and each is encoded with '*' meaning that the LED is
         /// bright and '.' that it is dim at this point in time. All patterns
-        /// must have the same length.
+        /// must have the same length, at most BrightnessHistory::CAPACITY.
         OsvrHdkLedIdentifier(const PatternStringList &PATTERNS);
 
         ~OsvrHdkLedIdentifier() override;
 
-        /// @brief Determine an ID based on a list of brightnesses
-        /// This truncates the passed-in list to only as many elements
-        /// as are in the pattern list, to keep it from growing too
-        /// large and wasting time and space.
+        /// @brief Determine an ID based on a history of brightnesses, using
+        /// only as many of the most recent as there are in a pattern.
         ZeroBasedBeaconId getId(ZeroBasedBeaconId currentId,
-                                BrightnessList &brightnesses, bool &lastBright,
+                                BrightnessHistory const &brightnesses,
+                                bool &lastBright,
                                 bool blobsKeepId) const override;
 
+        /// @brief The number of distinct bit sequences that are a rotation of
+        /// more than one pattern: these are never identified as any beacon.
+        std::size_t getNumAmbiguousCodes() const { return d_ambiguousCodes; }
+
       private:
-        size_t d_length;        //< Length of all patterns
-        PatternList d_patterns; //< Patterns by index
+        using Code = std::uint32_t;
+        using TableEntry = std::int16_t;
+        /// Table entry for a code that is not a rotation of any pattern.
+        static const TableEntry NO_MATCH = -1;
+        /// Table entry for a code that is a rotation of several patterns.
+        static const TableEntry AMBIGUOUS = -2;
+        /// Patterns up to this long are looked up in a directly-indexed
+        /// table: longer ones use a hash table.
+        static const std::size_t MAX_DIRECT_TABLE_LENGTH = 16;
+
+        void addCode(Code code, TableEntry id);
+        TableEntry lookup(Code code) const;
+
+        size_t d_length; //< Length of all patterns
+        /// Every rotation of every pattern, indexed by code: used when
+        /// d_length <= MAX_DIRECT_TABLE_LENGTH
+        std::vector<TableEntry> d_table;
+        /// Every rotation of every pattern: used for longer patterns.
+        std::unordered_map<Code, TableEntry> d_longTable;
+        std::size_t d_ambiguousCodes = 0;
     };
 
 } // End namespace vbtracker
@@ -32,6 +32,7 @@
 #include <osvr/Util/TimeValue.h>
 
 // Standard includes
+#include <algorithm>
 #include <deque>
 #include <stdexcept>
 #include <iterator>
@@ -78,10 +79,12 @@ namespace vbtracker {
             /// Convenience class to refer to a subset of the range of history,
             /// primarily for use in range-for loops. Note that all iterators
             /// are const iterators.
-            template <typename ValueType> class HistorySubsetRange {
+            template <typename ValueType,
+                      typename Iterator = detail::iterator<ValueType>>
+            class HistorySubsetRange {
               public:
-                using iterator = detail::iterator<ValueType>;
-                using const_iterator = detail::iterator<ValueType>;
+                using iterator = Iterator;
+                using const_iterator = Iterator;
                 HistorySubsetRange(iterator begin_, iterator end_)
                     : m_begin(begin_), m_end(end_) {
                     /// @todo consistency checks on the iterators...
@@ -141,7 +144,7 @@ namespace vbtracker {
                     throw std::logic_error("Can't get oldest entry in an "
                                            "empty history container!");
                 }
-                return m_history.front().first;
+                return m_history.front().second;
             }
 
             /// Returns the newest timestamp in the container. Caveat: throws an
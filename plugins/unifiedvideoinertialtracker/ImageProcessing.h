@@ -35,6 +35,7 @@
 
 // Standard includes
 #include <memory>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -46,6 +47,14 @@ namespace vbtracker {
         CameraParameters camParams;
     };
     using ImageOutputDataPtr = std::unique_ptr<ImageProcessingOutput>;
+
+    /// A circle, in undistorted image coordinates, where a blob is expected
+    /// in the next frame.
+    struct PredictedBlobRegion {
+        cv::Point2d center;
+        double radius;
+    };
+    using PredictedBlobRegions = std::vector<PredictedBlobRegion>;
 } // namespace vbtracker
 } // namespace osvr
 #endif // INCLUDED_ImageProcessing_h_GUID_3E426FCE_BED1_4DAC_0669_70D55A14A507
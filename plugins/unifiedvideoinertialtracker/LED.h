@@ -156,8 +156,8 @@ namespace vbtracker {
         /// Most recent measurement
         LedMeasurement m_latestMeasurement;
 
-        /// Starting from current frame going backwards
-        BrightnessList m_brightnessHistory;
+        /// Most recent brightnesses, oldest first.
+        BrightnessHistory m_brightnessHistory;
 
         /// @brief Which LED am I? Non-negative are indices, negative are
         /// sentinels
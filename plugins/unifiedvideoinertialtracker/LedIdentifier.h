@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "BeaconIdTypes.h"
+#include "BrightnessHistory.h"
 #include "Types.h"
 
 // Library/third-party includes
@@ -43,10 +44,6 @@ namespace vbtracker {
     /// derived classes encode the pattern-detection algorithm for specific
     /// devices.
     ///
-    /// NOTE: This class may modify the passed-in list, truncating it so that
-    /// old data points are removed once there are enough measurements to make
-    /// an estimate.
-    ///
     /// @todo Consider adding a distance estimator as a parameter throughout,
     /// which can be left alone for unknown or estimated based on a Kalman
     /// filter; it would be used to scale the expected brightness.
@@ -56,9 +53,8 @@ namespace vbtracker {
         virtual ~LedIdentifier();
         /// @brief Determine the identity of the LED whose brightness pattern is
         /// passed in.
-        /// Truncates the passed-in list to the length needed to look for a
-        /// pattern, so it does not grow too long and waste space and time,
-        /// and perhaps produce spurious Ids.
+        /// Only the most recent measurements, as many as needed to look for a
+        /// pattern, are considered.
         /// @param[out] lastBright set to True if we determine that the LED is
         /// currently "bright"
         /// @return -1 for unknown (not enough information) and
@@ -66,7 +62,7 @@ namespace vbtracker {
         /// constant, mis-tracked LEDs may produce spurious changes in the
         /// pattern for example).
         virtual ZeroBasedBeaconId getId(ZeroBasedBeaconId currentId,
-                                        BrightnessList &brightnesses,
+                                        BrightnessHistory const &brightnesses,
                                         bool &lastBright,
                                         bool blobsKeepId) const = 0;
 
@@ -0,0 +1,124 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ParallelTaskPool.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace vbtracker {
+    ParallelTaskPool::ParallelTaskPool(std::size_t numThreads) {
+        for (std::size_t i = 1; i < numThreads; ++i) {
+            m_workers.emplace_back([&] { workerMain(); });
+        }
+    }
+
+    ParallelTaskPool::~ParallelTaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_startCv.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void ParallelTaskPool::runParallel(std::size_t numTasks,
+                                       TaskFunction const &f) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &f;
+            m_numTasks = numTasks;
+            m_nextTask.store(0);
+            m_error = nullptr;
+            m_busyWorkers = m_workers.size();
+            ++m_generation;
+        }
+        m_startCv.notify_all();
+
+        /// Pitch in rather than just waiting.
+        runTasks();
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCv.wait(lock, [&] { return m_busyWorkers == 0; });
+            m_task = nullptr;
+            std::swap(error, m_error);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ParallelTaskPool::workerMain() {
+        std::size_t lastGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_startCv.wait(lock, [&] {
+                    return m_stop || m_generation != lastGeneration;
+                });
+                if (m_stop) {
+                    return;
+                }
+                lastGeneration = m_generation;
+            }
+
+            runTasks();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_busyWorkers == 0) {
+                    m_doneCv.notify_one();
+                }
+            }
+        }
+    }
+
+    void ParallelTaskPool::runTasks() {
+        while (true) {
+            auto i = m_nextTask.fetch_add(1);
+            if (i >= m_numTasks) {
+                return;
+            }
+            try {
+                (*m_task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+    }
+
+} // namespace vbtracker
+} // namespace osvr
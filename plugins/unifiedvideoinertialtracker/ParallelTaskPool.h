@@ -0,0 +1,110 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ParallelTaskPool_h_GUID_6B3F0A27_D85C_4E91_A4F2_7C19E0B5D836
+#define INCLUDED_ParallelTaskPool_h_GUID_6B3F0A27_D85C_4E91_A4F2_7C19E0B5D836
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// A small, persistent set of worker threads for running a handful of
+    /// independent tasks (one per body or target, say) at once, each frame,
+    /// without the cost of starting threads every time.
+    ///
+    /// Tasks aren't assigned up front: the workers and the calling thread all
+    /// claim the next unstarted task as soon as they finish one, so a slow
+    /// task (a RANSAC fallback, for instance) doesn't hold up the rest.
+    class ParallelTaskPool : boost::noncopyable {
+      public:
+        /// @param numThreads The number of threads to run tasks on, including
+        /// the calling thread. 1 or less means to just run them serially on
+        /// the calling thread.
+        explicit ParallelTaskPool(std::size_t numThreads);
+        ~ParallelTaskPool();
+
+        /// Total number of threads tasks may run on, including the caller.
+        std::size_t getNumThreads() const { return m_workers.size() + 1; }
+
+        /// Calls f(i) for each i in [0, numTasks), possibly concurrently, and
+        /// returns once all have finished. If any throw, one of the exceptions
+        /// is rethrown once they're all done.
+        ///
+        /// Calls to run() must not overlap.
+        template <typename F> void run(std::size_t numTasks, F &&f) {
+            if (m_workers.empty() || numTasks < 2) {
+                for (std::size_t i = 0; i < numTasks; ++i) {
+                    f(i);
+                }
+                return;
+            }
+            runParallel(numTasks, TaskFunction(std::ref(f)));
+        }
+
+      private:
+        using TaskFunction = std::function<void(std::size_t)>;
+        void runParallel(std::size_t numTasks, TaskFunction const &f);
+        void workerMain();
+        /// Runs tasks until there are no more to claim.
+        void runTasks();
+
+        std::vector<std::thread> m_workers;
+
+        /// @name Shared with the workers
+        /// @brief Protected by m_mutex, except for m_nextTask. m_task and
+        /// m_numTasks are only modified while no workers are busy.
+        /// @{
+        std::mutex m_mutex;
+        std::condition_variable m_startCv;
+        std::condition_variable m_doneCv;
+        TaskFunction const *m_task = nullptr;
+        std::size_t m_numTasks = 0;
+        std::atomic<std::size_t> m_nextTask{0};
+        /// Incremented to start the workers on a new run.
+        std::size_t m_generation = 0;
+        /// Workers that haven't yet finished the current run.
+        std::size_t m_busyWorkers = 0;
+        std::exception_ptr m_error;
+        bool m_stop = false;
+        /// @}
+    };
+
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_ParallelTaskPool_h_GUID_6B3F0A27_D85C_4E91_A4F2_7C19E0B5D836
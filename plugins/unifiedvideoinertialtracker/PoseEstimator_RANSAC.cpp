@@ -34,15 +34,72 @@
 
 // Standard includes
 #include <algorithm>
+#include <cmath>
 
 namespace osvr {
 namespace vbtracker {
+#if CV_MAJOR_VERSION == 2
+    static const int PNP_MINIMAL_SOLVER = cv::P3P;
+    static const int PNP_REFINEMENT_SOLVER = cv::ITERATIVE;
+#elif CV_MAJOR_VERSION == 3
+    static const int PNP_MINIMAL_SOLVER = cv::SOLVEPNP_P3P;
+    static const int PNP_REFINEMENT_SOLVER = cv::SOLVEPNP_ITERATIVE;
+#else
+#error "Unrecognized OpenCV version!"
+#endif
+    /// The P3P solver takes exactly this many points: three for the solution
+    /// and one to pick among the candidates.
+    static const std::size_t MINIMAL_SAMPLE_SIZE = 4;
+
+    /// Wraps up the differences in solvePnP between OpenCV versions.
+    static bool solvePnPWith(std::vector<cv::Point3f> const &objectPoints,
+                             std::vector<cv::Point2f> const &imagePoints,
+                             CameraParameters const &camParams, cv::Mat &rvec,
+                             cv::Mat &tvec, bool useExtrinsicGuess, int flags) {
+#if CV_MAJOR_VERSION == 2
+        cv::solvePnP(objectPoints, imagePoints, camParams.cameraMatrix,
+                     camParams.distortionParameters, rvec, tvec,
+                     useExtrinsicGuess, flags);
+        return true;
+#else
+        return cv::solvePnP(objectPoints, imagePoints, camParams.cameraMatrix,
+                            camParams.distortionParameters, rvec, tvec,
+                            useExtrinsicGuess, flags);
+#endif
+    }
+
+    RANSACPoseEstimator::RANSACPoseEstimator(ConfigParams const &params)
+        : m_iterations(std::max(params.ransacIterations, 0)),
+          m_reacquireIterations(std::max(params.ransacReacquireIterations, 0)),
+          m_earlyExitInlierRatio(params.ransacEarlyExitInlierRatio),
+          m_inlierThreshold(params.ransacInlierThreshold) {}
+
+    void RANSACPoseEstimator::findInliers(CameraParameters const &camParams,
+                                          cv::Mat const &rvec,
+                                          cv::Mat const &tvec) {
+        m_candidateInliers.clear();
+        /// Nothing sensible can be behind the camera.
+        if (tvec.at<double>(2) <= 0) {
+            return;
+        }
+        cv::projectPoints(m_objectPoints, rvec, tvec, camParams.cameraMatrix,
+                          camParams.distortionParameters, m_reprojectedPoints);
+        auto thresholdSquared = m_inlierThreshold * m_inlierThreshold;
+        for (std::size_t i = 0; i < m_objectPoints.size(); ++i) {
+            auto diff = m_reprojectedPoints[i] - m_imagePoints[i];
+            if (diff.dot(diff) <= thresholdSquared) {
+                m_candidateInliers.push_back(i);
+            }
+        }
+    }
+
     bool RANSACPoseEstimator::operator()(CameraParameters const &camParams,
                                          LedPtrList const &leds,
                                          BeaconStateVec const &beacons,
                                          std::vector<BeaconData> &beaconDebug,
                                          Eigen::Vector3d &outXlate,
-                                         Eigen::Quaterniond &outQuat) {
+                                         Eigen::Quaterniond &outQuat,
+                                         bool seeded) {
 
         // We need to get a pair of matched vectors of points: 2D locations
         // with in the image and 3D locations in model space.  There needs to
@@ -51,9 +108,12 @@ namespace vbtracker {
         // make these by looking up the locations of LEDs with known identifiers
         // and pushing both onto the vectors at the same time.
 
-        std::vector<cv::Point3f> objectPoints;
-        std::vector<cv::Point2f> imagePoints;
-        std::vector<ZeroBasedBeaconId> beaconIds;
+        auto &objectPoints = m_objectPoints;
+        auto &imagePoints = m_imagePoints;
+        auto &beaconIds = m_beaconIds;
+        objectPoints.clear();
+        imagePoints.clear();
+        beaconIds.clear();
         for (auto const &led : leds) {
             auto id = makeZeroBased(led->getID());
             auto index = asIndex(id);
@@ -69,53 +129,106 @@ namespace vbtracker {
         }
 
         // Make sure we have enough points to do our estimation.
-        if (objectPoints.size() < m_permittedOutliers + m_requiredInliers) {
+        auto numPoints = objectPoints.size();
+        if (numPoints < m_permittedOutliers + m_requiredInliers ||
+            numPoints < MINIMAL_SAMPLE_SIZE) {
             return false;
         }
+        ++m_stats.attempts;
 
-        // Produce an estimate of the translation and rotation needed to take
-        // points from model space into camera space.  We allow for at most
-        // m_permittedOutliers outliers. Even in simulation data, we sometimes
+        // We allow for outliers, since even in simulation data we sometimes
         // find duplicate IDs for LEDs, indicating that we are getting
-        // mis-identified ones sometimes.
-        // We tried using the previous guess to reduce the amount of computation
-        // being done, but this got us stuck in infinite locations.  We seem to
-        // do okay without using it, so leaving it out.
-        // @todo Make number of iterations into a parameter.
-        bool usePreviousGuess = false;
-        int iterationsCount = 5;
-        cv::Mat inlierIndices;
-
-        cv::Mat rvec;
-        cv::Mat tvec;
-#if CV_MAJOR_VERSION == 2
-        cv::solvePnPRansac(
-            objectPoints, imagePoints, camParams.cameraMatrix,
-            camParams.distortionParameters, rvec, tvec, usePreviousGuess,
-            iterationsCount, 8.0f,
-            static_cast<int>(objectPoints.size() - m_permittedOutliers),
-            inlierIndices);
-#elif CV_MAJOR_VERSION == 3
-        // parameter added to the OpenCV 3.0 interface in place of the number of
-        // inliers
-        /// @todo how to determine this requested confidence from the data we're
-        /// given?
-        double confidence = 0.99;
-        auto ransacResult = cv::solvePnPRansac(
-            objectPoints, imagePoints, camParams.cameraMatrix,
-            camParams.distortionParameters, rvec, tvec, usePreviousGuess,
-            iterationsCount, 8.0f, confidence, inlierIndices);
-        if (!ransacResult) {
-            return false;
+        // mis-identified ones sometimes. Once a hypothesis explains this many
+        // of the beacons, we stop looking for a better one.
+        auto earlyExitInliers = std::max(
+            m_requiredInliers,
+            static_cast<std::size_t>(std::ceil(
+                m_earlyExitInlierRatio * static_cast<double>(numPoints))));
+        auto &bestInliers = m_bestInliers;
+        bestInliers.clear();
+        cv::Mat bestRvec;
+        cv::Mat bestTvec;
+
+        // Start from the guess, if we have one: often, right after a brief
+        // occlusion, it's already close enough to need nothing but the
+        // refinement.
+        if (seeded) {
+            ++m_stats.seeded;
+            cv::Mat rvec = eiQuatToRotVec(outQuat);
+            cv::Mat tvec =
+                (cv::Mat_<double>(3, 1) << outXlate.x(), outXlate.y(),
+                 outXlate.z());
+            findInliers(camParams, rvec, tvec);
+            if (m_candidateInliers.size() >= m_requiredInliers) {
+                std::swap(bestInliers, m_candidateInliers);
+                bestRvec = rvec;
+                bestTvec = tvec;
+            }
+        }
+        if (bestInliers.size() >= earlyExitInliers) {
+            ++m_stats.seedEarlyExits;
+        }
+
+        // Then hypotheses from minimal samples, drawn by partially shuffling
+        // the point indices.
+        auto &sampleOrder = m_sampleOrder;
+        sampleOrder.resize(numPoints);
+        for (std::size_t i = 0; i < numPoints; ++i) {
+            sampleOrder[i] = i;
+        }
+        std::vector<cv::Point3f> sampleObjectPoints(MINIMAL_SAMPLE_SIZE);
+        std::vector<cv::Point2f> sampleImagePoints(MINIMAL_SAMPLE_SIZE);
+        auto iterations = seeded ? m_reacquireIterations : m_iterations;
+        for (int iter = 0;
+             iter < iterations && bestInliers.size() < earlyExitInliers;
+             ++iter) {
+            for (std::size_t i = 0; i < MINIMAL_SAMPLE_SIZE; ++i) {
+                auto j = std::uniform_int_distribution<std::size_t>(
+                    i, numPoints - 1)(m_rng);
+                std::swap(sampleOrder[i], sampleOrder[j]);
+                sampleObjectPoints[i] = objectPoints[sampleOrder[i]];
+                sampleImagePoints[i] = imagePoints[sampleOrder[i]];
+            }
+            cv::Mat rvec;
+            cv::Mat tvec;
+            if (!solvePnPWith(sampleObjectPoints, sampleImagePoints, camParams,
+                              rvec, tvec, false, PNP_MINIMAL_SOLVER)) {
+                continue;
+            }
+            ++m_stats.hypotheses;
+            findInliers(camParams, rvec, tvec);
+            if (m_candidateInliers.size() > bestInliers.size()) {
+                std::swap(bestInliers, m_candidateInliers);
+                bestRvec = rvec;
+                bestTvec = tvec;
+                if (bestInliers.size() >= earlyExitInliers) {
+                    ++m_stats.earlyExits;
+                }
+            }
         }
-#else
-#error "Unrecognized OpenCV version!"
-#endif
 
         //==========================================================================
         // Make sure we got all the inliers we needed.  Otherwise, reject this
         // pose.
-        if (inlierIndices.rows < static_cast<int>(m_requiredInliers)) {
+        if (bestInliers.size() < m_requiredInliers) {
+            return false;
+        }
+
+        //==========================================================================
+        // Refine the best hypothesis with all of its inliers: the only
+        // non-minimal solve we do.
+        std::vector<cv::Point3f> inlierObjectPoints;
+        std::vector<cv::Point2f> inlierImagePoints;
+        std::vector<ZeroBasedBeaconId> inlierBeaconIds;
+        for (auto i : bestInliers) {
+            inlierObjectPoints.push_back(objectPoints[i]);
+            inlierImagePoints.push_back(imagePoints[i]);
+            inlierBeaconIds.push_back(beaconIds[i]);
+        }
+        cv::Mat rvec = bestRvec.clone();
+        cv::Mat tvec = bestTvec.clone();
+        if (!solvePnPWith(inlierObjectPoints, inlierImagePoints, camParams,
+                          rvec, tvec, true, PNP_REFINEMENT_SOLVER)) {
             return false;
         }
 
@@ -123,26 +236,18 @@ namespace vbtracker {
         // Reproject the inliers into the image and make sure they are actually
         // close to the expected location; otherwise, we have a bad pose.
         const double pixelReprojectionErrorForSingleAxisMax = 4;
-        if (inlierIndices.rows > 0) {
-            std::vector<cv::Point3f> inlierObjectPoints;
-            std::vector<cv::Point2f> inlierImagePoints;
-            std::vector<ZeroBasedBeaconId> inlierBeaconIds;
-            for (int i = 0; i < inlierIndices.rows; i++) {
-                inlierObjectPoints.push_back(objectPoints[i]);
-                inlierImagePoints.push_back(imagePoints[i]);
-                inlierBeaconIds.push_back(beaconIds[i]);
-            }
-            std::vector<cv::Point2f> reprojectedPoints;
+        {
+            auto &reprojectedPoints = m_reprojectedPoints;
             cv::projectPoints(
                 inlierObjectPoints, rvec, tvec, camParams.cameraMatrix,
                 camParams.distortionParameters, reprojectedPoints);
 
             for (size_t i = 0; i < reprojectedPoints.size(); i++) {
-                if (reprojectedPoints[i].x - inlierImagePoints[i].x >
+                if (std::abs(reprojectedPoints[i].x - inlierImagePoints[i].x) >
                     pixelReprojectionErrorForSingleAxisMax) {
                     return false;
                 }
-                if (reprojectedPoints[i].y - inlierImagePoints[i].y >
+                if (std::abs(reprojectedPoints[i].y - inlierImagePoints[i].y) >
                     pixelReprojectionErrorForSingleAxisMax) {
                     return false;
                 }
@@ -172,6 +277,7 @@ namespace vbtracker {
                 }
             }
         }
+        ++m_stats.successes;
 
         //==========================================================================
         // Convert this into an OSVR representation of the transformation that
@@ -217,13 +323,13 @@ namespace vbtracker {
         InitialVelocityStateError,    InitialAngVelStateError,
         InitialAngVelStateError,      InitialAngVelStateError};
     bool RANSACPoseEstimator::operator()(EstimatorInOutParams const &p,
-                                         LedPtrList const &leds) {
-        Eigen::Vector3d xlate;
-        Eigen::Quaterniond quat;
+                                         LedPtrList const &leds, bool seeded) {
+        Eigen::Vector3d xlate = p.state.position();
+        Eigen::Quaterniond quat = p.state.getCombinedQuaternion();
         /// Call the main pose estimation to get the vector and quat.
         {
             auto ret = (*this)(p.camParams, leds, p.beacons, p.beaconDebug,
-                               xlate, quat);
+                               xlate, quat, seeded);
             if (!ret) {
                 return false;
             }
@@ -30,36 +30,80 @@
 #include "PoseEstimatorTypes.h"
 
 // Library/third-party includes
-// - none
+#include <opencv2/core/core.hpp>
 
 // Standard includes
 #include <cstddef>
+#include <random>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
     class RANSACPoseEstimator {
       public:
+        RANSACPoseEstimator() : RANSACPoseEstimator(ConfigParams{}) {}
+        explicit RANSACPoseEstimator(ConfigParams const &params);
+
         /// Perform RANSAC-based pose estimation.
         ///
-        /// @param[out] outXlate translation output parameter
-        /// @param[out] outQuat rotation output parameter
+        /// Hypotheses come from P3P on minimal samples of the beacons, until
+        /// one agrees with enough of them (ransacEarlyExitInlierRatio) or the
+        /// iteration budget runs out. The best is then refined, once, using
+        /// all the beacons that agree with it.
+        ///
+        /// @param[in,out] outXlate translation output parameter: if seeded,
+        /// also the initial guess.
+        /// @param[in,out] outQuat rotation output parameter: if seeded, also
+        /// the initial guess.
+        /// @param seeded Whether outXlate and outQuat hold a guess (like the
+        /// last known pose) worth trying before sampling, in which case the
+        /// larger ransacReacquireIterations budget applies.
         /// @return true if a pose was estimated.
         bool operator()(CameraParameters const &camParams,
                         LedPtrList const &leds, BeaconStateVec const &beacons,
                         std::vector<BeaconData> &beaconDebug,
-                        Eigen::Vector3d &outXlate, Eigen::Quaterniond &outQuat);
+                        Eigen::Vector3d &outXlate, Eigen::Quaterniond &outQuat,
+                        bool seeded = false);
 
         /// Perform RANSAC-based pose estimation and use it to update a body
         /// state (state vector and error covariance)
         ///
         /// @param[out] state Tracked body state that will be updated if a pose
         /// was estimated
+        /// @param seeded Whether to use the incoming state's pose as the
+        /// initial guess.
         /// @return true if a pose was estimated.
-        bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds);
+        bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
+                        bool seeded = false);
+
+        ReacquisitionStats const &getStats() const { return m_stats; }
 
       private:
+        /// Fills m_candidateInliers with the indices of the points that
+        /// reproject within the inlier threshold with the given pose.
+        void findInliers(CameraParameters const &camParams,
+                         cv::Mat const &rvec, cv::Mat const &tvec);
+
         const std::size_t m_requiredInliers = 4;
         const std::size_t m_permittedOutliers = 0;
+        const int m_iterations;
+        const int m_reacquireIterations;
+        const double m_earlyExitInlierRatio;
+        const double m_inlierThreshold;
+        std::mt19937 m_rng;
+        ReacquisitionStats m_stats;
+
+        /// @name Per-call scratch space
+        /// @brief Kept around just to avoid reallocating it each frame.
+        /// @{
+        std::vector<cv::Point3f> m_objectPoints;
+        std::vector<cv::Point2f> m_imagePoints;
+        std::vector<ZeroBasedBeaconId> m_beaconIds;
+        std::vector<cv::Point2f> m_reprojectedPoints;
+        std::vector<std::size_t> m_sampleOrder;
+        std::vector<std::size_t> m_candidateInliers;
+        std::vector<std::size_t> m_bestInliers;
+        /// @}
     };
 } // namespace vbtracker
 } // namespace osvr
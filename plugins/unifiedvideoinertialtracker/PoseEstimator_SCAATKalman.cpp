@@ -48,6 +48,7 @@ inline void dumpKalmanDebugOuput(const char name[], const char expr[],
 
 // Library/third-party includes
 #include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/FlexibleKalmanBatchCorrection.h>
 #include <osvr/Kalman/AugmentedProcessModel.h>
 #include <osvr/Kalman/AugmentedState.h>
 #include <osvr/Kalman/ConstantProcess.h>
@@ -77,6 +78,8 @@ namespace vbtracker {
           m_measurementVarianceScaleFactor(
               params.measurementVarianceScaleFactor),
           m_extraVerbose(params.extraVerbose),
+          m_batchCorrection(params.batchBeaconCorrection),
+          m_josephForm(params.batchCorrectionJosephForm),
           m_randEngine(
               std::chrono::system_clock::now().time_since_epoch().count()) {
         std::tie(m_minBoxRatio, m_maxBoxRatio) =
@@ -86,6 +89,28 @@ namespace vbtracker {
         const auto maxSquaredResidual = params.maxResidual * params.maxResidual;
     }
 
+    using BodyBatchCorrection = kalman::BatchCorrection<BodyState>;
+
+    /// Adds a beacon measurement to a batch correction of the body state
+    /// alone: rather than correcting the beacon too, its position uncertainty
+    /// is folded into the measurement covariance.
+    ///
+    /// @return false if the measurement was rejected (its covariance wasn't
+    /// positive definite), so it doesn't count as a measurement.
+    inline bool addToBatch(BodyBatchCorrection &batch,
+                           AugmentedStateWithBeacon &state,
+                           ImagePointMeasurement &meas) {
+        static const auto BODY_DIMENSION =
+            kalman::types::Dimension<BodyState>::value;
+        ImagePointMeasurement::Jacobian H = meas.getJacobian(state);
+        Eigen::Matrix<double, 2, 3> beaconH = H.rightCols<3>();
+        ImagePointMeasurement::SquareMatrix R =
+            meas.getCovariance(state) +
+            beaconH * state.b().errorCovariance() * beaconH.transpose();
+        return batch.add(H.leftCols<BODY_DIMENSION>(), meas.getResidual(state),
+                         R);
+    }
+
     inline double xyDistanceFromMetersToPixels(double xyDistance,
                                                double depthInMeters,
                                                CameraModel const &cam) {
@@ -197,6 +222,7 @@ namespace vbtracker {
         ImagePointMeasurement meas{cam, p.targetToBody};
 
         kalman::ConstantProcess<kalman::PureVectorState<>> beaconProcess;
+        BodyBatchCorrection batch;
 
         for (auto &ledPtr : goodLeds) {
             auto &led = *ledPtr;
@@ -222,7 +248,12 @@ namespace vbtracker {
 #endif
             } else {
                 beaconProcess.setNoiseAutocorrelation(m_beaconProcessNoise);
-                kalman::predict(*(p.beacons[index]), beaconProcess, videoDt);
+                if (!m_batchCorrection) {
+                    // Not autocalibrating in batch mode, so no need to
+                    // grow the beacon's uncertainty either.
+                    kalman::predict(*(p.beacons[index]), beaconProcess,
+                                    videoDt);
+                }
             }
 
             /// subtracting from image size to flip signs of x and y, aka 180
@@ -255,10 +286,16 @@ namespace vbtracker {
             debug.variance = effectiveVariance;
             meas.setVariance(effectiveVariance);
 
-            /// Now, do the correction.
-            auto model = kalman::makeAugmentedProcessModel(p.processModel,
-                                                           beaconProcess);
-            kalman::correct(state, model, meas);
+            /// Now, do the correction - or save it for later.
+            if (m_batchCorrection) {
+                if (!addToBatch(batch, state, meas)) {
+                    continue;
+                }
+            } else {
+                auto model = kalman::makeAugmentedProcessModel(p.processModel,
+                                                               beaconProcess);
+                kalman::correct(state, model, meas);
+            }
             gotMeasurement = true;
 #ifdef DEBUG_MEASUREMENT_RESIDUALS
             if (s) {
@@ -273,6 +310,13 @@ namespace vbtracker {
             std::cout << std::endl;
         }
 #endif
+        if (m_batchCorrection && gotMeasurement) {
+            /// All beacons were measured against the same predicted state, so
+            /// correct with them all at once.
+            gotMeasurement = batch.correct(
+                p.state, m_josephForm ? kalman::CovarianceUpdate::Joseph
+                                      : kalman::CovarianceUpdate::Standard);
+        }
         if (gotMeasurement) {
             // Re-symmetrize error covariance.
             kalman::types::DimSquareMatrix<BodyState> cov =
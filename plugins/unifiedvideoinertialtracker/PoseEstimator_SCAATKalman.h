@@ -85,6 +85,8 @@ namespace vbtracker {
         const double m_measurementVarianceScaleFactor;
         const double m_brightLedVariancePenalty;
         const bool m_extraVerbose;
+        const bool m_batchCorrection;
+        const bool m_josephForm;
         std::default_random_engine m_randEngine;
         static const int SIGNAL_HAVE_NOT_SEEN_BEACONS_YET = -1;
         int m_lastUsableBeaconsSeen = SIGNAL_HAVE_NOT_SEEN_BEACONS_YET;
@@ -0,0 +1,394 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RingBufferHistoryContainer_h_GUID_E5A38C71_0F2D_4B96_8D47_61B9C3A2F05E
+#define INCLUDED_RingBufferHistoryContainer_h_GUID_E5A38C71_0F2D_4B96_8D47_61B9C3A2F05E
+
+// Internal Includes
+#include "HistoryContainer.h"
+
+// Library/third-party includes
+#include <osvr/Util/TimeValue.h>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    namespace history {
+        namespace detail {
+            /// Random-access const iterator over the entries of a
+            /// RingBufferHistoryContainer, from oldest to newest.
+            template <typename Container> class RingBufferIterator {
+              public:
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type = typename Container::full_value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = value_type const *;
+                using reference = value_type const &;
+
+                RingBufferIterator() = default;
+                RingBufferIterator(Container const &container,
+                                   difference_type index)
+                    : m_container(&container), m_index(index) {}
+
+                reference operator*() const {
+                    return (*m_container)[m_index];
+                }
+                pointer operator->() const { return &(**this); }
+                reference operator[](difference_type n) const {
+                    return (*m_container)[m_index + n];
+                }
+
+                RingBufferIterator &operator++() {
+                    ++m_index;
+                    return *this;
+                }
+                RingBufferIterator operator++(int) {
+                    auto ret = *this;
+                    ++m_index;
+                    return ret;
+                }
+                RingBufferIterator &operator--() {
+                    --m_index;
+                    return *this;
+                }
+                RingBufferIterator operator--(int) {
+                    auto ret = *this;
+                    --m_index;
+                    return ret;
+                }
+                RingBufferIterator &operator+=(difference_type n) {
+                    m_index += n;
+                    return *this;
+                }
+                RingBufferIterator &operator-=(difference_type n) {
+                    m_index -= n;
+                    return *this;
+                }
+                RingBufferIterator operator+(difference_type n) const {
+                    return RingBufferIterator(*m_container, m_index + n);
+                }
+                friend RingBufferIterator operator+(difference_type n,
+                                                   RingBufferIterator it) {
+                    return it + n;
+                }
+                RingBufferIterator operator-(difference_type n) const {
+                    return RingBufferIterator(*m_container, m_index - n);
+                }
+                difference_type operator-(RingBufferIterator const &o) const {
+                    return m_index - o.m_index;
+                }
+
+                bool operator==(RingBufferIterator const &o) const {
+                    return m_index == o.m_index;
+                }
+                bool operator!=(RingBufferIterator const &o) const {
+                    return m_index != o.m_index;
+                }
+                bool operator<(RingBufferIterator const &o) const {
+                    return m_index < o.m_index;
+                }
+                bool operator>(RingBufferIterator const &o) const {
+                    return m_index > o.m_index;
+                }
+                bool operator<=(RingBufferIterator const &o) const {
+                    return m_index <= o.m_index;
+                }
+                bool operator>=(RingBufferIterator const &o) const {
+                    return m_index >= o.m_index;
+                }
+
+              private:
+                Container const *m_container = nullptr;
+                difference_type m_index = 0;
+            };
+        } // namespace detail
+
+        /// Stores values over time, in chronological order, like
+        /// HistoryContainer, but in a fixed-capacity ring buffer: pushing and
+        /// popping at either end is O(1) and searches are binary searches over
+        /// contiguous storage.
+        ///
+        /// Bounded by a number of entries and, optionally, by a time span:
+        /// pushing a new value first drops the oldest entries as needed to
+        /// stay within both. All storage is reserved on construction, and
+        /// entries are constructed in place the first time each slot is used
+        /// and assigned to thereafter, so nothing is allocated after that.
+        template <typename ValueType, bool AllowDuplicateTimes_ = true>
+        class RingBufferHistoryContainer {
+          public:
+            using value_type = ValueType;
+
+            using timestamp_type = detail::timestamp;
+            using full_value_type = detail::full_value_type<value_type>;
+            using size_type = std::size_t;
+
+            using const_iterator =
+                detail::RingBufferIterator<RingBufferHistoryContainer>;
+            using iterator = const_iterator;
+
+            using comparator_type = detail::TimestampPairLessThan<value_type>;
+
+            using subset_range_type =
+                detail::HistorySubsetRange<value_type, iterator>;
+
+            /// Whether multiple entries with the same timestamp are permitted
+            /// to be pushed.
+            static const bool AllowDuplicateTimes = AllowDuplicateTimes_;
+
+            /// @param capacity Maximum number of entries kept (at least 1).
+            /// @param maxSpan If positive, the longest time in seconds that
+            /// entries are kept before the newest.
+            explicit RingBufferHistoryContainer(size_type capacity,
+                                                double maxSpan = 0)
+                : m_capacity(std::max(capacity, size_type(1))),
+                  m_maxSpan(maxSpan) {
+                m_storage.reserve(m_capacity);
+            }
+
+            /// Get number of entries in history.
+            size_type size() const { return m_size; }
+
+            /// Gets whether history is empty or not.
+            bool empty() const { return m_size == 0; }
+
+            /// Gets the maximum number of entries kept.
+            size_type capacity() const { return m_capacity; }
+
+            /// Gets the longest time span (in seconds) kept, or 0 if
+            /// unlimited.
+            double max_span() const { return m_maxSpan; }
+
+            /// Access to the entry at the given index, 0 being the oldest.
+            full_value_type const &operator[](std::ptrdiff_t index) const {
+                return m_storage[m_physicalIndex(size_type(index))];
+            }
+
+            timestamp_type const &oldest_timestamp() const {
+                if (empty()) {
+                    throw std::logic_error(
+                        "Can't get time of oldest entry in an "
+                        "empty history container!");
+                }
+                return (*this)[0].first;
+            }
+
+            value_type const &oldest() const {
+                if (empty()) {
+                    throw std::logic_error("Can't get oldest entry in an "
+                                           "empty history container!");
+                }
+                return (*this)[0].second;
+            }
+
+            /// Returns the newest timestamp in the container. Caveat: throws an
+            /// exception in an empty container - see
+            /// HistoryContainer::newest_timestamp()
+            timestamp_type const &newest_timestamp() const {
+                if (empty()) {
+                    throw std::logic_error(
+                        "Can't get time of newest entry in an "
+                        "empty history container!");
+                }
+                return (*this)[m_size - 1].first;
+            }
+
+            value_type const &newest() const {
+                if (empty()) {
+                    throw std::logic_error("Can't get newest entry in an "
+                                           "empty history container!");
+                }
+                return (*this)[m_size - 1].second;
+            }
+
+            /// Returns a comparison functor (comparing timestamps) for use with
+            /// standard algorithms like lower_bound and upper_bound
+            static comparator_type comparator() { return comparator_type{}; }
+
+            void pop_oldest() {
+                if (empty()) {
+                    throw std::logic_error("Can't pop from an empty history "
+                                           "container!");
+                }
+                m_drop_oldest(1);
+            }
+            void pop_newest() {
+                if (empty()) {
+                    throw std::logic_error("Can't pop from an empty history "
+                                           "container!");
+                }
+                --m_size;
+            }
+
+            const_iterator begin() const { return const_iterator(*this, 0); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator end() const {
+                return const_iterator(*this, std::ptrdiff_t(m_size));
+            }
+            const_iterator cend() const { return end(); }
+
+            /// Returns true if the given timestamp is strictly newer than the
+            /// newest timestamp in the container, or if the container is empty
+            /// (thus making the timestamp trivially newest)
+            bool is_strictly_newest(timestamp_type const &tv) const {
+                return empty() || newest_timestamp() < tv;
+            }
+
+            /// Returns true if the given timestamp is no older than the
+            /// newest timestamp in the container, or if the container is empty
+            /// (thus making the timestamp trivially newest)
+            bool is_as_new_as_newest(timestamp_type const &tv) const {
+                return empty() || !(tv < newest_timestamp());
+            }
+
+            /// Returns true if the given timestamp meets the criteria of
+            /// push_newest: strictly newest if AllowDuplicateTimes is false, as
+            /// new as newest if AllowDuplicateTimes is true.
+            bool is_valid_to_push_newest(timestamp_type const &tv) const {
+                return empty() || tv > newest_timestamp() ||
+                       (AllowDuplicateTimes && newest_timestamp() == tv);
+            }
+
+            /// Wrapper around std::upper_bound: returns iterator to first
+            /// element newer than timestamp given or end() if none.
+            const_iterator upper_bound(timestamp_type const &tv) const {
+                return std::upper_bound(begin(), end(), tv, comparator());
+            }
+            /// Wrapper around std::lower_bound: returns iterator to first
+            /// element with timestamp equal or newer than timestamp given or
+            /// end() if none.
+            const_iterator lower_bound(timestamp_type const &tv) const {
+                return std::lower_bound(begin(), end(), tv, comparator());
+            }
+
+            /// Return an iterator to the newest, last pair of timestamp and
+            /// value that is not newer than the given timestamp. If none meet
+            /// this criteria, returns end().
+            const_iterator closest_not_newer(timestamp_type const &tv) const {
+                auto it = upper_bound(tv);
+                if (begin() == it) {
+                    return end();
+                }
+                return --it;
+            }
+
+            /// Returns a proxy object that can be treated as a range in a
+            /// range-for loop to iterate over all elements strictly newer than
+            /// the given timestamp.
+            /// (Uses upper_bound internally.)
+            subset_range_type
+            get_range_newer_than(timestamp_type const &tv) const {
+                return subset_range_type(upper_bound(tv), end());
+            }
+
+            /// Remove all entries in history with timestamps strictly older
+            /// than the given timestamp - except that, like
+            /// HistoryContainer::pop_before(), it removes nothing if that would
+            /// be all of them.
+            /// @return number of elements removed.
+            size_type pop_before(timestamp_type const &tv) {
+                if (empty() || is_strictly_newest(tv)) {
+                    return 0;
+                }
+                auto count = size_type(lower_bound(tv) - begin());
+                m_drop_oldest(count);
+                return count;
+            }
+
+            /// Remove all entries in history with timestamps strictly newer
+            /// than the given timestamp.
+            /// @return number of elements removed.
+            size_type pop_after(timestamp_type const &tv) {
+                auto remaining = size_type(upper_bound(tv) - begin());
+                auto count = m_size - remaining;
+                m_size = remaining;
+                return count;
+            }
+
+            /// Adds a new value to history, first dropping the oldest entries
+            /// as needed to respect the capacity and time span. It must be
+            /// newer (or equal time, based on template parameters) than the
+            /// newest (or the history must be empty).
+            void push_newest(osvr::util::time::TimeValue const &tv,
+                             value_type const &value) {
+                if (!is_valid_to_push_newest(tv)) {
+                    throw std::logic_error(
+                        "Can't push_newest a value that's older "
+                        "than the most recent value!");
+                }
+                if (m_size == m_capacity) {
+                    m_drop_oldest(1);
+                }
+                if (m_maxSpan > 0) {
+                    while (!empty() &&
+                           osvrTimeValueDurationSeconds(
+                               &tv, &oldest_timestamp()) > m_maxSpan) {
+                        m_drop_oldest(1);
+                    }
+                }
+                auto slot = m_physicalIndex(m_size);
+                if (slot == m_storage.size()) {
+                    /// First use of this slot.
+                    m_storage.emplace_back(tv, value);
+                } else {
+                    m_storage[slot].first = tv;
+                    m_storage[slot].second = value;
+                }
+                ++m_size;
+            }
+
+          private:
+            /// Maps an index from the oldest entry to an index in storage.
+            /// Slots are used in order starting from 0, so storage only falls
+            /// short of capacity before the buffer has first wrapped around,
+            /// and the slot after the newest entry is always either in storage
+            /// or the next one to be added.
+            size_type m_physicalIndex(size_type index) const {
+                auto ret = m_oldest + index;
+                return ret < m_capacity ? ret : ret - m_capacity;
+            }
+            void m_drop_oldest(size_type count) {
+                m_oldest = m_physicalIndex(count);
+                m_size -= count;
+            }
+
+            size_type m_capacity;
+            double m_maxSpan;
+            std::vector<full_value_type> m_storage;
+            /// Index in storage of the oldest entry.
+            size_type m_oldest = 0;
+            size_type m_size = 0;
+        };
+    } // namespace history
+
+    using history::RingBufferHistoryContainer;
+
+} // namespace vbtracker
+} // namespace osvr
+#endif // INCLUDED_RingBufferHistoryContainer_h_GUID_E5A38C71_0F2D_4B96_8D47_61B9C3A2F05E
@@ -30,7 +30,7 @@
 #include <osvr/Util/EigenInterop.h>
 
 // Standard includes
-// - none
+#include <chrono>
 
 namespace osvr {
 namespace vbtracker {
@@ -80,58 +80,47 @@ namespace vbtracker {
     }
 
     BodyReport BodyReporting::getReport(double additionalPrediction) {
-        BodyState state;
-        bool doingPrediction = false;
-        BodyProcessModel process;
-        util::time::TimeValue dataTime;
-        Eigen::Isometry3d trackerToRoom;
-        {
-            std::unique_lock<std::mutex> lock{m_mutex, std::try_to_lock};
-            if (!lock.owns_lock()) {
-                // Didn't get the lock.
-                return BodyReport::makeReportWithStatus(
-                    ReportStatus::MutexLocked);
-            }
-            // OK, we got the lock.
-            if (!m_shouldReport) {
-                // Told we shouldn't report, OK.
-                return BodyReport::makeReportWithStatus(
-                    ReportStatus::NoReportAvailable);
-            }
-            /// If we got here, then we're reporting something.
-            state = m_state;
-            if (state.stateVector().tail<6>() !=
-                kalman::types::Vector<6>::Zero()) {
-                // If we have non-zero velocity, then we can do some prediction,
-                // which we'll need the process for.
-                doingPrediction = true;
-                process = m_process;
-            }
-            dataTime = m_dataTime;
-            trackerToRoom = m_trackerToRoom;
-        } // unlock
+        if (m_published.load(std::memory_order_relaxed) & FRESH_BIT) {
+            // Hand back the buffer we were reading, take the newest one.
+            m_front = m_published.exchange(m_front, std::memory_order_acq_rel) &
+                      INDEX_MASK;
+            ++m_freshReports;
+        } else {
+            ++m_repeatedReports;
+        }
+        auto const &snapshot = m_buffers[m_front];
+        if (!snapshot.shouldReport) {
+            // Told we shouldn't report, OK.
+            return BodyReport::makeReportWithStatus(
+                ReportStatus::NoReportAvailable);
+        }
 
+        /// If we got here, then we're reporting something.
         auto ret = BodyReport::makeReportWithStatus();
-        if (doingPrediction) {
+        if (snapshot.state.stateVector().tail<6>() !=
+            kalman::types::Vector<6>::Zero()) {
             // If we have non-zero velocity, then we can do some prediction.
+            BodyState state = snapshot.state;
             auto currentTime = util::time::getNow();
             /// Difference between measurement time and now.
-            auto dt = osvrTimeValueDurationSeconds(&currentTime, &dataTime);
+            auto dt = osvrTimeValueDurationSeconds(&currentTime,
+                                                   &snapshot.dataTime);
             /// and the additional time into the future we'd like to predict.
             dt += additionalPrediction;
             /// Using computeEstimate instead of the normal prediction saves us
             /// the unneeded prediction of the error covariance.
-            state.setStateVector(process.computeEstimate(state, dt));
+            state.setStateVector(snapshot.process.computeEstimate(state, dt));
             /// Be sure to post-correct.
             state.postCorrect();
 
             /// OK, now set a proper timestamp for our prediction.
             ret.timestamp = currentTime +
                             std::chrono::duration<double>(additionalPrediction);
-            assignStateToBodyReport(state, ret, trackerToRoom);
+            assignStateToBodyReport(state, ret, snapshot.trackerToRoom);
         } else {
-            ret.timestamp = dataTime;
-            assignStateToBodyReport(state, ret, trackerToRoom);
+            ret.timestamp = snapshot.dataTime;
+            assignStateToBodyReport(snapshot.state, ret,
+                                    snapshot.trackerToRoom);
             /// @todo should we set the "don't report" flag here once we report
             /// a can't-predict state once?
         }
@@ -139,39 +128,61 @@ namespace vbtracker {
         return ret;
     }
 
+    BodyReportingStats BodyReporting::getStats() const {
+        BodyReportingStats ret;
+        ret.published = m_publishCount.load(std::memory_order_relaxed);
+        ret.freshReports = m_freshReports;
+        ret.repeatedReports = m_repeatedReports;
+        return ret;
+    }
+
     void BodyReporting::markShouldNotReport() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shouldReport = false;
+        m_latest.shouldReport = false;
+        m_publish();
     }
     /// Updates the state, implicitly setting the flag that the mainloop
     /// should report.
     void BodyReporting::updateState(util::time::TimeValue const &tv,
                                     BodyState const &state,
                                     BodyProcessModel const &process) {
-
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shouldReport = true;
-        m_dataTime = tv;
-        m_state = state;
-        m_process = process;
+        m_latest.shouldReport = true;
+        m_latest.dataTime = tv;
+        m_latest.state = state;
+        m_latest.process = process;
+        m_publish();
     }
 
     void BodyReporting::updateState(util::time::TimeValue const &tv,
                                     BodyState const &state) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shouldReport = true;
-        m_dataTime = tv;
-        m_state = state;
+        m_latest.shouldReport = true;
+        m_latest.dataTime = tv;
+        m_latest.state = state;
+        m_publish();
     }
 
     void
     BodyReporting::setTrackerToRoomTransform(Eigen::Isometry3d const &xform) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_trackerToRoom = xform;
+        m_latest.trackerToRoom = xform;
+        m_publish();
+    }
+
+    void BodyReporting::m_publish() {
+        m_buffers[m_back] = m_latest;
+        // Publish the back buffer, and take whichever buffer was published
+        // before (whether or not the mainloop thread ever took it) as the new
+        // back buffer.
+        m_back = m_published.exchange(m_back | FRESH_BIT,
+                                      std::memory_order_acq_rel) &
+                 INDEX_MASK;
+        m_publishCount.fetch_add(1, std::memory_order_relaxed);
     }
 
-    BodyReporting::BodyReporting()
-        : m_trackerToRoom(Eigen::Isometry3d::Identity()) {}
+    BodyReporting::BodyReporting() : m_published(0), m_publishCount(0) {
+        m_latest.trackerToRoom = Eigen::Isometry3d::Identity();
+        for (auto &buf : m_buffers) {
+            buf = m_latest;
+        }
+    }
 
 } // namespace vbtracker
 } // namespace osvr
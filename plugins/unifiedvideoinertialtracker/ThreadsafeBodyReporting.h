@@ -34,12 +34,14 @@
 #include <boost/optional.hpp>
 
 // Standard includes
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace osvr {
 namespace vbtracker {
-    enum class ReportStatus { Valid, MutexLocked, NoReportAvailable };
+    enum class ReportStatus { Valid, NoReportAvailable };
     struct BodyReport {
 
         static BodyReport
@@ -60,8 +62,27 @@ namespace vbtracker {
         // OSVR_AngularVelocityState angVel;
     };
 
+    /// Counters describing how snapshots have passed through a BodyReporting
+    /// object.
+    struct BodyReportingStats {
+        /// Snapshots published by the processing thread.
+        std::uint64_t published = 0;
+        /// Reports made from a snapshot not previously reported from.
+        std::uint64_t freshReports = 0;
+        /// Reports predicted again from the same snapshot as the previous
+        /// report, because the processing thread hadn't published a new one
+        /// in between.
+        std::uint64_t repeatedReports = 0;
+    };
+
     /// A per-body class intended to marshall data coming from the
     /// tracking/processing thread back to the mainloop thread.
+    ///
+    /// Internally triple-buffered: the processing thread writes into a back
+    /// buffer and publishes it with a single atomic exchange, and the mainloop
+    /// thread takes the most recently published buffer the same way, so
+    /// neither thread ever blocks or retries, and every getReport() call sees a
+    /// consistent snapshot.
     class BodyReporting {
       public:
         /// Factory function
@@ -75,15 +96,17 @@ namespace vbtracker {
         /// only if it is ReportStatus::Valid does it contain anything useful,
         /// for the timestamp it says on the object.
         ///
-        /// Otherwise either the mutex was locked (you're in a
-        /// fast-spinning loop, just get it next time), or there's nothing worth
-        /// reporting - in both cases, the other fields are not initialized!
+        /// Otherwise there's nothing worth reporting, and the other fields are
+        /// not initialized!
         BodyReport getReport(double additionalPrediction);
+
+        /// Gets the snapshot counters.
+        BodyReportingStats getStats() const;
         /// @}
 
         /// @name processing-thread methods
-        /// @brief These all block on the mutex, because the processing thread
-        /// needs to get its message through.
+        /// @brief These must all be called from the same thread. None of them
+        /// wait on the mainloop thread.
         /// @{
         /// Sets the flag that the mainloop should not report. Doesn't touch the
         /// other members since they're unusuable by definition if you should
@@ -105,14 +128,39 @@ namespace vbtracker {
         /// @}
       private:
         BodyReporting();
-        std::mutex m_mutex;
-        /// @name Protected by mutex
+        struct Snapshot {
+            bool shouldReport = false;
+            util::time::TimeValue dataTime;
+            BodyState state;
+            BodyProcessModel process;
+            Eigen::Isometry3d trackerToRoom;
+        };
+        /// Copies m_latest into the back buffer and swaps it in as the newest
+        /// published snapshot.
+        void m_publish();
+
+        using BufferIndex = std::uint8_t;
+        /// Set in m_published when it refers to a buffer that the mainloop
+        /// thread hasn't yet taken.
+        static const BufferIndex FRESH_BIT = 0x4;
+        static const BufferIndex INDEX_MASK = 0x3;
+
+        std::array<Snapshot, 3> m_buffers;
+        /// Index of the most recently published buffer, with FRESH_BIT.
+        std::atomic<BufferIndex> m_published;
+        std::atomic<std::uint64_t> m_publishCount;
+
+        /// @name Processing thread only
+        /// @{
+        Snapshot m_latest;
+        BufferIndex m_back = 1;
+        /// @}
+
+        /// @name Mainloop thread only
         /// @{
-        bool m_shouldReport = false;
-        util::time::TimeValue m_dataTime;
-        BodyState m_state;
-        BodyProcessModel m_process;
-        Eigen::Isometry3d m_trackerToRoom;
+        BufferIndex m_front = 2;
+        std::uint64_t m_freshReports = 0;
+        std::uint64_t m_repeatedReports = 0;
         /// @}
     };
     using BodyReportingPtr = std::unique_ptr<BodyReporting>;
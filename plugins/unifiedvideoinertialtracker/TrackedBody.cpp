@@ -30,27 +30,153 @@
 #include "TrackingSystem.h"
 #include "BodyTargetInterface.h"
 #include "StateHistory.h"
-#include "HistoryContainer.h"
+#include "RingBufferHistoryContainer.h"
 #include "CannedIMUMeasurement.h"
 
 // Library/third-party includes
 #include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Util/EigenQuatExponentialMap.h>
 #include <boost/optional.hpp>
-
-#include <util/Stride.h>
+#include <Eigen/Cholesky>
 
 // Standard includes
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
 #include <iostream>
 
 namespace osvr {
 namespace vbtracker {
     using BodyStateHistoryEntry = StateHistoryEntry<BodyState>;
 
+    /// The most history entries of each kind we keep: well over the span
+    /// below at IMU rates.
+    static const std::size_t HISTORY_CAPACITY = 1024;
+    /// The longest history we keep, in seconds, however long ago a target or
+    /// IMU last reported: video measurements arrive far sooner than this after
+    /// the frame they were taken from.
+    static const double HISTORY_SPAN = 0.25;
+
+    using StateVec = kalman::types::DimVector<BodyState>;
+    using StateMatrix = kalman::types::DimSquareMatrix<BodyState>;
+    using StateDim = kalman::types::Dimension<BodyState>;
+
+    /// A state history entry, along with how many delayed-state corrections
+    /// the current state had received when it was recorded.
+    struct BodyStateSnapshot {
+        BodyStateSnapshot(BodyState const &state, std::uint64_t corrections)
+            : entry(state), corrections(corrections) {}
+        BodyStateHistoryEntry entry;
+        std::uint64_t corrections;
+    };
+
+    /// A correction made by a video-based estimate for a past frame, already
+    /// carried forward to the then-current state. Snapshots recorded in
+    /// between the frame and that state don't include it: rather than fix
+    /// them all up when it's made, it's applied to one when it's restored.
+    struct DelayedCorrection {
+        /// Time of the frame the correction was made at.
+        util::time::TimeValue frameTime;
+        /// Time of the state it was carried forward to: no snapshot older
+        /// than this needs the correction.
+        util::time::TimeValue appliedTime;
+        /// Snapshots recorded having received no more corrections than this
+        /// predate it.
+        std::uint64_t index;
+        /// Change in the state vector and error covariance at frameTime, in
+        /// arrays so we needn't worry about alignment in the deque.
+        std::array<kalman::types::Scalar, StateDim::value> stateChange;
+        std::array<kalman::types::Scalar, StateDim::value * StateDim::value>
+            covarianceChange;
+    };
+
+    /// Applies a state vector and error covariance change made dt seconds
+    /// earlier to a state, through the process model's state transition
+    /// matrix. The covariance is left alone if the result wouldn't be
+    /// positive definite: returns whether it was updated.
+    static bool applyStateChange(BodyState &state,
+                                 BodyProcessModel const &model, double dt,
+                                 StateVec const &stateChange,
+                                 StateMatrix const &covarianceChange) {
+        StateMatrix A = model.getStateTransitionMatrix(state, dt);
+        state.setStateVector(state.stateVector() + A * stateChange);
+        state.externalizeRotation();
+
+        StateMatrix P =
+            state.errorCovariance() - A * covarianceChange * A.transpose();
+        P = (0.5 * P + 0.5 * P.transpose()).eval();
+        if (P.llt().info() != Eigen::Success) {
+            return false;
+        }
+        state.setErrorCovariance(P);
+        return true;
+    }
+
     struct TrackedBody::Impl {
+        Impl()
+            : stateHistory(HISTORY_CAPACITY, HISTORY_SPAN),
+              imuMeasurements(HISTORY_CAPACITY, HISTORY_SPAN) {}
+
+        /// Restores a snapshot from the state history, with any corrections
+        /// made since that it doesn't include.
+        void restore(util::time::TimeValue const &tv,
+                     BodyStateSnapshot const &snapshot,
+                     BodyProcessModel const &model, BodyState &state) const {
+            snapshot.entry.restore(state);
+            for (auto const &correction : corrections) {
+                if (correction.index < snapshot.corrections ||
+                    tv < correction.frameTime) {
+                    continue;
+                }
+                applyStateChange(
+                    state, model,
+                    util::time::duration(tv, correction.frameTime),
+                    StateVec::Map(correction.stateChange.data()),
+                    StateMatrix::Map(correction.covarianceChange.data()));
+            }
+        }
 
-        HistoryContainer<BodyStateHistoryEntry> stateHistory;
-        HistoryContainer<CannedIMUMeasurement> imuMeasurements;
+        RingBufferHistoryContainer<BodyStateSnapshot> stateHistory;
+        RingBufferHistoryContainer<CannedIMUMeasurement> imuMeasurements;
+        /// Delayed-state corrections, oldest first.
+        std::deque<DelayedCorrection> corrections;
+        /// Number of delayed-state corrections made so far.
+        std::uint64_t numCorrections = 0;
+        VideoFusionStats stats;
     };
+
+    using FusionClock = std::chrono::steady_clock;
+
+    /// Adds the time since begin to a running total and max, returning it.
+    static double recordFusionTime(FusionClock::time_point begin,
+                                   double &total, double &max) {
+        auto seconds =
+            std::chrono::duration<double>(FusionClock::now() - begin).count();
+        total += seconds;
+        max = std::max(max, seconds);
+        return seconds;
+    }
+
+    std::ostream &operator<<(std::ostream &os, VideoFusionStats const &stats) {
+        os << stats.replayedFrames << " frames replayed";
+        if (stats.replayedFrames > 0) {
+            auto n = double(stats.replayedFrames);
+            os << " (mean " << stats.replayedMeasurements / n
+               << " IMU measurements, max " << stats.maxReplayedMeasurements
+               << "; mean " << stats.replaySeconds * 1000. / n << " ms, max "
+               << stats.maxReplaySeconds * 1000. << " ms; "
+               << stats.mismatchedReplays << " with a different number popped)";
+        }
+        os << ", " << stats.delayedStateFrames << " frames as delayed state";
+        if (stats.delayedStateFrames > 0) {
+            auto n = double(stats.delayedStateFrames);
+            os << " (mean " << stats.delayedStateSeconds * 1000. / n
+               << " ms, max " << stats.maxDelayedStateSeconds * 1000. << " ms)";
+        }
+        return os;
+    }
+
     TrackedBody::TrackedBody(TrackingSystem &system, BodyId id)
         : m_system(system), m_id(id), m_impl(new Impl) {
         using StateVec = kalman::types::DimVector<BodyState>;
@@ -110,7 +236,7 @@ namespace vbtracker {
             return false;
         }
         outTime = it->first;
-        it->second.restore(outState);
+        m_impl->restore(it->first, it->second, m_processModel, outState);
         return true;
     }
 
@@ -161,6 +287,14 @@ namespace vbtracker {
         m_impl->stateHistory.pop_before(oldest);
 
         m_impl->imuMeasurements.pop_before(oldest);
+
+        /// Corrections only needed by snapshots we no longer have can go.
+        auto &corrections = m_impl->corrections;
+        auto oldestSnapshot = m_impl->stateHistory.oldest_timestamp();
+        while (!corrections.empty() &&
+               corrections.front().appliedTime < oldestSnapshot) {
+            corrections.pop_front();
+        }
     }
 
     void TrackedBody::replaceStateSnapshot(
@@ -172,6 +306,8 @@ namespace vbtracker {
 #endif // !(defined(OSVR_UVBI_ASSUME_SINGLE_CAMERA) &&
         // defined(OSVR_UVBI_ASSUME_CAMERA_ALWAYS_SLOWER))
 
+        auto begin = FusionClock::now();
+
         /// Clear off the state we're about to invalidate.
         auto numPopped = m_impl->stateHistory.pop_after(origTime);
         /// @todo number popped should be the same (or very nearly) as the
@@ -191,20 +327,104 @@ namespace vbtracker {
             applyIMUMeasurement(imuHist.first, imuHist.second);
             ++numReplayed;
         }
-#if 0
-        static ::util::Stride s{43};
-        if (++s) {
-#else
+
+        auto &stats = m_impl->stats;
+        recordFusionTime(begin, stats.replaySeconds, stats.maxReplaySeconds);
+        ++stats.replayedFrames;
+        stats.replayedMeasurements += numReplayed;
+        stats.maxReplayedMeasurements =
+            std::max(stats.maxReplayedMeasurements,
+                     static_cast<std::uint64_t>(numReplayed));
         if (numPopped != numReplayed) {
-#endif
-            std::cout << "Popped " << numPopped << ", replayed " << numReplayed
-                      << "\n";
+            ++stats.mismatchedReplays;
+        }
+    }
+
+    void TrackedBody::correctStateSnapshot(
+        osvr::util::time::TimeValue const &origTime,
+        osvr::util::time::TimeValue const &newTime, BodyState const &newState) {
+        auto begin = FusionClock::now();
+        if (getParams().delayedStateVideoFusion &&
+            carryCorrectionForward(origTime, newTime, newState)) {
+            auto &stats = m_impl->stats;
+            recordFusionTime(begin, stats.delayedStateSeconds,
+                             stats.maxDelayedStateSeconds);
+            ++stats.delayedStateFrames;
+            return;
+        }
+        replaceStateSnapshot(origTime, newTime, newState);
+    }
+
+    bool TrackedBody::carryCorrectionForward(
+        util::time::TimeValue const &origTime,
+        util::time::TimeValue const &newTime, BodyState const &newState) {
+        auto &history = m_impl->stateHistory;
+        if (history.empty() || !(newTime < m_stateTime) ||
+            util::time::duration(m_stateTime, newTime) >
+                getParams().delayedStateMaxLag) {
+            /// Nothing newer to replay, or too much to carry a linear
+            /// correction across.
+            return false;
         }
+        auto it = history.closest_not_newer(origTime);
+        if (history.end() == it || it->first != origTime) {
+            return false;
+        }
+
+        /// Reconstruct the state the correction was made to, just as the
+        /// estimator did: the snapshot predicted to the frame time.
+        BodyState prior;
+        m_impl->restore(it->first, it->second, m_processModel, prior);
+        if (origTime != newTime) {
+            kalman::predict(prior, m_processModel,
+                            util::time::duration(newTime, origTime));
+            prior.externalizeRotation();
+        }
+
+        /// The correction, with the change in orientation as an incremental
+        /// rotation.
+        StateVec stateChange = newState.stateVector() - prior.stateVector();
+        Eigen::Quaterniond rotChange = newState.getCombinedQuaternion() *
+                                       prior.getCombinedQuaternion().inverse();
+        if (rotChange.w() < 0) {
+            rotChange.coeffs() *= -1;
+        }
+        kalman::pose_externalized_rotation::incrementalOrientation(
+            stateChange) = util::quat_exp_map(rotChange).ln();
+        StateMatrix covarianceChange =
+            prior.errorCovariance() - newState.errorCovariance();
+
+        /// Carry it forward to the current state.
+        BodyState state = m_state;
+        if (!applyStateChange(state, m_processModel,
+                              util::time::duration(m_stateTime, newTime),
+                              stateChange, covarianceChange)) {
+            /// Not a correction we can carry forward linearly.
+            return false;
+        }
+        m_state = state;
+
+        /// Snapshots since the frame, including the one of the current state
+        /// we just replaced, will get it when restored.
+        DelayedCorrection correction;
+        correction.frameTime = newTime;
+        correction.appliedTime = m_stateTime;
+        correction.index = m_impl->numCorrections;
+        StateVec::Map(correction.stateChange.data()) = stateChange;
+        StateMatrix::Map(correction.covarianceChange.data()) =
+            covarianceChange;
+        m_impl->corrections.push_back(correction);
+        ++m_impl->numCorrections;
+        return true;
+    }
+
+    VideoFusionStats const &TrackedBody::getVideoFusionStats() const {
+        return m_impl->stats;
     }
 
     void TrackedBody::pushState() {
-        m_impl->stateHistory.push_newest(m_stateTime,
-                                         BodyStateHistoryEntry{m_state});
+        m_impl->stateHistory.push_newest(
+            m_stateTime, BodyStateSnapshot{m_state, m_impl->numCorrections});
     }
 
     void TrackedBody::incorporateNewMeasurementFromIMU(
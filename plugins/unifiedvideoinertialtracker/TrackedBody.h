@@ -37,6 +37,8 @@
 #include <boost/assert.hpp>
 
 // Standard includes
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
 
 namespace osvr {
@@ -46,6 +48,33 @@ namespace vbtracker {
     class TrackedBodyTarget;
     struct TargetSetupData;
 
+    /// Counters describing how video-based estimates for past frames have
+    /// been incorporated into a body's current state.
+    struct VideoFusionStats {
+        /// Frames incorporated by rolling the state history back to the frame
+        /// and replaying the newer IMU measurements.
+        std::uint64_t replayedFrames = 0;
+        /// IMU measurements replayed, in total and for the worst frame.
+        std::uint64_t replayedMeasurements = 0;
+        std::uint64_t maxReplayedMeasurements = 0;
+        /// Replays where the number of states rolled back differed from the
+        /// number of measurements replayed.
+        std::uint64_t mismatchedReplays = 0;
+        /// Time spent on replayed frames, in total and for the worst frame.
+        double replaySeconds = 0;
+        double maxReplaySeconds = 0;
+        /// Frames incorporated by carrying their correction forward to the
+        /// current state (see ConfigParams::delayedStateVideoFusion).
+        std::uint64_t delayedStateFrames = 0;
+        /// Time spent on those frames, in total and for the worst frame.
+        double delayedStateSeconds = 0;
+        double maxDelayedStateSeconds = 0;
+    };
+
+    /// Prints the frame counts, and the mean and max replay count and time per
+    /// frame, on one line.
+    std::ostream &operator<<(std::ostream &os, VideoFusionStats const &stats);
+
     /// This is the class representing a tracked rigid body in the system. It
     /// may be tracked by one (or eventually more) video-based "target"
     /// (constellation of beacons in a known pattern with other known traits),
@@ -201,6 +230,24 @@ namespace vbtracker {
                                   osvr::util::time::TimeValue const &newTime,
                                   BodyState const &newState);
 
+        /// Like replaceStateSnapshot(), but for a state that is a Kalman
+        /// correction of the one from getStateAtOrBefore() with a measurement
+        /// taken at newTime, rather than an estimate made from scratch.
+        ///
+        /// If ConfigParams::delayedStateVideoFusion is set and newTime is
+        /// recent enough, the difference the correction made is carried
+        /// forward to the current state through the process model, instead of
+        /// replaying the newer measurements. Otherwise (or if the correction
+        /// can't be carried forward), this just calls replaceStateSnapshot().
+        void correctStateSnapshot(osvr::util::time::TimeValue const &origTime,
+                                  osvr::util::time::TimeValue const &newTime,
+                                  BodyState const &newState);
+
+        /// How video-based estimates have been incorporated so far. Only
+        /// consistent when read from the thread doing the tracking, or once it
+        /// has stopped.
+        VideoFusionStats const &getVideoFusionStats() const;
+
         /// Clean histories of no-longer-needed historical state and
         /// measurements.
         void pruneHistory();
@@ -227,6 +274,11 @@ namespace vbtracker {
         /// history.
         void applyIMUMeasurement(util::time::TimeValue const &tv,
                                  CannedIMUMeasurement const &meas);
+        /// The delayed-state half of correctStateSnapshot(): returns false,
+        /// having changed nothing, if the correction can't be carried forward.
+        bool carryCorrectionForward(util::time::TimeValue const &origTime,
+                                    util::time::TimeValue const &newTime,
+                                    BodyState const &newState);
         /// Pushes current state on to history: assumes you've already updated
         /// m_state and the stateTime.
         void pushState();
@@ -25,6 +25,7 @@
 // Internal Includes
 #include "TrackedBodyTarget.h"
 #include "TrackedBody.h"
+#include "BlobMatcher.h"
 #include "LED.h"
 #include "cvToEigen.h"
 #include "HDKLedIdentifier.h"
@@ -33,12 +34,16 @@
 #include "PoseEstimator_SCAATKalman.h"
 #include "PoseEstimator_RANSACKalman.h"
 #include "BodyTargetInterface.h"
+#include "ProjectPoint.h"
 
 // Library/third-party includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <boost/assert.hpp>
 #include <util/Stride.h>
 
 // Standard includes
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 /// Define this to use the RANSAC Kalman instead of the autocalibrating SCAAT
@@ -91,13 +96,31 @@ namespace vbtracker {
       private:
         std::size_t m_framesWithoutValidBeacons = 0;
     };
+
+    std::ostream &operator<<(std::ostream &os,
+                             ReacquisitionStats const &stats) {
+        os << stats.successes << " of " << stats.attempts
+           << " RANSAC attempts found a pose, " << stats.seeded
+           << " seeded (" << stats.seedEarlyExits << " by the seed alone), "
+           << stats.hypotheses << " hypotheses, " << stats.earlyExits
+           << " early exits, " << stats.reacquisitions
+           << " re-acquisitions";
+        if (stats.reacquisitions > 0) {
+            os << " (mean " << stats.reacquireSeconds / stats.reacquisitions
+               << " s, max " << stats.maxReacquireSeconds << " s)";
+        }
+        return os;
+    }
+
     struct TrackedBodyTarget::Impl {
         Impl(ConfigParams const &params, BodyTargetInterface const &bodyIface)
-            : bodyInterface(bodyIface), kalmanEstimator(params) {}
+            : bodyInterface(bodyIface), ransacEstimator(params),
+              kalmanEstimator(params) {}
         BodyTargetInterface bodyInterface;
         LedGroup leds;
         LedPtrList usableLeds;
         LedIdentifierPtr identifier;
+        BlobMatcher blobMatcher;
         RANSACPoseEstimator ransacEstimator;
         SCAATKalmanPoseEstimator kalmanEstimator;
 #ifdef OSVR_RANSACKALMAN
@@ -109,6 +132,20 @@ namespace vbtracker {
         TargetTrackingState trackingState = TargetTrackingState::RANSAC;
         bool hasPrev = false;
         osvr::util::time::TimeValue lastEstimate;
+        /// Whether the last estimate was a Kalman correction we kept.
+        bool kalmanCorrected = false;
+
+        /// Whether we had a fix and lost it, and haven't regained it yet.
+        bool lostTracking = false;
+        /// The last frame we had a fix in, if lostTracking.
+        osvr::util::time::TimeValue lostTrackingTime;
+        /// Just the re-acquisition counts: the rest come from ransacEstimator.
+        ReacquisitionStats reacquisitionStats;
+
+        /// Where to look for blobs in the frame after predictedRegionsFrame.
+        bool havePredictedRegions = false;
+        osvr::util::time::TimeValue predictedRegionsFrame;
+        PredictedBlobRegions predictedRegions;
     };
 
     inline BeaconStateVec createBeaconStateVec(ConfigParams const &params,
@@ -213,9 +250,7 @@ namespace vbtracker {
 
     std::size_t TrackedBodyTarget::processLedMeasurements(
         LedMeasurementVec const &undistortedLeds) {
-        // std::list<LedMeasurement> measurements{begin(undistortedLeds),
-        // end(undistortedLeds)};
-        LedMeasurementVec measurements{undistortedLeds};
+        auto const &measurements = undistortedLeds;
 
         /// Clear the "usableLeds" that will be populated in a later step, if we
         /// get that far.
@@ -255,26 +290,37 @@ namespace vbtracker {
             return false;
         };
 
+        /// Associate the blobs in this frame with the LEDs from the previous
+        /// frame, all at once.
+        auto &matcher = m_impl->blobMatcher;
+        matcher.reset(measurements);
+        for (auto &led : myLeds) {
+            led.resetUsed();
+            handleOutOfRangeIds(led);
+            matcher.addPrevious(led.getLocation(),
+                                blobMoveThreshold *
+                                    led.getMeasurement().diameter);
+        }
+        matcher.match();
+
         auto led = begin(myLeds);
+        auto ledIndex = std::size_t{0};
         while (led != end(myLeds)) {
-            led->resetUsed();
-            handleOutOfRangeIds(*led);
-            auto threshold = blobMoveThreshold * led->getMeasurement().diameter;
-            auto nearest = led->nearest(measurements, threshold);
-            if (nearest == end(measurements)) {
+            auto nearest = matcher.getMatch(ledIndex);
+            ++ledIndex;
+            if (nearest == BlobMatcher::NO_MATCH) {
                 // We have no blob corresponding to this LED, so we need
                 // to delete this LED.
                 led = myLeds.erase(led);
             } else {
                 // Update the values in this LED and then go on to the
-                // next one. Remove this blob from the list of
-                // potential matches.
-                led->addMeasurement(*nearest, blobsKeepIdentity);
-                if (!handleOutOfRangeIds(*led)) {
-                    /// If that measurement didn't cause this beacon to go awry,
-                    /// then we'll actually handle the measurement and increment
-                    /// used measurements.
-                    measurements.erase(nearest);
+                // next one.
+                led->addMeasurement(measurements[nearest], blobsKeepIdentity);
+                if (handleOutOfRangeIds(*led)) {
+                    /// That measurement caused this beacon to go awry, so
+                    /// leave it available for a new LED.
+                    matcher.releaseMeasurement(nearest);
+                } else {
                     /// @todo do we increment this only if the LED is
                     /// recognized?
                     usedMeasurements++;
@@ -285,10 +331,10 @@ namespace vbtracker {
 
         // If we have any blobs that have not been associated with an
         // LED, then we add a new LED for each of them.
-        // std::cout << "Had " << Leds.size() << " LEDs, " <<
-        // keyPoints.size() << " new ones available" << std::endl;
-        for (auto &remainingLed : measurements) {
-            myLeds.emplace_back(m_impl->identifier.get(), remainingLed);
+        for (std::size_t i = 0, e = measurements.size(); i < e; ++i) {
+            if (!matcher.isMatched(i)) {
+                myLeds.emplace_back(m_impl->identifier.get(), measurements[i]);
+            }
         }
         return usedMeasurements;
     }
@@ -367,7 +413,22 @@ namespace vbtracker {
                                            m_targetToBody};
         switch (m_impl->trackingState) {
         case TargetTrackingState::RANSAC: {
-            m_hasPoseEstimate = m_impl->ransacEstimator(params, usableLeds());
+            /// If we just lost our fix, the body state (with any IMU
+            /// orientation applied since) is a good place to start looking.
+            auto seeded = validStateAndTime && m_impl->lostTracking;
+            m_hasPoseEstimate =
+                m_impl->ransacEstimator(params, usableLeds(), seeded);
+            m_impl->kalmanCorrected = false;
+            if (m_hasPoseEstimate && m_impl->lostTracking) {
+                m_impl->lostTracking = false;
+                auto lostFor = osvrTimeValueDurationSeconds(
+                    &tv, &m_impl->lostTrackingTime);
+                auto &stats = m_impl->reacquisitionStats;
+                stats.reacquisitions++;
+                stats.reacquireSeconds += lostFor;
+                stats.maxReacquireSeconds =
+                    std::max(stats.maxReacquireSeconds, lostFor);
+            }
             break;
         }
 
@@ -383,6 +444,7 @@ namespace vbtracker {
             m_hasPoseEstimate =
                 m_impl->kalmanEstimator(params, usableLeds(), tv, videoDt);
 #endif
+            m_impl->kalmanCorrected = true;
             break;
         }
         }
@@ -405,9 +467,11 @@ namespace vbtracker {
             switch (health) {
             case SCAATKalmanPoseEstimator::TrackingHealth::NeedsResetNow:
                 msg() << "In flight reset - lost fix..." << std::endl;
+                m_impl->kalmanCorrected = false;
                 enterRANSACMode();
                 break;
             case SCAATKalmanPoseEstimator::TrackingHealth::ResetWhenBeaconsSeen:
+                markTrackingLost();
                 m_impl->trackingState =
                     TargetTrackingState::RANSACWhenBlobDetected;
                 break;
@@ -423,6 +487,18 @@ namespace vbtracker {
             break;
         }
 
+        /// Work out where to look for our beacons in the next frame, while we
+        /// have the offset-corrected state handy.
+        m_impl->havePredictedRegions = false;
+        if (getParams().roiBlobExtraction && m_hasPoseEstimate &&
+            m_impl->trackingState == TargetTrackingState::Kalman) {
+            predictBlobRegions(
+                camParams, bodyState,
+                osvrTimeValueDurationSeconds(&tv, &m_impl->lastEstimate));
+            m_impl->havePredictedRegions = true;
+            m_impl->predictedRegionsFrame = tv;
+        }
+
         /// Update our local target-specific timestamp
         m_impl->lastEstimate = tv;
 
@@ -432,6 +508,19 @@ namespace vbtracker {
         return m_hasPoseEstimate;
     }
 
+    bool TrackedBodyTarget::lastEstimateWasKalmanCorrection() const {
+        return m_hasPoseEstimate && m_impl->kalmanCorrected;
+    }
+
+    ReacquisitionStats TrackedBodyTarget::getReacquisitionStats() const {
+        auto ret = m_impl->ransacEstimator.getStats();
+        auto const &reacquisition = m_impl->reacquisitionStats;
+        ret.reacquisitions = reacquisition.reacquisitions;
+        ret.reacquireSeconds = reacquisition.reacquireSeconds;
+        ret.maxReacquireSeconds = reacquisition.maxReacquireSeconds;
+        return ret;
+    }
+
     bool TrackedBodyTarget::uncalibratedRANSACPoseEstimateFromLeds(
         CameraParameters const &camParams, Eigen::Vector3d &xlate,
         Eigen::Quaterniond &quat) {
@@ -453,6 +542,83 @@ namespace vbtracker {
         return gotPose;
     }
 
+    bool TrackedBodyTarget::getPredictedBlobRegions(
+        osvr::util::time::TimeValue const &frame,
+        PredictedBlobRegions &regions) const {
+        if (!m_impl->havePredictedRegions ||
+            m_impl->predictedRegionsFrame != frame) {
+            return false;
+        }
+        regions.insert(end(regions), begin(m_impl->predictedRegions),
+                       end(m_impl->predictedRegions));
+        return true;
+    }
+
+    /// Longest we'll extrapolate to the next frame, in seconds: frames are
+    /// much closer together than this when tracking well.
+    static const double MAX_REGION_PREDICTION = 0.1;
+
+    /// How many frames ahead the regions must cover: when pipelined, blobs are
+    /// extracted from the frame after this one while this one's poses are
+    /// still being estimated, so the regions get used for the one after that.
+    static const double REGION_PREDICTION_FRAMES = 2.;
+
+    void TrackedBodyTarget::predictBlobRegions(
+        CameraParameters const &camParams, BodyState const &bodyState,
+        double dt) {
+        auto &regions = m_impl->predictedRegions;
+        regions.clear();
+        auto const &params = getParams();
+
+        /// Assume frames keep coming as long apart as this one did after the
+        /// last.
+        BodyState state = bodyState;
+        if (dt > 0) {
+            kalman::predict(state, getBody().getProcessModel(),
+                            REGION_PREDICTION_FRAMES *
+                                std::min(dt, MAX_REGION_PREDICTION));
+        }
+        Eigen::Quaterniond rot = state.getCombinedQuaternion();
+        Eigen::Vector3d xlate = state.position();
+        auto cov = state.errorCovariance().diagonal();
+        auto positionStdDev = std::sqrt(cov.head<3>().maxCoeff());
+        auto rotationStdDev = std::sqrt(cov.segment<3>(3).maxCoeff());
+        auto focalLength = camParams.focalLength();
+        Eigen::Vector2d principalPoint = camParams.eiPrincipalPoint();
+
+        /// Every beacon, seen lately or not, so ones coming into view are
+        /// found and can be identified.
+        for (auto const &beacon : m_beacons) {
+            Eigen::Vector3d objPoint = m_targetToBody + beacon->stateVector();
+            Eigen::Vector3d camPoint = rot * objPoint + xlate;
+            if (camPoint.z() <= 0) {
+                continue;
+            }
+            Eigen::Vector2d center =
+                projectPoint(focalLength, principalPoint, camPoint);
+            /// Position error, plus orientation error at this lever arm.
+            auto metricStdDev =
+                positionStdDev + rotationStdDev * objPoint.norm();
+            auto radius = params.roiMargin + params.roiSigmas * metricStdDev *
+                                                 focalLength / camPoint.z();
+            regions.push_back(
+                PredictedBlobRegion{cv::Point2d(center.x(), center.y()),
+                                    radius});
+        }
+
+        /// Blobs we're already following (identified or not) may move as far
+        /// each frame as the blob matcher allows.
+        for (auto const &led : leds()) {
+            auto loc = led.getLocation();
+            auto radius = std::max(params.roiMargin,
+                                   REGION_PREDICTION_FRAMES *
+                                       params.blobMoveThreshold *
+                                       led.getMeasurement().diameter);
+            regions.push_back(
+                PredictedBlobRegion{cv::Point2d(loc.x, loc.y), radius});
+        }
+    }
+
     Eigen::Vector3d TrackedBodyTarget::getStateCorrection() const {
         return m_impl->bodyInterface.state.getQuaternion() * m_beaconOffset;
     }
@@ -481,9 +647,11 @@ namespace vbtracker {
         case TargetTrackingState::Kalman:
             getBody().getState().angularVelocity() = Eigen::Vector3d::Zero();
             getBody().getState().velocity() = Eigen::Vector3d::Zero();
+            markTrackingLost();
             break;
         case TargetTrackingState::EnteringKalman:
             /// unlikely to have messed up velocity in one step. let it be.
+            markTrackingLost();
             break;
         default:
             break;
@@ -491,6 +659,13 @@ namespace vbtracker {
         m_impl->trackingState = TargetTrackingState::RANSAC;
     }
 
+    void TrackedBodyTarget::markTrackingLost() {
+        if (!m_impl->lostTracking) {
+            m_impl->lostTracking = true;
+            m_impl->lostTrackingTime = m_impl->lastEstimate;
+        }
+    }
+
     LedGroup const &TrackedBodyTarget::leds() const { return m_impl->leds; }
 
     LedPtrList const &TrackedBodyTarget::usableLeds() const {
@@ -32,6 +32,7 @@
 #include "BodyIdTypes.h"
 #include "BeaconSetupData.h"
 #include "ModelTypes.h"
+#include "ImageProcessing.h"
 
 // Library/third-party includes
 #include <osvr/Kalman/PureVectorState.h>
@@ -39,6 +40,7 @@
 #include <boost/assert.hpp>
 
 // Standard includes
+#include <cstdint>
 #include <vector>
 #include <iosfwd>
 
@@ -56,6 +58,33 @@ namespace vbtracker {
         void reset() { *this = BeaconData{}; }
     };
 
+    /// Counts of how RANSAC pose estimation has gone, and how long it has
+    /// taken to re-acquire targets after losing track of them.
+    struct ReacquisitionStats {
+        /// Calls to the estimator with enough beacons to try, and how many of
+        /// those found a pose.
+        std::uint64_t attempts = 0;
+        std::uint64_t successes = 0;
+        /// Attempts that tried a seed (the last known pose) as a hypothesis,
+        /// and how many of those needed no samples drawn because the seed
+        /// alone had enough inliers.
+        std::uint64_t seeded = 0;
+        std::uint64_t seedEarlyExits = 0;
+        /// Minimal-sample hypotheses tried.
+        std::uint64_t hypotheses = 0;
+        /// Sample searches cut short because a hypothesis had enough inliers.
+        std::uint64_t earlyExits = 0;
+        /// Times tracking was regained after being lost, and the time (by
+        /// video frame timestamps) it took: in total and the worst.
+        std::uint64_t reacquisitions = 0;
+        double reacquireSeconds = 0;
+        double maxReacquireSeconds = 0;
+    };
+
+    /// Prints the counts, and the mean and max time to re-acquire, on one
+    /// line.
+    std::ostream &operator<<(std::ostream &os, ReacquisitionStats const &stats);
+
     class TrackedBody;
     struct BodyTargetInterface;
     /// Corresponds to a rigid arrangements of discrete beacons detected by
@@ -127,12 +156,29 @@ namespace vbtracker {
             CameraParameters const &camParams, Eigen::Vector3d &xlate,
             Eigen::Quaterniond &quat);
 
+        /// If, as of its update from the given frame, this target is tracked
+        /// well enough to predict where its beacons will appear in upcoming
+        /// frames, appends those regions (and those of the blobs it is already
+        /// following) and returns true. Only computed when roiBlobExtraction
+        /// is enabled.
+        bool getPredictedBlobRegions(osvr::util::time::TimeValue const &frame,
+                                     PredictedBlobRegions &regions) const;
+
         /// Did this target yet, or last time it was asked to, compute a
         /// pose estimate?
         bool hasPoseEstimate() const { return m_hasPoseEstimate; }
 
+        /// Was the pose estimate from the last call to
+        /// updatePoseEstimateFromLeds() a Kalman correction of the state passed
+        /// in (as opposed to made from scratch, or discarded as unhealthy)?
+        bool lastEstimateWasKalmanCorrection() const;
+
         osvr::util::time::TimeValue const &getLastUpdate() const;
 
+        /// How RANSAC pose estimation has gone for this target, and how long
+        /// it took to get a fix back each time it lost one.
+        ReacquisitionStats getReacquisitionStats() const;
+
         /// Get the offset that was subtracted from all beacon positions upon
         /// initialization.
         Eigen::Vector3d const &getBeaconOffset() const {
@@ -152,9 +198,17 @@ namespace vbtracker {
         std::ostream &msg() const;
         void enterKalmanMode();
         void enterRANSACMode();
+        /// Notes the time of the last frame we had a fix in, unless we're
+        /// already without one.
+        void markTrackingLost();
 
         void dumpBeaconsToConsole() const;
 
+        /// Fills the predicted blob regions for upcoming frames, given the
+        /// (offset-corrected) body state and the dt since the last frame.
+        void predictBlobRegions(CameraParameters const &camParams,
+                                BodyState const &bodyState, double dt);
+
         LedGroup &leds();
 
         /// Update usableLeds() from leds()
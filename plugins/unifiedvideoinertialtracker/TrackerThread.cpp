@@ -29,28 +29,44 @@
 #include "SpaceTransformations.h"
 
 // Library/third-party includes
-#include <osvr/Util/Finally.h>
 #include <osvr/Util/EigenInterop.h>
 
 // Standard includes
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <future>
+#include <thread>
+#include <utility>
 
 #define OSVR_TRACKER_THREAD_WRAP_WITH_TRY
 
 namespace osvr {
 namespace vbtracker {
+    /// @brief Delay before retrying after the first failure to capture a
+    /// frame: doubled with each further consecutive failure, up to
+    /// CAPTURE_RETRY_MAX.
+    static const std::chrono::milliseconds CAPTURE_RETRY_MIN(10);
+    static const std::chrono::milliseconds CAPTURE_RETRY_MAX(320);
+
     TrackerThread::TrackerThread(TrackingSystem &trackingSystem,
                                  ImageSource &imageSource,
                                  BodyReportingVector &reportingVec,
                                  CameraParameters const &camParams)
         : m_trackingSystem(trackingSystem), m_cam(imageSource),
           m_reportingVec(reportingVec), m_camParams(camParams) {
+        for (auto &frame : m_frames) {
+            m_freeFrames.push(&frame);
+        }
         msg() << "Tracker thread object created." << std::endl;
     }
     TrackerThread::~TrackerThread() {
-        if (m_imageThread.joinable()) {
-            m_imageThread.join();
+        stopPipeline();
+        if (m_captureThread.joinable()) {
+            m_captureThread.join();
+        }
+        if (m_extractionThread.joinable()) {
+            m_extractionThread.join();
         }
     }
 
@@ -58,6 +74,23 @@ namespace vbtracker {
         m_startupSignal.set_value();
     }
 
+    template <typename F>
+    void TrackerThread::runStage(const char *name, F &&f) {
+#ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
+        try {
+#endif
+            std::forward<F>(f)();
+#ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
+        } catch (std::exception const &e) {
+            warn() << name << ": exiting because of caught exception: "
+                   << e.what() << std::endl;
+            stopPipeline();
+        }
+#else
+        (void)name;
+#endif
+    }
+
     void TrackerThread::threadAction() {
         /// The thread internally is organized around processing video frames,
         /// with arrival of IMU reports internally handled as they come. Thus,
@@ -72,40 +105,73 @@ namespace vbtracker {
         msg() << "Tracker thread object entering its main execution loop."
               << std::endl;
 
-#ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
-        try {
-#endif
-            bool keepGoing = true;
-            while (keepGoing) {
-                doFrame();
-
+        m_captureThread = std::thread{[&] {
+            runStage("capture thread", [&] { captureThreadAction(); });
+        }};
+        m_extractionThread = std::thread{[&] {
+            runStage("extraction worker", [&] { extractionThreadAction(); });
+        }};
+
+        runStage("tracker thread object", [&] {
+            while (running()) {
+                PipelineFrame *frame = nullptr;
+                MessageEntry message = boost::none;
                 {
-                    /// Copy the run flag.
-                    std::lock_guard<std::mutex> lock(m_runMutex);
-                    keepGoing = m_run;
-                }
-                if (!keepGoing) {
-                    msg() << "Tracker thread object: Just checked our run flag "
-                             "and noticed it turned false..."
-                          << std::endl;
+                    /// Wait for something to do (an extracted frame, IMU
+                    /// reports)
+                    std::unique_lock<std::mutex> lock(m_messageMutex);
+                    m_messageCondVar.wait(lock, [&] {
+                        return !running() ||
+                               m_extractedFrames.read_available() > 0 ||
+                               !m_messages.empty();
+                    });
+                    if (!m_extractedFrames.pop(frame) && !m_messages.empty()) {
+                        // OK, we have some IMU reports to keep us busy in the
+                        // meantime. Grab the first one and we'll process it
+                        // while not holding the mutex.
+                        message = m_messages.front();
+                        m_messages.pop();
+                    }
+                } // unlock
+
+                if (frame) {
+                    estimateFrame(*frame);
+                    /// Hand the frame back to be filled again.
+                    m_freeFrames.push(frame);
+                    m_captureWakeup.notify();
+                } else if (!message.empty()) {
+                    processIMUMessage(message);
                 }
             }
-#ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
-        } catch (std::exception const &e) {
-            warn() << "Tracker thread object: exiting because of caught "
-                      "exception: "
-                   << e.what() << std::endl;
-            m_run = false;
-        }
-#endif
+            msg() << "Tracker thread object: Just checked our run flag "
+                     "and noticed it turned false..."
+                  << std::endl;
+        });
+
+        stopPipeline();
+        m_captureThread.join();
+        m_extractionThread.join();
         msg() << "Tracker thread object: functor exiting." << std::endl;
     }
 
+    void TrackerThread::stopPipeline() {
+        m_run = false;
+        m_captureWakeup.notify();
+        m_extractionWakeup.notify();
+        {
+            std::lock_guard<std::mutex> lock(m_messageMutex);
+        }
+        m_messageCondVar.notify_one();
+    }
+
+    PipelineLatencyData TrackerThread::getLatencyData() const {
+        return m_latency.getData();
+    }
+
     void TrackerThread::triggerStop() {
         /// Main thread method!
         msg() << "Tracker thread object: triggerStop() called" << std::endl;
-        std::lock_guard<std::mutex> lock(m_runMutex);
-        m_run = false;
+        stopPipeline();
     }
 
     void TrackerThread::submitIMUReport(TrackedBodyIMU &imu,
@@ -134,81 +200,118 @@ namespace vbtracker {
         return std::cout << "[UnifiedTracker] ";
     }
     std::ostream &TrackerThread::warn() const { return msg() << "Warning: "; }
-    void TrackerThread::doFrame() {
-        // Check camera status.
-        if (!m_cam.ok()) {
-            // Hmm, camera seems bad. Might regain it? Skip for now...
-            warn() << "Camera is reporting it is not OK." << std::endl;
-            return;
-        }
-        // Trigger a grab.
-        if (!m_cam.grab()) {
-            // Again failing without quitting, in hopes we get better luck
-            // next time...
-            warn() << "Camera grab failed." << std::endl;
-            return;
+    void TrackerThread::captureThreadAction() {
+        /// Consecutive failed capture attempts: used to back off, and to warn
+        /// once per run of failures instead of on every attempt.
+        std::size_t failures = 0;
+        auto backOff = [&](const char *problem) {
+            if (failures == 0) {
+                warn() << problem << " Will keep retrying." << std::endl;
+            }
+            ++failures;
+            auto delay = CAPTURE_RETRY_MIN *
+                         (1 << std::min<std::size_t>(failures - 1, 5));
+            std::this_thread::sleep_for(std::min(delay, CAPTURE_RETRY_MAX));
+        };
+        while (running()) {
+            PipelineFrame *frame = nullptr;
+            m_captureWakeup.wait(
+                [&] { return !running() || m_freeFrames.pop(frame); });
+            if (!frame) {
+                break;
+            }
+            /// Keep trying this frame slot until we fill it or are stopped.
+            bool captured = false;
+            while (!captured && running()) {
+                // Check camera status.
+                if (!m_cam.ok()) {
+                    // Hmm, camera seems bad. Might regain it? Skip for now...
+                    backOff("Camera is reporting it is not OK.");
+                    continue;
+                }
+                // Trigger a grab.
+                if (!m_cam.grab()) {
+                    // Again failing without quitting, in hopes we get better
+                    // luck next time...
+                    backOff("Camera grab failed.");
+                    continue;
+                }
+                // When we triggered the grab is our current best guess of the
+                // time for the image
+                /// @todo backdate to account for image transfer image,
+                /// exposure time, etc.
+                frame->tv = util::time::getNow();
+                frame->grabbed = PipelineClock::now();
+
+                /// Release the previous images rather than retrieving into
+                /// them: the tracking system may still be holding on to them
+                /// from the last time this slot came through.
+                frame->frame = cv::Mat();
+                frame->frameGray = cv::Mat();
+                m_cam.retrieve(frame->frame, frame->frameGray);
+                if (!frame->frame.data || !frame->frameGray.data) {
+                    backOff("Camera retrieve appeared to fail: frames had "
+                            "null pointers!");
+                    continue;
+                }
+                frame->retrieved = PipelineClock::now();
+                captured = true;
+                if (failures > 0) {
+                    msg() << "Camera capture recovered after " << failures
+                          << " failed attempts." << std::endl;
+                    failures = 0;
+                }
+            }
+            if (!captured) {
+                break;
+            }
+            m_capturedFrames.push(frame);
+            m_extractionWakeup.notify();
         }
-        // When we triggered the grab is our current best guess of the time
-        // for the image
-        /// @todo backdate to account for image transfer image, exposure
-        /// time, etc.
-        m_triggerTime = util::time::getNow();
-
-        /// Launch an asynchronous task to perform the image retrieval and
-        /// initial image processing.
-        launchTimeConsumingImageStep();
-
-        bool finishedImage = false;
-        do {
+    }
 
-            MessageEntry message = boost::none;
+    void TrackerThread::extractionThreadAction() {
+        while (running()) {
+            PipelineFrame *frame = nullptr;
+            m_extractionWakeup.wait(
+                [&] { return !running() || m_capturedFrames.pop(frame); });
+            if (!frame) {
+                break;
+            }
+            frame->extractionBegin = PipelineClock::now();
+            frame->imageData = m_trackingSystem.performInitialImageProcessing(
+                frame->tv, frame->frame, frame->frameGray, m_camParams);
+            frame->extracted = PipelineClock::now();
+            m_extractedFrames.push(frame);
             {
-                /// Wait for something to do (Completion of image, IMU reports)
-                std::unique_lock<std::mutex> lock(m_messageMutex);
-                m_messageCondVar.wait(lock, [&] {
-                    return m_timeConsumingImageStepComplete ||
-                           !m_messages.empty();
-                });
-                if (m_timeConsumingImageStepComplete) {
-                    /// Set a flag to get us out of this innermost loop - we'll
-                    /// finish up processing this frame and trigger another grab
-                    /// before we look at more IMU data.
-                    finishedImage = true;
-                } else {
-                    // OK, we have some IMU reports to keep us busy in the
-                    // meantime. Grab the first one and we'll process it while
-                    // not holding the mutex.
-                    message = m_messages.front();
-                    m_messages.pop();
-                }
-            } // unlock
-
-            if (!message.empty()) {
-                processIMUMessage(message);
+                /// Can't get in between the estimation thread checking for
+                /// work and going to sleep.
+                std::lock_guard<std::mutex> lock(m_messageMutex);
             }
-        } while (!finishedImage);
-
-        // OK, once we get here, we know the timeConsumingImageStep is complete.
-        if (!m_frame.data || !m_frameGray.data) {
-            // but it ended early due to error.
-            warn() << "Camera retrieve appeared to fail: frames had null "
-                      "pointers!"
-                   << std::endl;
-            return;
+            m_messageCondVar.notify_one();
         }
+    }
 
-        if (!m_imageData) {
+    void TrackerThread::estimateFrame(PipelineFrame &frame) {
+        auto estimationBegin = PipelineClock::now();
+        if (!frame.imageData) {
             // but it failed to set the pointer? this is very strange...
             warn() << "Initial image processing failed somehow!" << std::endl;
             return;
         }
 
         // Submit initial image data to the tracking system.
-        auto bodyIds =
-            m_trackingSystem.updateBodiesFromVideoData(std::move(m_imageData));
-        m_imageData.reset();
+        auto bodyIds = m_trackingSystem.updateBodiesFromVideoData(
+            std::move(frame.imageData));
+        frame.imageData.reset();
 
-        // Process any accumulated IMU messages so we don't get backed up.
+        processAllIMUMessages();
+
+        updateReportingVector(bodyIds);
+        m_latency.recordFrame(frame, estimationBegin, PipelineClock::now());
+    }
+
+    void TrackerThread::processAllIMUMessages() {
         std::vector<MessageEntry> imuMessages;
         {
             // Copy out messages inside the mutex.
@@ -226,9 +329,8 @@ namespace vbtracker {
         for (auto const &msg : imuMessages) {
             processIMUMessage(msg);
         }
-
-        updateReportingVector(bodyIds);
     }
+
     class IMUMessageProcessor : public boost::static_visitor<> {
       public:
         void operator()(boost::none_t const &) const {
@@ -338,39 +440,5 @@ namespace vbtracker {
             }
         }
     }
-    void TrackerThread::launchTimeConsumingImageStep() {
-        if (m_imageThread.joinable()) {
-            m_imageThread.join();
-        }
-        /// Our thread would be the only one reading or writing this flag at
-        /// this point, so it's OK now to write this without protection.
-        m_timeConsumingImageStepComplete = false;
-        m_imageThread = std::thread{[&] { timeConsumingImageStep(); }};
-    }
-    void TrackerThread::timeConsumingImageStep() {
-        /// When we return from this function, set a flag indicating we're done
-        /// and notify on the condition variable.
-
-        auto signalCompletion = util::finally([&] {
-            {
-                std::lock_guard<std::mutex> lock{m_messageMutex};
-                m_timeConsumingImageStepComplete = true;
-            }
-            m_messageCondVar.notify_one();
-        });
-
-        // Pull the image into an OpenCV matrix named m_frame.
-        m_cam.retrieve(m_frame, m_frameGray);
-        if (!m_frame.data || !m_frameGray.data) {
-            // let the tracker thread warn if it wants to, we'll just get
-            // out.
-            return;
-        }
-
-        // Do the slow, but intentionally async-able part of the image
-        // processing.
-        m_imageData = m_trackingSystem.performInitialImageProcessing(
-            m_triggerTime, m_frame, m_frameGray, m_camParams);
-    }
 } // namespace vbtracker
 } // namespace osvr
@@ -29,6 +29,7 @@
 #include "TrackingSystem.h"
 #include "ThreadsafeBodyReporting.h"
 #include "CameraParameters.h"
+#include "FramePipeline.h"
 
 #include "ImageSources/ImageSource.h"
 
@@ -41,6 +42,8 @@
 #include <boost/variant.hpp>
 
 // Standard includes
+#include <array>
+#include <atomic>
 #include <iosfwd>
 #include <queue>
 #include <thread>
@@ -63,6 +66,18 @@ namespace vbtracker {
     using MessageEntry = boost::variant<boost::none_t, TimestampedOrientation,
                                         TimestampedAngVel>;
 
+    /// Runs the tracker as a pipeline of three threads, connected by bounded
+    /// lock-free queues of frames carrying their timestamps:
+    ///
+    /// - a capture thread grabbing and retrieving camera frames,
+    /// - a blob extraction worker performing the initial image processing,
+    ///   and
+    /// - the thread calling threadAction(), which updates the bodies from
+    ///   video and IMU data and publishes the results.
+    ///
+    /// With one camera, one extraction worker is all the tracking system can
+    /// use, since it keeps a single blob extractor; with it, extraction of a
+    /// frame overlaps pose estimation from the previous one.
     class TrackerThread : boost::noncopyable {
       public:
         TrackerThread(TrackingSystem &trackingSystem, ImageSource &imageSource,
@@ -92,30 +107,46 @@ namespace vbtracker {
                              OSVR_AngularVelocityReport const &report);
         /// @}
 
+        /// Gets the latency histogram of each pipeline stage, over the frames
+        /// processed so far. May be called from any thread.
+        PipelineLatencyData getLatencyData() const;
+
       private:
         /// Helper providing a prefixed output stream for normal messages.
         std::ostream &msg() const;
         /// Helper providing a prefixed output stream for warning messages.
         std::ostream &warn() const;
 
-        /// Main function called repeatedly, once for each (attempted) frame of
-        /// video.
-        void doFrame();
+        bool running() const { return m_run.load(); }
+        /// Clears the run flag and wakes up all pipeline stages so they see
+        /// it.
+        void stopPipeline();
 
-        /// Copy updated body state into the reporting vector.
-        void updateReportingVector(BodyIndices const &bodyIds);
+        /// Main function of the capture thread: grabs and retrieves frames
+        /// into free frame slots, passing them to the extraction worker.
+        void captureThreadAction();
 
-        /// This function is responsible for launching the descriptively-named
-        /// timeConsumingImageStep() asynchronously.
-        void launchTimeConsumingImageStep();
+        /// Main function of the extraction worker: performs the slow,
+        /// intentionally async-able initial image processing on each captured
+        /// frame, passing it to the estimation thread.
+        void extractionThreadAction();
 
-        /// The "time consuming image step" - specifically, retrieving the image
-        /// and performing the initial blob detection on it. This gets launched
-        /// asynchronously by launchTimeConsumingImageStep()
-        void timeConsumingImageStep();
+        /// Runs a thread's main function, stopping the whole pipeline if it
+        /// exits because of an exception.
+        template <typename F> void runStage(const char *name, F &&f);
+
+        /// Estimation thread: updates the bodies from a frame that has been
+        /// through blob extraction, then publishes the results.
+        void estimateFrame(PipelineFrame &frame);
+
+        /// Copy updated body state into the reporting vector.
+        void updateReportingVector(BodyIndices const &bodyIds);
 
         void processIMUMessage(MessageEntry const &m);
 
+        /// Processes any accumulated IMU messages, so we don't get backed up.
+        void processAllIMUMessages();
+
         TrackingSystem &m_trackingSystem;
         ImageSource &m_cam;
         BodyReportingVector &m_reportingVec;
@@ -124,39 +155,42 @@ namespace vbtracker {
         using our_clock = std::chrono::steady_clock;
         boost::optional<our_clock::time_point> m_nextCameraPoseReport;
 
-        /// Time that the last camera grab was triggered.
-        util::time::TimeValue m_triggerTime;
-
         /// a void promise, as suggested by Scott Meyers, to hold the thread
         /// operation at the beginning until we want it to really start running.
         std::promise<void> m_startupSignal;
 
         bool m_setCameraPose = false;
 
-        /// @name Updated asynchronously by timeConsumingImageStep()
-        /// @{
-        cv::Mat m_frame;
-        cv::Mat m_frameGray;
-        ImageOutputDataPtr m_imageData;
-        /// @}
+        /// Run flag
+        std::atomic<bool> m_run{true};
 
-        /// @name Run flag
+        /// @name Frame pipeline
         /// @{
-        std::mutex m_runMutex;
-        bool m_run = true;
+        /// One frame for each stage: enough for each to work on one
+        /// concurrently.
+        static const std::size_t PIPELINE_DEPTH = 3;
+        std::array<PipelineFrame, PIPELINE_DEPTH> m_frames;
+        /// Estimation thread to capture thread.
+        PipelineFrameQueue m_freeFrames{PIPELINE_DEPTH};
+        PipelineWakeup m_captureWakeup;
+        /// Capture thread to extraction worker.
+        PipelineFrameQueue m_capturedFrames{PIPELINE_DEPTH};
+        PipelineWakeup m_extractionWakeup;
+        /// Extraction worker to estimation thread, which is also woken by IMU
+        /// messages - see m_messageCondVar.
+        PipelineFrameQueue m_extractedFrames{PIPELINE_DEPTH};
+        PipelineLatency m_latency;
+        std::thread m_captureThread;
+        std::thread m_extractionThread;
         /// @}
 
-        /// @name Message queue for async image processing and receiving IMU
-        /// reports from other threads.
+        /// @name Message queue for receiving IMU reports from other threads
+        /// and notice of extracted frames.
         /// @{
         std::condition_variable m_messageCondVar;
         std::mutex m_messageMutex;
         std::queue<MessageEntry> m_messages;
-        bool m_timeConsumingImageStepComplete = false;
         /// @}
-
-        /// The thread used by timeConsumingImageStep()
-        std::thread m_imageThread;
     };
 } // namespace vbtracker
 } // namespace osvr
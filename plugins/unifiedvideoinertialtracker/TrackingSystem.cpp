@@ -27,6 +27,8 @@
 #include "TrackedBody.h"
 #include "TrackedBodyTarget.h"
 #include "UndistortMeasurements.h"
+#include "CameraDistortionModel.h"
+#include "cvToEigen.h"
 #include "ForEachTracked.h"
 #include "TrackingSystem_Impl.h"
 #include "SBDBlobExtractor.h"
@@ -39,8 +41,10 @@
 
 // Standard includes
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <stdexcept>
 
@@ -63,6 +67,47 @@ namespace vbtracker {
         return getBody(target.first).getTarget(target.second);
     }
 
+    /// Bounds, in the raw (distorted) image, of the given undistorted circular
+    /// regions, clipped to the image.
+    static std::vector<cv::Rect>
+    getDistortedRegionBounds(PredictedBlobRegions const &regions,
+                             CameraParameters const &camParams) {
+        auto distortionModel = CameraDistortionModel{
+            Eigen::Vector2d{camParams.focalLengthX(), camParams.focalLengthY()},
+            cvToVector(camParams.principalPoint()),
+            Eigen::Vector3d{camParams.k1(), camParams.k2(), camParams.k3()}};
+        auto imageBounds = cv::Rect(cv::Point(0, 0), camParams.imageSize);
+        std::vector<cv::Rect> ret;
+        ret.reserve(regions.size());
+        for (auto const &region : regions) {
+            Eigen::Vector2d center = cvToVector(region.center);
+            Eigen::Vector2d lo = center.array() - region.radius;
+            Eigen::Vector2d hi = center.array() + region.radius;
+            /// Distortion is radial, so the extremes of the region along each
+            /// axis bound the distorted region closely enough.
+            Eigen::Vector2d extremes[] = {Eigen::Vector2d(lo.x(), center.y()),
+                                          Eigen::Vector2d(hi.x(), center.y()),
+                                          Eigen::Vector2d(center.x(), lo.y()),
+                                          Eigen::Vector2d(center.x(), hi.y())};
+            Eigen::Vector2d minPt = distortionModel.distortPoint(extremes[0]);
+            Eigen::Vector2d maxPt = minPt;
+            for (auto const &pt : extremes) {
+                Eigen::Vector2d distorted = distortionModel.distortPoint(pt);
+                minPt = minPt.cwiseMin(distorted);
+                maxPt = maxPt.cwiseMax(distorted);
+            }
+            auto topLeft = cv::Point(int(std::floor(minPt.x())),
+                                     int(std::floor(minPt.y())));
+            auto bottomRight = cv::Point(int(std::ceil(maxPt.x())) + 1,
+                                         int(std::ceil(maxPt.y())) + 1);
+            auto rect = cv::Rect(topLeft, bottomRight) & imageBounds;
+            if (rect.area() > 0) {
+                ret.push_back(rect);
+            }
+        }
+        return ret;
+    }
+
     ImageOutputDataPtr TrackingSystem::performInitialImageProcessing(
         util::time::TimeValue const &tv, cv::Mat const &frame,
         cv::Mat const &frameGray, CameraParameters const &camParams) {
@@ -72,8 +117,31 @@ namespace vbtracker {
         ret->frame = frame;
         ret->frameGray = frameGray;
         ret->camParams = camParams.createUndistortedVariant();
-        auto rawMeasurements =
-            m_impl->blobExtractor->extractBlobs(ret->frameGray);
+        auto &impl = *m_impl;
+        bool scanFullFrame;
+        {
+            std::lock_guard<std::mutex> lock(impl.blobPlanMutex);
+            scanFullFrame = impl.scanFullFrame;
+            if (scanFullFrame) {
+                ++impl.blobExtractionStats.fullFrames;
+            } else {
+                ++impl.blobExtractionStats.roiFrames;
+                impl.extractionRegions.assign(begin(impl.blobRegions),
+                                              end(impl.blobRegions));
+            }
+        }
+        LedMeasurementVec rawMeasurements;
+        {
+            std::lock_guard<std::mutex> lock(impl.blobExtractorMutex);
+            if (scanFullFrame) {
+                rawMeasurements = impl.blobExtractor->extractBlobs(
+                    ret->frameGray);
+            } else {
+                rawMeasurements = impl.blobExtractor->extractBlobs(
+                    ret->frameGray, getDistortedRegionBounds(
+                                        impl.extractionRegions, camParams));
+            }
+        }
         ret->ledMeasurements = undistortLeds(rawMeasurements, camParams);
         return ret;
     }
@@ -92,14 +160,24 @@ namespace vbtracker {
         m_impl->camParams = imageData->camParams;
         m_impl->lastFrame = imageData->tv;
 
-        /// Go through each target and try to process the measurements.
+        /// Go through each target and try to process the measurements: each
+        /// target only touches its own LEDs, so they can go in parallel.
+        auto &targets = m_impl->estimationTargets;
+        targets.clear();
         forEachTarget(*this, [&](TrackedBodyTarget &target) {
-            auto usedMeasurements =
-                target.processLedMeasurements(imageData->ledMeasurements);
-            if (usedMeasurements != 0) {
-                updateCount[target.getQualifiedId()] = usedMeasurements;
-            }
+            targets.push_back(&target);
         });
+        auto &usedMeasurements = m_impl->estimationResults;
+        usedMeasurements.assign(targets.size(), 0);
+        auto const &leds = imageData->ledMeasurements;
+        m_impl->estimationPool->run(targets.size(), [&](std::size_t i) {
+            usedMeasurements[i] = targets[i]->processLedMeasurements(leds);
+        });
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            if (usedMeasurements[i] != 0) {
+                updateCount[targets[i]->getQualifiedId()] = usedMeasurements[i];
+            }
+        }
         return updateCount;
     }
 
@@ -111,6 +189,9 @@ namespace vbtracker {
         /// Do the third phase of tracking.
         updatePoseEstimates();
 
+        /// Decide where to look for blobs in the next frame.
+        planBlobExtraction();
+
         /// Trigger debug display, if activated.
         m_impl->triggerDebugDisplay(*this);
 
@@ -129,6 +210,30 @@ namespace vbtracker {
                                    "LEDs from data this frame.");
         }
     }
+    /// Third phase of tracking for a single target with measurements.
+    ///
+    /// @return true if a pose was estimated.
+    static bool updatePoseEstimate(TrackedBodyTarget &target,
+                                   CameraParameters const &camParams,
+                                   util::time::TimeValue const &newTime) {
+        auto &body = target.getBody();
+        util::time::TimeValue stateTime = {};
+        BodyState state;
+        auto validState = body.getStateAtOrBefore(newTime, stateTime, state);
+        auto initialTime = stateTime;
+
+        auto gotPose = target.updatePoseEstimateFromLeds(
+            camParams, newTime, state, stateTime, validState);
+        if (gotPose) {
+            if (target.lastEstimateWasKalmanCorrection()) {
+                body.correctStateSnapshot(initialTime, newTime, state);
+            } else {
+                body.replaceStateSnapshot(initialTime, newTime, state);
+            }
+        }
+        return gotPose;
+    }
+
     void TrackingSystem::updatePoseEstimates() {
         if (!isRoomCalibrationComplete()) {
             /// If we need calibration, we need calibration. Go get it done.
@@ -136,41 +241,114 @@ namespace vbtracker {
             return;
         }
 
-        auto const &updateCount = m_impl->updateCount;
-        for (auto &bodyTargetWithMeasurements : updateCount) {
+        auto &impl = *m_impl;
+        auto &targets = impl.estimationTargets;
+        targets.clear();
+        for (auto &bodyTargetWithMeasurements : impl.updateCount) {
             auto targetPtr = getTarget(bodyTargetWithMeasurements.first);
             validateTargetPointerFromUpdateList(targetPtr);
-            auto &target = *targetPtr;
+            targets.push_back(targetPtr);
+        }
+        /// The update count is unordered: sort so the bodies come out in the
+        /// same order every time, however the work gets split up.
+        std::sort(targets.begin(), targets.end(),
+                  [](TrackedBodyTarget *a, TrackedBodyTarget *b) {
+                      auto idA = a->getQualifiedId();
+                      auto idB = b->getQualifiedId();
+                      return std::make_pair(idA.first.value(),
+                                            idA.second.value()) <
+                             std::make_pair(idB.first.value(),
+                                            idB.second.value());
+                  });
+
+        /// Targets of a body share its state, so it's the bodies that get
+        /// estimated in parallel: one task per body, its targets in order.
+        auto &bodyStarts = impl.estimationBodyStarts;
+        bodyStarts.clear();
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            if (i == 0 ||
+                &targets[i]->getBody() != &targets[i - 1]->getBody()) {
+                bodyStarts.push_back(i);
+            }
+        }
+        bodyStarts.push_back(targets.size());
+
+        auto &gotPose = impl.estimationResults;
+        gotPose.assign(targets.size(), 0);
+        auto const &camParams = impl.camParams;
+        auto const &newTime = impl.lastFrame;
+        impl.estimationPool->run(bodyStarts.size() - 1, [&](std::size_t b) {
+            for (auto i = bodyStarts[b]; i < bodyStarts[b + 1]; ++i) {
+                gotPose[i] =
+                    updatePoseEstimate(*targets[i], camParams, newTime);
+            }
+        });
 
-            /// @todo right now assumes one target per body here!
-            auto &body = target.getBody();
-            util::time::TimeValue stateTime = {};
-            BodyState state;
-            auto newTime = m_impl->lastFrame;
-            auto validState =
-                body.getStateAtOrBefore(newTime, stateTime, state);
-            auto initialTime = stateTime;
-
-            auto gotPose = target.updatePoseEstimateFromLeds(
-                m_impl->camParams, newTime, state, stateTime, validState);
-            if (gotPose) {
-                body.replaceStateSnapshot(initialTime, newTime, state);
-#if 0
-                static auto s = ::util::Stride{101};
-                if (++s) {
-                    std::cout << body.getState().position().transpose() << "\n";
-                }
-#endif
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            if (gotPose[i]) {
                 /// @todo deduplicate in making this list.
-                m_updated.push_back(body.getId());
+                m_updated.push_back(targets[i]->getBody().getId());
             }
         }
+
         /// Prune history after video update.
         for (auto &body : m_bodies) {
             body->pruneHistory();
         }
     }
 
+    void TrackingSystem::planBlobExtraction() {
+        auto &impl = *m_impl;
+        /// The previous plan stays in effect until this one is complete: with
+        /// the tracker thread pipelined, the next frame is usually being
+        /// extracted right now, and its regions were predicted to cover it.
+        auto &regions = impl.plannedRegions;
+        regions.clear();
+        auto scanFullFrame = [&] {
+            if (!m_params.roiBlobExtraction || !isRoomCalibrationComplete()) {
+                return true;
+            }
+            /// Periodically look everywhere, to find targets coming into view
+            /// and recover from any we've lost track of without noticing.
+            if (++impl.framesSinceFullFrame >=
+                std::size_t(std::max(m_params.roiFullFrameInterval, 1))) {
+                impl.framesSinceFullFrame = 0;
+                return true;
+            }
+            /// Every target must be tracked to skip a full scan: otherwise
+            /// we'd never find those that aren't.
+            bool allPredicted = true;
+            forEachTarget(*this, [&](TrackedBodyTarget &target) {
+                allPredicted =
+                    allPredicted &&
+                    target.getPredictedBlobRegions(impl.lastFrame, regions);
+            });
+            if (!allPredicted) {
+                impl.framesSinceFullFrame = 0;
+                return true;
+            }
+            return false;
+        }();
+        if (scanFullFrame) {
+            regions.clear();
+        }
+        std::lock_guard<std::mutex> lock(impl.blobPlanMutex);
+        impl.scanFullFrame = scanFullFrame;
+        std::swap(impl.blobRegions, regions);
+    }
+
+    BlobExtractionStats TrackingSystem::getBlobExtractionStats() const {
+        std::lock_guard<std::mutex> lock(m_impl->blobPlanMutex);
+        return m_impl->blobExtractionStats;
+    }
+
+    std::ostream &operator<<(std::ostream &os,
+                             BlobExtractionStats const &stats) {
+        os << stats.fullFrames << " full frames, " << stats.roiFrames
+           << " frames searched only around predicted beacons";
+        return os;
+    }
+
     void TrackingSystem::calibrationVideoPhaseThree() {
         auto const &updateCount = m_impl->updateCount;
         for (auto &bodyTargetWithMeasurements : updateCount) {
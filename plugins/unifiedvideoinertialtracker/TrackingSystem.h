@@ -41,6 +41,8 @@
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <cstdint>
+#include <iosfwd>
 #include <unordered_map>
 
 namespace osvr {
@@ -51,6 +53,18 @@ namespace vbtracker {
 
     using LedUpdateCount = std::unordered_map<BodyTargetId, std::size_t>;
 
+    /// Counts of frames searched for blobs in full and only around predicted
+    /// beacons: with roiBlobExtraction on and the targets tracked, most
+    /// frames should be the latter.
+    struct BlobExtractionStats {
+        std::uint64_t fullFrames = 0;
+        std::uint64_t roiFrames = 0;
+    };
+
+    /// Prints the counts on one line.
+    std::ostream &operator<<(std::ostream &os,
+                             BlobExtractionStats const &stats);
+
     class TrackingSystem {
       public:
         /// @name Setup and Teardown
@@ -65,6 +79,15 @@ namespace vbtracker {
         /// Perform the initial phase of image processing. This does not modify
         /// the bodies, so it can happen in parallel/background processing. It's
         /// also the most expensive, so that's handy.
+        ///
+        /// When roiBlobExtraction is enabled and every target was tracked in
+        /// a recent frame, only searches for blobs around where the latest
+        /// call to updateBodiesFromVideoData() predicted they'd be.
+        ///
+        /// May run on one other thread, concurrently with the second and third
+        /// phases for an earlier frame, so a pipelined caller can extract
+        /// blobs from one frame while estimating poses from the previous one.
+        /// (Calls to this method must not overlap each other, though.)
         ImageOutputDataPtr performInitialImageProcessing(
             util::time::TimeValue const &tv, cv::Mat const &frame,
             cv::Mat const &frameGray, CameraParameters const &camParams);
@@ -122,6 +145,8 @@ namespace vbtracker {
             return *m_bodies.at(i.value());
         }
         TrackedBodyTarget *getTarget(BodyTargetId target);
+        /// Thread-safe.
+        BlobExtractionStats getBlobExtractionStats() const;
         /// @}
 
         /// @todo refactor;
@@ -156,6 +181,10 @@ namespace vbtracker {
         /// calibration is incomplete.
         void calibrationVideoPhaseThree();
 
+        /// Decides, once pose estimates are updated, whether the next frame
+        /// can be searched only around the predicted blob locations.
+        void planBlobExtraction();
+
         using BodyPtr = std::unique_ptr<TrackedBody>;
         ConfigParams m_params;
 
@@ -31,7 +31,8 @@
 // - none
 
 // Standard includes
-// - none
+#include <algorithm>
+#include <thread>
 
 namespace osvr {
 namespace vbtracker {
@@ -41,13 +42,22 @@ namespace vbtracker {
           debugDisplay(new TrackingDebugDisplay(params)),
           calib(Eigen::Vector3d(params.cameraPosition), params.cameraIsForward),
           cameraPose(Eigen::Isometry3d::Identity()),
-          cameraPoseInv(Eigen::Isometry3d::Identity()) {}
+          cameraPoseInv(Eigen::Isometry3d::Identity()) {
+        blobExtractor->enableDebugImages(params.debug);
+        auto estimationThreads = params.bodyEstimationThreads;
+        if (estimationThreads <= 0) {
+            estimationThreads = int(std::thread::hardware_concurrency());
+        }
+        estimationPool.reset(
+            new ParallelTaskPool(std::size_t(std::max(estimationThreads, 1))));
+    }
 
     TrackingSystem::Impl::~Impl() {
         // out line to break circular dep with this and the debug display.
     }
 
     void TrackingSystem::Impl::triggerDebugDisplay(TrackingSystem &tracking) {
+        std::lock_guard<std::mutex> lock(blobExtractorMutex);
         debugDisplay->triggerDisplay(tracking, *this);
     }
 } // namespace vbtracker
@@ -30,6 +30,8 @@
 #include "CameraParameters.h"
 #include "ConfigParams.h"
 #include "RoomCalibration.h"
+#include "ImageProcessing.h"
+#include "ParallelTaskPool.h"
 
 // Library/third-party includes
 #include <osvr/Util/TimeValue.h>
@@ -38,12 +40,16 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
     class TrackingDebugDisplay;
     class SBDBlobExtractor;
+    class TrackedBodyTarget;
     /// Private implementation structure for TrackingSystem
     struct TrackingSystem::Impl : private boost::noncopyable {
         Impl(ConfigParams const &params);
@@ -70,6 +76,45 @@ namespace vbtracker {
         RoomCalibration calib;
 
         LedUpdateCount updateCount;
+
+        /// Runs the per-body parts of the second and third phases.
+        std::unique_ptr<ParallelTaskPool> estimationPool;
+        /// @name Per-frame scratch space for the estimation pool's tasks
+        /// @brief Kept around just to avoid reallocating it each frame.
+        /// @{
+        /// Every target, in body then target order, when processing LEDs;
+        /// those with measurements, in the same order, when estimating poses.
+        std::vector<TrackedBodyTarget *> estimationTargets;
+        /// Per entry in estimationTargets: LED measurements used, when
+        /// processing LEDs; whether a pose was estimated, when estimating
+        /// poses.
+        std::vector<std::size_t> estimationResults;
+        /// Index into estimationTargets of the first target of each body with
+        /// measurements, plus one past the end.
+        std::vector<std::size_t> estimationBodyStarts;
+        /// @}
+
+        /// @name Blob extraction plan for upcoming frames
+        /// @brief Written by updateBodiesFromVideoData(), read by
+        /// performInitialImageProcessing(), which may run concurrently.
+        /// @{
+        mutable std::mutex blobPlanMutex;
+        bool scanFullFrame = true;
+        PredictedBlobRegions blobRegions;
+        BlobExtractionStats blobExtractionStats;
+        /// @}
+        /// Only touched by updateBodiesFromVideoData().
+        std::size_t framesSinceFullFrame = 0;
+        /// Only touched by updateBodiesFromVideoData(): the regions being
+        /// planned, swapped in once complete.
+        PredictedBlobRegions plannedRegions;
+        /// Only touched by performInitialImageProcessing(): where it's looking
+        /// this frame.
+        PredictedBlobRegions extractionRegions;
+
+        /// Held while using the blob extractor, which the debug display also
+        /// gets images from.
+        std::mutex blobExtractorMutex;
         std::unique_ptr<SBDBlobExtractor> blobExtractor;
         std::unique_ptr<TrackingDebugDisplay> debugDisplay;
     };
@@ -34,6 +34,8 @@
 
 // uvbi-core mini-library
 #include "TrackingSystem.h"
+#include "TrackedBody.h"
+#include "TrackedBodyTarget.h"
 #include "ThreadsafeBodyReporting.h"
 #include "CameraParameters.h"
 
@@ -204,8 +206,38 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
             if (m_trackerThread.joinable()) {
                 m_trackerThread.join();
             }
+            auto latency = m_trackerThreadManager->getLatencyData();
+            for (std::size_t i = 0; i < latency.size(); ++i) {
+                std::cout << "Pipeline "
+                          << osvr::vbtracker::getPipelineStageName(
+                                 osvr::vbtracker::PipelineStage(i))
+                          << " latency: " << latency[i] << std::endl;
+            }
+            std::cout << "Blob extraction: "
+                      << m_trackingSystem->getBlobExtractionStats()
+                      << std::endl;
+            for (std::size_t i = 0; i < m_trackingSystem->getNumBodies(); ++i) {
+                auto &body =
+                    m_trackingSystem->getBody(osvr::vbtracker::BodyId(i));
+                std::cout << "Body " << i << " video fusion: "
+                          << body.getVideoFusionStats() << std::endl;
+                body.forEachTarget([](osvr::vbtracker::TrackedBodyTarget &t) {
+                    std::cout << "Target " << t.getQualifiedId()
+                              << " re-acquisition: "
+                              << t.getReacquisitionStats() << std::endl;
+                });
+            }
             m_trackerThreadManager.reset();
             m_trackerThread = std::thread();
+            for (std::size_t i = 0; i < m_bodyReportingVector.size(); ++i) {
+                auto stats = m_bodyReportingVector[i]->getStats();
+                std::cout << "Sensor " << i << ": " << stats.published
+                          << " states published, " << stats.freshReports
+                          << " reports from a new state, "
+                          << stats.repeatedReports
+                          << " reports re-predicted from the previous state"
+                          << std::endl;
+            }
         }
     }
 
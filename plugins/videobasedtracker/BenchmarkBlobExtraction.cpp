@@ -0,0 +1,171 @@
+/** @file
+    @brief Implementation of a benchmark for blob extraction: runs the
+   single-pass blob detector and OpenCV's SimpleBlobDetector over image
+   sequences, comparing the blobs they find and timing each per frame.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SBDBlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+/// @brief Loads a numbered image sequence (0001.tif, 0002.tif, ...) as
+/// grayscale, the way FakeImageSource finds its images.
+std::vector<cv::Mat> loadSequence(std::string const &dir) {
+    std::vector<cv::Mat> ret;
+    for (int imageNum = 1;; ++imageNum) {
+        std::ostringstream fileName;
+        fileName << dir << "/" << std::setfill('0') << std::setw(4) << imageNum
+                 << ".tif";
+        cv::Mat color = cv::imread(fileName.str(), CV_LOAD_IMAGE_COLOR);
+        if (!color.data) {
+            break;
+        }
+        cv::Mat gray;
+        cv::cvtColor(color, gray, CV_BGR2GRAY);
+        ret.push_back(gray);
+    }
+    return ret;
+}
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+/// @brief Extracts blobs from every frame, repeatedly, returning the time per
+/// frame in microseconds and leaving the measurements of each frame in out.
+double runExtractor(BlobParams const &params,
+                    std::vector<cv::Mat> const &frames, int iterations,
+                    std::vector<LedMeasurementVec> &out) {
+    SBDBlobExtractor extractor(params);
+    out.resize(frames.size());
+    auto begin = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (std::size_t f = 0; f < frames.size(); ++f) {
+            out[f] = extractor.extractBlobs(frames[f]);
+        }
+    }
+    auto elapsed = clock_type::now() - begin;
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           (double(iterations) * frames.size());
+}
+
+struct Comparison {
+    std::size_t reference = 0;
+    std::size_t candidate = 0;
+    std::size_t matched = 0;
+    double sumOffset = 0;
+    double sumDiameterRatio = 0;
+};
+
+/// @brief Pairs each reference blob with the nearest candidate blob within
+/// its diameter (and at least two pixels).
+void compare(LedMeasurementVec const &reference,
+             LedMeasurementVec const &candidate, Comparison &stats) {
+    stats.reference += reference.size();
+    stats.candidate += candidate.size();
+    for (auto const &ref : reference) {
+        auto best = std::numeric_limits<double>::max();
+        LedMeasurement const *nearest = nullptr;
+        for (auto const &meas : candidate) {
+            auto dx = meas.loc.x - ref.loc.x;
+            auto dy = meas.loc.y - ref.loc.y;
+            auto dist = std::sqrt(dx * dx + dy * dy);
+            if (dist < best) {
+                best = dist;
+                nearest = &meas;
+            }
+        }
+        if (nearest && best <= std::max(2.f, ref.diameter)) {
+            ++stats.matched;
+            stats.sumOffset += best;
+            if (ref.diameter > 0) {
+                stats.sumDiameterRatio += nearest->diameter / ref.diameter;
+            }
+        }
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> dirs;
+    for (int i = 1; i < argc; ++i) {
+        dirs.emplace_back(argv[i]);
+    }
+    if (dirs.empty()) {
+        dirs = {OSVR_VBTRACKER_SOURCE_DIR "/HDK_random_images",
+                OSVR_VBTRACKER_SOURCE_DIR "/simulated_images/"
+                                          "animation_from_fake"};
+    }
+    static const int ITERATIONS = 20;
+    BlobParams singlePass;
+    BlobParams simple;
+    simple.useSimpleBlobDetector = true;
+
+    int ret = 0;
+    for (auto const &dir : dirs) {
+        auto frames = loadSequence(dir);
+        if (frames.empty()) {
+            std::cerr << "No images found in " << dir << std::endl;
+            ret = 1;
+            continue;
+        }
+        std::vector<LedMeasurementVec> simpleResults;
+        std::vector<LedMeasurementVec> singlePassResults;
+        auto simpleTime =
+            runExtractor(simple, frames, ITERATIONS, simpleResults);
+        auto singlePassTime =
+            runExtractor(singlePass, frames, ITERATIONS, singlePassResults);
+        Comparison stats;
+        for (std::size_t f = 0; f < frames.size(); ++f) {
+            compare(simpleResults[f], singlePassResults[f], stats);
+        }
+        std::cout << dir << ": " << frames.size() << " frames of "
+                  << frames.front().cols << "x" << frames.front().rows << "\n";
+        std::cout << "  SimpleBlobDetector:     " << stats.reference
+                  << " blobs, " << simpleTime << " us/frame\n";
+        std::cout << "  Single-pass detector:   " << stats.candidate
+                  << " blobs, " << singlePassTime << " us/frame\n";
+        std::cout << "  Matched " << stats.matched << " of " << stats.reference;
+        if (stats.matched > 0) {
+            std::cout << ", mean offset " << stats.sumOffset / stats.matched
+                      << " px, mean diameter ratio "
+                      << stats.sumDiameterRatio / stats.matched;
+        }
+        std::cout << std::endl;
+    }
+    return ret;
+}
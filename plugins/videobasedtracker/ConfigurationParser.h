@@ -105,6 +105,7 @@ namespace vbtracker {
             getOptionalParameter(config.blobParams.minDistBetweenBlobs, blob,
                                  "minDistBetweenBlobs");
             getOptionalParameter(config.blobParams.minArea, blob, "minArea");
+            getOptionalParameter(config.blobParams.maxArea, blob, "maxArea");
             getOptionalParameter(config.blobParams.filterByCircularity, blob,
                                  "filterByCircularity");
             getOptionalParameter(config.blobParams.minCircularity, blob,
@@ -119,6 +120,8 @@ namespace vbtracker {
                                  "maxThresholdAlpha");
             getOptionalParameter(config.blobParams.thresholdSteps, blob,
                                  "thresholdSteps");
+            getOptionalParameter(config.blobParams.useSimpleBlobDetector,
+                                 blob, "useSimpleBlobDetector");
         }
 
         return config;
@@ -44,7 +44,9 @@ namespace osvr {
 namespace vbtracker {
 
     VideoBasedTracker::VideoBasedTracker(ConfigParams const &params)
-        : m_params(params), m_blobExtractor(params.blobParams) {}
+        : m_params(params), m_blobExtractor(params.blobParams) {
+        m_blobExtractor.enableDebugImages(params.debug);
+    }
 
     // This version requires YOU to add your beacons! You!
     void VideoBasedTracker::addSensor(
@@ -148,47 +150,53 @@ namespace vbtracker {
         for (size_t sensor = 0; sensor < m_identifiers.size(); sensor++) {
 
             osvrPose3SetIdentity(&m_pose);
-            auto ledsMeasurements = undistortedLeds;
+            auto const &ledsMeasurements = undistortedLeds;
 
             // Locate the closest blob from this frame to each LED found
             // in the previous frame.  If it is close enough to the nearest
             // neighbor from last time, we assume that it is the same LED and
-            // update it.  If not, we delete the LED from the list.  Once we
-            // have matched a blob to an LED, we remove it from the list.  If
-            // there are any blobs leftover, we create new LEDs from them.
+            // update it.  If not, we delete the LED from the list.  Each blob
+            // is matched to at most one LED.  If there are any blobs leftover,
+            // we create new LEDs from them.
             // @todo: Include motion estimate based on Kalman filter along with
             // model of the projection once we have one built.  Note that this
             // will require handling the lens distortion appropriately.
             {
                 auto &myLeds = m_led_groups[sensor];
+                m_blobMatcher.reset(ledsMeasurements);
+                for (auto &led : myLeds) {
+                    led.resetUsed();
+                    m_blobMatcher.addPrevious(
+                        led.getLocation(), m_params.blobMoveThreshold *
+                                               led.getMeasurement().diameter);
+                }
+                m_blobMatcher.match();
+
                 auto led = begin(myLeds);
-                auto e = end(myLeds);
+                auto ledIndex = std::size_t{0};
                 while (led != end(myLeds)) {
-                    led->resetUsed();
-                    auto threshold = m_params.blobMoveThreshold *
-                                     led->getMeasurement().diameter;
-                    auto nearest = led->nearest(ledsMeasurements, threshold);
-                    if (nearest == end(ledsMeasurements)) {
+                    auto nearest = m_blobMatcher.getMatch(ledIndex);
+                    ++ledIndex;
+                    if (nearest == BlobMatcher::NO_MATCH) {
                         // We have no blob corresponding to this LED, so we need
                         // to delete this LED.
                         led = myLeds.erase(led);
                     } else {
                         // Update the values in this LED and then go on to the
-                        // next one. Remove this blob from the list of
-                        // potential matches.
-                        led->addMeasurement(*nearest,
+                        // next one.
+                        led->addMeasurement(ledsMeasurements[nearest],
                                             m_params.blobsKeepIdentity);
-                        ledsMeasurements.erase(nearest);
                         ++led;
                     }
                 }
                 // If we have any blobs that have not been associated with an
                 // LED, then we add a new LED for each of them.
-                // std::cout << "Had " << Leds.size() << " LEDs, " <<
-                // keyPoints.size() << " new ones available" << std::endl;
-                for (auto &remainingLed : ledsMeasurements) {
-                    myLeds.emplace_back(m_identifiers[sensor].get(),
-                                        remainingLed);
+                for (std::size_t i = 0, e = ledsMeasurements.size(); i < e;
+                     ++i) {
+                    if (!m_blobMatcher.isMatched(i)) {
+                        myLeds.emplace_back(m_identifiers[sensor].get(),
+                                            ledsMeasurements[i]);
+                    }
                 }
             }
             //==================================================================
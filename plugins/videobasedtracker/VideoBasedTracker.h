@@ -32,6 +32,7 @@
 #include "BeaconBasedPoseEstimator.h"
 #include "CameraParameters.h"
 #include "SBDBlobExtractor.h"
+#include "BlobMatcher.h"
 #include <osvr/Util/ChannelCountC.h>
 
 // Library/third-party includes
@@ -196,6 +197,7 @@ namespace vbtracker {
         LedIdentifierList m_identifiers;
         LedGroupList m_led_groups;
         EstimatorList m_estimators;
+        BlobMatcher m_blobMatcher;
         /// @}
 
         /// @brief The pose that we report
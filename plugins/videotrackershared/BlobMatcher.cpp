@@ -0,0 +1,179 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlobMatcher.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <tuple>
+
+namespace osvr {
+namespace vbtracker {
+    const std::size_t BlobMatcher::NO_MATCH;
+
+    void BlobMatcher::reset(LedMeasurementVec const &measurements) {
+        m_measurements = &measurements;
+        m_previous.clear();
+        m_matchForPrevious.clear();
+        m_measurementMatched.assign(measurements.size(), false);
+    }
+
+    void BlobMatcher::addPrevious(cv::Point2f const &loc, double threshold) {
+        m_previous.push_back(Previous{loc, threshold});
+    }
+
+    void BlobMatcher::match() {
+        m_matchForPrevious.assign(m_previous.size(), NO_MATCH);
+        m_candidates.clear();
+        auto &measurements = *m_measurements;
+        if (m_previous.empty() || measurements.empty()) {
+            return;
+        }
+
+        /// With cells at least as big as the largest threshold, each previous
+        /// blob only has to look in a few cells around it.
+        double maxThreshold = 0;
+        for (auto &prev : m_previous) {
+            maxThreshold = std::max(maxThreshold, prev.threshold);
+        }
+        m_buildGrid(std::max(static_cast<float>(maxThreshold), 1.f));
+
+        for (std::size_t i = 0, e = m_previous.size(); i < e; ++i) {
+            auto const &prev = m_previous[i];
+            if (prev.threshold < 0) {
+                continue;
+            }
+            const auto t = static_cast<float>(prev.threshold);
+            const auto thresholdSquared = prev.threshold * prev.threshold;
+            auto xBegin = m_cellIndex(prev.loc.x - t, m_origin.x, m_cellsX);
+            auto xEnd = m_cellIndex(prev.loc.x + t, m_origin.x, m_cellsX) + 1;
+            auto yBegin = m_cellIndex(prev.loc.y - t, m_origin.y, m_cellsY);
+            auto yEnd = m_cellIndex(prev.loc.y + t, m_origin.y, m_cellsY) + 1;
+            for (auto y = yBegin; y < yEnd; ++y) {
+                for (auto x = xBegin; x < xEnd; ++x) {
+                    auto cell = y * m_cellsX + x;
+                    for (auto c = m_cellStart[cell], ce = m_cellStart[cell + 1];
+                         c < ce; ++c) {
+                        auto j = m_cellContents[c];
+                        auto diff = prev.loc - measurements[j].loc;
+                        auto distSquared = diff.dot(diff);
+                        if (distSquared <= thresholdSquared) {
+                            m_candidates.push_back(
+                                Candidate{distSquared, i, j});
+                        }
+                    }
+                }
+            }
+        }
+
+        std::sort(begin(m_candidates), end(m_candidates),
+                  [](Candidate const &a, Candidate const &b) {
+                      return std::tie(a.distSquared, a.previous,
+                                      a.measurement) <
+                             std::tie(b.distSquared, b.previous,
+                                      b.measurement);
+                  });
+        for (auto const &candidate : m_candidates) {
+            if (m_matchForPrevious[candidate.previous] != NO_MATCH ||
+                m_measurementMatched[candidate.measurement]) {
+                continue;
+            }
+            m_matchForPrevious[candidate.previous] = candidate.measurement;
+            m_measurementMatched[candidate.measurement] = true;
+        }
+    }
+
+    void BlobMatcher::m_buildGrid(float cellSize) {
+        auto &measurements = *m_measurements;
+        auto n = measurements.size();
+        cv::Point2f minLoc = measurements.front().loc;
+        cv::Point2f maxLoc = minLoc;
+        for (auto &meas : measurements) {
+            minLoc.x = std::min(minLoc.x, meas.loc.x);
+            minLoc.y = std::min(minLoc.y, meas.loc.y);
+            maxLoc.x = std::max(maxLoc.x, meas.loc.x);
+            maxLoc.y = std::max(maxLoc.y, meas.loc.y);
+        }
+        m_origin = minLoc;
+
+        /// Don't let a widely-spread frame with small thresholds produce a
+        /// grid with far more cells than measurements.
+        const std::size_t maxCells = 4 * n + 16;
+        m_cellSize = cellSize;
+        while (true) {
+            m_cellsX = static_cast<std::size_t>((maxLoc.x - minLoc.x) /
+                                                m_cellSize) +
+                       1;
+            m_cellsY = static_cast<std::size_t>((maxLoc.y - minLoc.y) /
+                                                m_cellSize) +
+                       1;
+            if (m_cellsX * m_cellsY <= maxCells) {
+                break;
+            }
+            m_cellSize *= 2;
+        }
+
+        /// Counting sort of the measurement indices by cell: count into
+        /// m_cellStart[cell + 1], accumulate, then place each one.
+        auto numCells = m_cellsX * m_cellsY;
+        m_cellStart.assign(numCells + 1, 0);
+        for (auto &meas : measurements) {
+            auto cell = m_cellIndex(meas.loc.y, m_origin.y, m_cellsY) *
+                            m_cellsX +
+                        m_cellIndex(meas.loc.x, m_origin.x, m_cellsX);
+            ++m_cellStart[cell + 1];
+        }
+        for (std::size_t cell = 0; cell < numCells; ++cell) {
+            m_cellStart[cell + 1] += m_cellStart[cell];
+        }
+        m_cellContents.resize(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            auto const &loc = measurements[j].loc;
+            auto cell = m_cellIndex(loc.y, m_origin.y, m_cellsY) * m_cellsX +
+                        m_cellIndex(loc.x, m_origin.x, m_cellsX);
+            /// Uses m_cellStart[cell] as the insertion point, leaving it at
+            /// the start of the following cell.
+            m_cellContents[m_cellStart[cell]++] = j;
+        }
+        /// Shift back so each entry is the start of its own cell again.
+        for (auto cell = numCells; cell > 0; --cell) {
+            m_cellStart[cell] = m_cellStart[cell - 1];
+        }
+        m_cellStart[0] = 0;
+    }
+
+    std::size_t BlobMatcher::m_cellIndex(float coord, float origin,
+                                         std::size_t cells) const {
+        auto offset = (coord - origin) / m_cellSize;
+        if (!(offset > 0)) {
+            return 0;
+        }
+        return std::min(static_cast<std::size_t>(offset), cells - 1);
+    }
+} // namespace vbtracker
+} // namespace osvr
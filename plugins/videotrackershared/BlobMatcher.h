@@ -0,0 +1,123 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BlobMatcher_h_GUID_6A4F2E1D_8C3B_4F57_B0E2_91D5C7A3E846
+#define INCLUDED_BlobMatcher_h_GUID_6A4F2E1D_8C3B_4F57_B0E2_91D5C7A3E846
+
+// Internal Includes
+#include "LedMeasurement.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Associates blobs tracked from the previous frame with the
+    /// measurements in a new frame.
+    ///
+    /// Each previous blob may match the nearest measurement within its own
+    /// distance threshold. Candidate pairs are found through a uniform grid
+    /// over the measurement locations, then assigned greedily in order of
+    /// increasing distance (ties broken by previous blob, then measurement
+    /// index) so the result is deterministic, and a blob is never robbed of
+    /// its nearest measurement just because it was considered later. When
+    /// blobs are well-separated, this gives the same association as matching
+    /// each previous blob to its nearest measurement in turn.
+    ///
+    /// Keeps its working storage between frames, so it only allocates when a
+    /// frame has more blobs than any before.
+    class BlobMatcher {
+      public:
+        static const std::size_t NO_MATCH = static_cast<std::size_t>(-1);
+
+        /// @brief Starts a new frame, discarding any previous blobs and
+        /// matches. The measurements must remain valid and unmodified until
+        /// the matching results are no longer needed.
+        void reset(LedMeasurementVec const &measurements);
+
+        /// @brief Adds a blob from the previous frame, to be matched with a
+        /// measurement no farther than threshold from loc. Previous blobs are
+        /// numbered in the order they are added, starting from zero.
+        void addPrevious(cv::Point2f const &loc, double threshold);
+
+        /// @brief Performs the association.
+        void match();
+
+        /// @brief Index of the measurement matched to the given previous blob,
+        /// or NO_MATCH.
+        std::size_t getMatch(std::size_t previous) const {
+            return m_matchForPrevious[previous];
+        }
+
+        /// @brief Whether the measurement was matched to a previous blob.
+        bool isMatched(std::size_t measurement) const {
+            return m_measurementMatched[measurement];
+        }
+
+        /// @brief Marks a matched measurement as unmatched after all, for
+        /// instance if the previous blob turned out to be misidentified.
+        void releaseMeasurement(std::size_t measurement) {
+            m_measurementMatched[measurement] = false;
+        }
+
+      private:
+        struct Previous {
+            cv::Point2f loc;
+            double threshold;
+        };
+        struct Candidate {
+            float distSquared;
+            std::size_t previous;
+            std::size_t measurement;
+        };
+        void m_buildGrid(float cellSize);
+        std::size_t m_cellIndex(float coord, float origin,
+                                std::size_t cells) const;
+
+        LedMeasurementVec const *m_measurements = nullptr;
+        std::vector<Previous> m_previous;
+        std::vector<std::size_t> m_matchForPrevious;
+        std::vector<bool> m_measurementMatched;
+        std::vector<Candidate> m_candidates;
+
+        /// @name Grid over the measurements
+        /// @brief Measurement indices sorted by cell in m_cellContents, with
+        /// the contents of cell i starting at m_cellStart[i].
+        /// @{
+        float m_cellSize = 1.f;
+        cv::Point2f m_origin;
+        std::size_t m_cellsX = 0;
+        std::size_t m_cellsY = 0;
+        std::vector<std::size_t> m_cellStart;
+        std::vector<std::size_t> m_cellContents;
+        /// @}
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BlobMatcher_h_GUID_6A4F2E1D_8C3B_4F57_B0E2_91D5C7A3E846
@@ -44,6 +44,9 @@ namespace vbtracker {
         /// Same meaning as the parameter to OpenCV's SimpleBlobDetector - in
         /// square pixel units
         float minArea = 2.0f;
+        /// Same meaning as the parameter to OpenCV's SimpleBlobDetector - in
+        /// square pixel units
+        float maxArea = 5000.0f;
         /// Same meaning as the parameter to OpenCV's SimpleBlobDetector - this
         /// is faster than convexity but may be confused by side-views of LEDs.
         bool filterByCircularity = false;
@@ -73,6 +76,16 @@ namespace vbtracker {
         /// the blob extractor will take between the two threshold extrema, and
         /// thus greatly impacts performance. Adjust with care.
         int thresholdSteps = 4;
+
+        /// When true, blobs are found with OpenCV's SimpleBlobDetector,
+        /// thresholding thresholdSteps times between the two threshold
+        /// extrema, instead of with a single connected-component pass at the
+        /// minimum threshold. Much slower, kept for comparison.
+        ///
+        /// With a single threshold there is nothing to be repeatable across,
+        /// so SimpleBlobDetector's minRepeatability has no equivalent in the
+        /// default path; minDistBetweenBlobs applies to both.
+        bool useSimpleBlobDetector = false;
     };
 
 } // namespace vbtracker
@@ -189,12 +189,13 @@ namespace vbtracker {
 #endif
 
     SBDBlobExtractor::SBDBlobExtractor(BlobParams const &blobParams)
-        : m_params(blobParams) {
+        : m_params(blobParams), m_detector(blobParams) {
         auto &p = m_params;
         /// Set up blob params
         m_sbdParams.minDistBetweenBlobs = p.minDistBetweenBlobs;
 
         m_sbdParams.minArea = p.minArea; // How small can the blobs be?
+        m_sbdParams.maxArea = p.maxArea;
 
         // Look for bright blobs: there is a bug in this code
         m_sbdParams.filterByColor = false;
@@ -223,7 +224,9 @@ namespace vbtracker {
     LedMeasurementVec const &
     SBDBlobExtractor::extractBlobs(cv::Mat const &grayImage) {
         m_latestMeasurements.clear();
-        m_lastGrayImage = grayImage.clone();
+        if (m_debugImagesEnabled) {
+            m_lastGrayImage = grayImage.clone();
+        }
         m_debugThresholdImageDirty = true;
         m_debugBlobImageDirty = true;
 
@@ -241,7 +244,30 @@ namespace vbtracker {
         m_latestMeasurements =
             m_keypointDetailer->augmentKeypoints(thresholded, m_keyPoints);
 #endif
-        cv::Size sz = grayImage.size();
+        keypointsToMeasurements(grayImage.size());
+        return m_latestMeasurements;
+    }
+
+    LedMeasurementVec const &
+    SBDBlobExtractor::extractBlobs(cv::Mat const &grayImage,
+                                   std::vector<cv::Rect> const &regions) {
+        if (m_params.useSimpleBlobDetector) {
+            /// SimpleBlobDetector only knows how to look at the whole image.
+            return extractBlobs(grayImage);
+        }
+        m_latestMeasurements.clear();
+        if (m_debugImagesEnabled) {
+            m_lastGrayImage = grayImage.clone();
+        }
+        m_debugThresholdImageDirty = true;
+        m_debugBlobImageDirty = true;
+
+        getKeypointsInRegions(grayImage, regions);
+        keypointsToMeasurements(grayImage.size());
+        return m_latestMeasurements;
+    }
+
+    void SBDBlobExtractor::keypointsToMeasurements(cv::Size sz) {
         /// Use the LedMeasurement constructor to do the conversion from
         /// keypoint to measurement right now.
         m_latestMeasurements.resize(m_keyPoints.size());
@@ -250,8 +276,34 @@ namespace vbtracker {
                        [sz](cv::KeyPoint const &kp) {
                            return LedMeasurement{kp, sz};
                        });
+    }
 
-        return m_latestMeasurements;
+    void SBDBlobExtractor::getKeypointsInRegions(
+        cv::Mat const &grayImage, std::vector<cv::Rect> const &regions) {
+        m_keyPoints.clear();
+        /// The brightest pixel is looked for only in the regions, but they are
+        /// mostly LED, so the darkest is taken from the last full frame.
+        auto imageBounds = cv::Rect(0, 0, grayImage.cols, grayImage.rows);
+        double maxVal = 0;
+        for (auto const &region : regions) {
+            auto clipped = region & imageBounds;
+            if (clipped.area() <= 0) {
+                continue;
+            }
+            double regionMax;
+            cv::minMaxIdx(grayImage(clipped), nullptr, &regionMax);
+            maxVal = std::max(maxVal, regionMax);
+        }
+        auto &p = m_params;
+        if (maxVal < p.absoluteMinThreshold) {
+            return;
+        }
+        auto minVal = m_lastFullFrameMinVal;
+        m_sbdParams.minThreshold =
+            std::max(minVal + (maxVal - minVal) * p.minThresholdAlpha,
+                     p.absoluteMinThreshold);
+        m_detector.detect(grayImage, m_sbdParams.minThreshold, regions,
+                          m_keyPoints);
     }
 
     void SBDBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
@@ -262,6 +314,7 @@ namespace vbtracker {
         // Construct a blob detector and find the blobs in the image.
         double minVal, maxVal;
         cv::minMaxIdx(grayImage, &minVal, &maxVal);
+        m_lastFullFrameMinVal = minVal;
         auto &p = m_params;
         if (maxVal < p.absoluteMinThreshold) {
             /// empty image, early out!
@@ -280,6 +333,13 @@ namespace vbtracker {
         m_sbdParams.thresholdStep =
             (m_sbdParams.maxThreshold - m_sbdParams.minThreshold) /
             p.thresholdSteps;
+        if (!p.useSimpleBlobDetector) {
+            /// LEDs are much brighter than anything else, so one threshold
+            /// and one pass over the image finds them.
+            m_detector.detect(grayImage, m_sbdParams.minThreshold,
+                              m_keyPoints);
+            return;
+        }
 /// @todo: Make a different set of parameters optimized for the
 /// Oculus Dk2.
 /// @todo: Determine the maximum size of a trackable blob by seeing
@@ -307,6 +367,15 @@ namespace vbtracker {
     }
 
     cv::Mat SBDBlobExtractor::generateDebugThresholdImage() const {
+        if (m_lastGrayImage.empty()) {
+            return cv::Mat();
+        }
+        if (!m_params.useSimpleBlobDetector) {
+            cv::Mat ret;
+            cv::threshold(m_lastGrayImage, ret, m_sbdParams.minThreshold, 255,
+                          CV_THRESH_BINARY);
+            return ret;
+        }
 
         // Fake the thresholded image to give an idea of what the
         // blob detector is doing.
@@ -336,6 +405,9 @@ namespace vbtracker {
     }
 
     cv::Mat SBDBlobExtractor::generateDebugBlobImage() const {
+        if (m_lastGrayImage.empty()) {
+            return cv::Mat();
+        }
         cv::Mat ret;
         cv::Mat tempColor;
         cv::cvtColor(m_lastGrayImage, tempColor, CV_GRAY2BGR);
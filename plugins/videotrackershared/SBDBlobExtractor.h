@@ -28,6 +28,7 @@
 // Internal Includes
 #include "LedMeasurement.h"
 #include "BlobParams.h"
+#include "SinglePassBlobDetector.h"
 
 // Library/third-party includes
 #include <opencv2/features2d/features2d.hpp>
@@ -46,6 +47,19 @@ namespace vbtracker {
         ~SBDBlobExtractor();
         LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage);
 
+        /// @brief Extracts blobs from only the union of the given regions of
+        /// the image, for when it's known where the blobs should be. The
+        /// threshold uses the darkest pixel of the last full-image extraction.
+        ///
+        /// Looks at the whole image if useSimpleBlobDetector is set.
+        LedMeasurementVec const &
+        extractBlobs(cv::Mat const &grayImage,
+                     std::vector<cv::Rect> const &regions);
+
+        /// @brief Whether to keep a copy of each frame for the debug images:
+        /// only needed when something will display them, and off by default.
+        void enableDebugImages(bool enable) { m_debugImagesEnabled = enable; }
+
         cv::Mat const &getDebugThresholdImage();
 
         cv::Mat const &getDebugBlobImage();
@@ -54,11 +68,16 @@ namespace vbtracker {
 #endif
       private:
         void getKeypoints(cv::Mat const &grayImage);
+        void getKeypointsInRegions(cv::Mat const &grayImage,
+                                   std::vector<cv::Rect> const &regions);
+        void keypointsToMeasurements(cv::Size sz);
         cv::Mat generateDebugThresholdImage() const;
         cv::Mat generateDebugBlobImage() const;
 
         BlobParams m_params;
         cv::SimpleBlobDetector::Params m_sbdParams;
+        SinglePassBlobDetector m_detector;
+        double m_lastFullFrameMinVal = 0;
         LedMeasurementVec m_latestMeasurements;
 
         std::vector<cv::KeyPoint> m_keyPoints;
@@ -66,6 +85,7 @@ namespace vbtracker {
 #if 0
         std::unique_ptr<KeypointDetailer> m_keypointDetailer;
 #endif
+        bool m_debugImagesEnabled = false;
         cv::Mat m_lastGrayImage;
 
         bool m_debugThresholdImageDirty = true;
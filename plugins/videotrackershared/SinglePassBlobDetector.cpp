@@ -0,0 +1,428 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SinglePassBlobDetector.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OSVR_BLOB_DETECTOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace osvr {
+namespace vbtracker {
+    namespace {
+        /// @brief Returns the index of the first pixel at or after x (and
+        /// before end) that is at least threshold, or end if there is none.
+        inline int findBright(std::uint8_t const *row, int x, int end,
+                              std::uint8_t threshold) {
+#ifdef OSVR_BLOB_DETECTOR_SSE2
+            /// Most of an LED image is dark, so skip it 16 pixels at a time:
+            /// max(px, threshold) == px exactly where px >= threshold.
+            auto thresh = _mm_set1_epi8(static_cast<char>(threshold));
+            while (x + 16 <= end) {
+                auto px = _mm_loadu_si128(
+                    reinterpret_cast<__m128i const *>(row + x));
+                auto bright = _mm_cmpeq_epi8(_mm_max_epu8(px, thresh), px);
+                if (_mm_movemask_epi8(bright) != 0) {
+                    break;
+                }
+                x += 16;
+            }
+#endif
+            while (x < end && row[x] < threshold) {
+                ++x;
+            }
+            return x;
+        }
+
+        inline long long cross(cv::Point const &o, cv::Point const &a,
+                               cv::Point const &b) {
+            return static_cast<long long>(a.x - o.x) * (b.y - o.y) -
+                   static_cast<long long>(a.y - o.y) * (b.x - o.x);
+        }
+
+        inline int gcd(int a, int b) {
+            while (b != 0) {
+                auto t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+    } // namespace
+
+    SinglePassBlobDetector::SinglePassBlobDetector(BlobParams const &params)
+        : m_params(params) {}
+
+    void SinglePassBlobDetector::detect(cv::Mat const &grayImage,
+                                        double threshold,
+                                        std::vector<cv::KeyPoint> &keypoints) {
+        m_scan(grayImage, threshold, nullptr, keypoints);
+    }
+
+    void SinglePassBlobDetector::detect(cv::Mat const &grayImage,
+                                        double threshold,
+                                        std::vector<cv::Rect> const &regions,
+                                        std::vector<cv::KeyPoint> &keypoints) {
+        m_scan(grayImage, threshold, &regions, keypoints);
+    }
+
+    void SinglePassBlobDetector::m_scan(cv::Mat const &grayImage,
+                                        double threshold,
+                                        std::vector<cv::Rect> const *regions,
+                                        std::vector<cv::KeyPoint> &keypoints) {
+        CV_Assert(grayImage.type() == CV_8UC1);
+        keypoints.clear();
+        m_weights.clear();
+        m_runs.clear();
+        m_parent.clear();
+        m_prevRowBegin = 0;
+        m_rowBegin = 0;
+
+        /// A binary threshold keeps pixels strictly greater than threshold.
+        auto level = static_cast<int>(std::floor(threshold)) + 1;
+        if (level > 255) {
+            return;
+        }
+        level = std::max(level, 0);
+
+        auto thresh = static_cast<std::uint8_t>(level);
+        if (regions) {
+            m_labelRegions(grayImage, *regions, thresh);
+        } else {
+            for (int y = 0; y < grayImage.rows; ++y) {
+                m_prevRowBegin = m_rowBegin;
+                m_rowBegin = m_runs.size();
+                m_labelSpan(grayImage.ptr<std::uint8_t>(y), y, 0,
+                            grayImage.cols, thresh);
+            }
+        }
+
+        /// Number the blobs: a root is always the earliest run of its blob,
+        /// so it has been numbered by the time its other runs are reached.
+        auto numRuns = m_runs.size();
+        m_blobOfRun.resize(numRuns);
+        std::size_t numBlobs = 0;
+        for (std::size_t i = 0; i < numRuns; ++i) {
+            auto root = m_findRoot(i);
+            m_blobOfRun[i] = (root == i) ? numBlobs++ : m_blobOfRun[root];
+        }
+
+        /// Group the runs by blob, keeping them in scan order.
+        m_blobStart.assign(numBlobs + 1, 0);
+        for (std::size_t i = 0; i < numRuns; ++i) {
+            ++m_blobStart[m_blobOfRun[i] + 1];
+        }
+        for (std::size_t b = 0; b < numBlobs; ++b) {
+            m_blobStart[b + 1] += m_blobStart[b];
+        }
+        m_sortedRuns.resize(numRuns);
+        for (std::size_t i = 0; i < numRuns; ++i) {
+            m_sortedRuns[m_blobStart[m_blobOfRun[i]]++] = i;
+        }
+        /// Filling shifted each start to the next blob's start: shift back.
+        for (std::size_t b = numBlobs; b > 0; --b) {
+            m_blobStart[b] = m_blobStart[b - 1];
+        }
+        m_blobStart[0] = 0;
+
+        for (std::size_t b = 0; b < numBlobs; ++b) {
+            m_measureBlob(m_blobStart[b], m_blobStart[b + 1], keypoints);
+        }
+        m_mergeCloseBlobs(keypoints);
+    }
+
+    void SinglePassBlobDetector::m_labelRegions(
+        cv::Mat const &grayImage, std::vector<cv::Rect> const &regions,
+        std::uint8_t threshold) {
+        /// Clip the regions, and order them by first row so they can be
+        /// activated as the scan reaches them.
+        m_regions.clear();
+        for (auto const &r : regions) {
+            auto xBegin = std::max(r.x, 0);
+            auto yBegin = std::max(r.y, 0);
+            auto xEnd = std::min(r.x + r.width, grayImage.cols);
+            auto yEnd = std::min(r.y + r.height, grayImage.rows);
+            if (xBegin < xEnd && yBegin < yEnd) {
+                m_regions.emplace_back(xBegin, yBegin, xEnd - xBegin,
+                                       yEnd - yBegin);
+            }
+        }
+        std::sort(begin(m_regions), end(m_regions),
+                  [](cv::Rect const &a, cv::Rect const &b) {
+                      return a.y < b.y;
+                  });
+
+        m_active.clear();
+        std::size_t next = 0;
+        int y = 0;
+        while (y < grayImage.rows) {
+            auto numActive = m_active.size();
+            m_active.erase(std::remove_if(begin(m_active), end(m_active),
+                                          [y](cv::Rect const &r) {
+                                              return r.y + r.height <= y;
+                                          }),
+                           end(m_active));
+            auto changed = m_active.size() != numActive;
+            if (m_active.empty()) {
+                if (next == m_regions.size()) {
+                    break;
+                }
+                if (m_regions[next].y > y) {
+                    /// Jump to the next region, leaving no previous row.
+                    y = m_regions[next].y;
+                    m_rowBegin = m_runs.size();
+                }
+            }
+            while (next < m_regions.size() && m_regions[next].y <= y) {
+                m_active.push_back(m_regions[next]);
+                ++next;
+                changed = true;
+            }
+            if (changed) {
+                /// The union of the active regions on a row, left to right,
+                /// so runs stay in increasing x order.
+                m_spans.clear();
+                for (auto const &r : m_active) {
+                    m_spans.emplace_back(r.x, r.x + r.width);
+                }
+                std::sort(begin(m_spans), end(m_spans));
+                std::size_t merged = 0;
+                for (std::size_t i = 1; i < m_spans.size(); ++i) {
+                    if (m_spans[i].first <= m_spans[merged].second) {
+                        m_spans[merged].second =
+                            std::max(m_spans[merged].second, m_spans[i].second);
+                    } else {
+                        m_spans[++merged] = m_spans[i];
+                    }
+                }
+                m_spans.resize(merged + 1);
+            }
+
+            m_prevRowBegin = m_rowBegin;
+            m_rowBegin = m_runs.size();
+            auto row = grayImage.ptr<std::uint8_t>(y);
+            for (auto const &span : m_spans) {
+                m_labelSpan(row, y, span.first, span.second, threshold);
+            }
+            ++y;
+        }
+    }
+
+    void SinglePassBlobDetector::m_labelSpan(std::uint8_t const *row, int y,
+                                             int xBegin, int xEnd,
+                                             std::uint8_t threshold) {
+        int x = xBegin;
+        while (x < xEnd) {
+            x = findBright(row, x, xEnd, threshold);
+            if (x == xEnd) {
+                return;
+            }
+            auto runBegin = x;
+            std::uint32_t sumW = 0;
+            std::uint64_t sumWX = 0;
+            while (x < xEnd && row[x] >= threshold) {
+                std::uint32_t w = row[x] - threshold + 1;
+                sumW += w;
+                sumWX += static_cast<std::uint64_t>(w) * x;
+                ++x;
+            }
+            m_addRun(y, runBegin, x - 1, sumW, sumWX);
+        }
+    }
+
+    void SinglePassBlobDetector::m_addRun(int y, int xBegin, int xEnd,
+                                          std::uint32_t sumW,
+                                          std::uint64_t sumWX) {
+        auto index = m_runs.size();
+        m_runs.push_back(Run{y, xBegin, xEnd, sumW, sumWX});
+        m_parent.push_back(index);
+
+        /// Merge with every run on the previous row touching this one,
+        /// including diagonally. Both rows are in increasing x order.
+        for (auto prev = m_prevRowBegin; prev < m_rowBegin; ++prev) {
+            auto const &other = m_runs[prev];
+            if (other.xEnd < xBegin - 1) {
+                /// Too far left for this run, and so for any later one.
+                m_prevRowBegin = prev + 1;
+                continue;
+            }
+            if (other.xBegin > xEnd + 1) {
+                break;
+            }
+            auto a = m_findRoot(prev);
+            auto b = m_findRoot(index);
+            if (a != b) {
+                m_parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    std::size_t SinglePassBlobDetector::m_findRoot(std::size_t run) {
+        while (m_parent[run] != run) {
+            m_parent[run] = m_parent[m_parent[run]];
+            run = m_parent[run];
+        }
+        return run;
+    }
+
+    void SinglePassBlobDetector::m_measureBlob(
+        std::size_t begin, std::size_t end,
+        std::vector<cv::KeyPoint> &keypoints) {
+        std::size_t pixels = 0;
+        double sumW = 0;
+        double sumWX = 0;
+        double sumWY = 0;
+        m_endpoints.clear();
+        for (auto i = begin; i < end; ++i) {
+            auto const &run = m_runs[m_sortedRuns[i]];
+            pixels += run.xEnd - run.xBegin + 1;
+            sumW += run.sumW;
+            sumWX += static_cast<double>(run.sumWX);
+            sumWY += static_cast<double>(run.sumW) * run.y;
+            /// In scan order, so already sorted by row then column.
+            m_endpoints.emplace_back(run.xBegin, run.y);
+            if (run.xEnd != run.xBegin) {
+                m_endpoints.emplace_back(run.xEnd, run.y);
+            }
+        }
+
+        /// Convex hull of the pixel centers (monotone chain): every pixel
+        /// lies between the endpoints of its run, so those are enough.
+        auto n = m_endpoints.size();
+        m_hull.resize(2 * n);
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            while (k >= 2 &&
+                   cross(m_hull[k - 2], m_hull[k - 1], m_endpoints[i]) <= 0) {
+                --k;
+            }
+            m_hull[k++] = m_endpoints[i];
+        }
+        for (std::size_t i = n - 1, lower = k + 1; i > 0; --i) {
+            while (k >= lower &&
+                   cross(m_hull[k - 2], m_hull[k - 1], m_endpoints[i - 1]) <=
+                       0) {
+                --k;
+            }
+            m_hull[k++] = m_endpoints[i - 1];
+        }
+        m_hull.resize(n == 1 ? 1 : k - 1);
+
+        long long twiceHullArea = 0;
+        int boundaryPoints = 0;
+        double perimeter = 0;
+        for (std::size_t i = 0, e = m_hull.size(); i < e; ++i) {
+            auto const &a = m_hull[i];
+            auto const &b = m_hull[(i + 1) % e];
+            twiceHullArea += static_cast<long long>(a.x) * b.y -
+                             static_cast<long long>(b.x) * a.y;
+            auto dx = std::abs(b.x - a.x);
+            auto dy = std::abs(b.y - a.y);
+            boundaryPoints += gcd(dx, dy);
+            perimeter += std::sqrt(double(dx) * dx + double(dy) * dy);
+        }
+        auto hullArea = std::abs(twiceHullArea) / 2.;
+
+        /// Area of the outline through the pixel centers, as a contour would
+        /// measure it. By Pick's theorem, a convex blob has exactly
+        /// hullArea + boundaryPoints / 2 + 1 pixels: each pixel missing from
+        /// that count is a unit of area inside the hull but not the blob.
+        auto area = std::max(
+            static_cast<double>(pixels) - boundaryPoints / 2. - 1., 0.);
+        auto const &p = m_params;
+        if (area < p.minArea || area >= p.maxArea) {
+            return;
+        }
+        if (p.filterByCircularity) {
+            auto circularity =
+                perimeter > 0 ? 4 * CV_PI * area / (perimeter * perimeter) : 0;
+            if (circularity < p.minCircularity) {
+                return;
+            }
+        }
+        if (p.filterByConvexity) {
+            auto convexity = hullArea > 0 ? area / hullArea : 1.;
+            if (convexity < p.minConvexity) {
+                return;
+            }
+        }
+        auto diameter = 2 * std::sqrt(area / CV_PI);
+        keypoints.emplace_back(cv::Point2f(static_cast<float>(sumWX / sumW),
+                                           static_cast<float>(sumWY / sumW)),
+                               static_cast<float>(diameter));
+        m_weights.push_back(sumW);
+    }
+
+    void SinglePassBlobDetector::m_mergeCloseBlobs(
+        std::vector<cv::KeyPoint> &keypoints) {
+        /// SimpleBlobDetector groups centers closer than minDistBetweenBlobs
+        /// into one blob, so an LED split in two by a dim pixel still comes
+        /// out as one keypoint: do the same here.
+        auto minDist = m_params.minDistBetweenBlobs;
+        if (minDist <= 0) {
+            return;
+        }
+        auto minDistSquared = minDist * minDist;
+        std::size_t kept = 0;
+        for (std::size_t i = 0, e = keypoints.size(); i < e; ++i) {
+            auto const &kp = keypoints[i];
+            std::size_t j = 0;
+            for (; j < kept; ++j) {
+                auto d = kp.pt - keypoints[j].pt;
+                if (d.dot(d) < minDistSquared) {
+                    break;
+                }
+            }
+            if (j == kept) {
+                keypoints[kept] = kp;
+                m_weights[kept] = m_weights[i];
+                ++kept;
+                continue;
+            }
+            /// Brightness-weighted centroid of the two, with the size of a
+            /// circle of their combined area.
+            auto &merged = keypoints[j];
+            auto total = m_weights[j] + m_weights[i];
+            auto alpha = static_cast<float>(m_weights[i] / total);
+            merged.pt += (kp.pt - merged.pt) * alpha;
+            merged.size =
+                std::sqrt(merged.size * merged.size + kp.size * kp.size);
+            m_weights[j] = total;
+        }
+        keypoints.resize(kept);
+        m_weights.resize(kept);
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,131 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SinglePassBlobDetector_h_GUID_9B2D7E40_3C1A_4F86_A5D2_6E0F8B1C4A97
+#define INCLUDED_SinglePassBlobDetector_h_GUID_9B2D7E40_3C1A_4F86_A5D2_6E0F8B1C4A97
+
+// Internal Includes
+#include "BlobParams.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/features2d/features2d.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Finds bright blobs (LEDs) in a grayscale image with a single
+    /// threshold and a single scan.
+    ///
+    /// Pixels brighter than the threshold are grouped into runs along each
+    /// row, and runs touching (8-connected) runs on the previous row are
+    /// merged with a union-find, accumulating the area and the brightness
+    /// moments of each blob as they go. Blobs are then filtered the way
+    /// SimpleBlobDetector filters them, by area and optionally circularity
+    /// and convexity, computed from the convex hull of the run endpoints
+    /// instead of a traced contour. Blobs closer than minDistBetweenBlobs are
+    /// merged into one, as SimpleBlobDetector does.
+    ///
+    /// Keeps its working storage between frames, so it only allocates when a
+    /// frame has more runs than any before.
+    class SinglePassBlobDetector {
+      public:
+        explicit SinglePassBlobDetector(BlobParams const &params);
+
+        /// @brief Finds the blobs of pixels brighter than threshold in an
+        /// 8-bit single-channel image.
+        ///
+        /// Keypoints are placed at the brightness-weighted centroid (weighted
+        /// by how far above threshold each pixel is, much as averaging the
+        /// centers found at several thresholds would), with a size equal to
+        /// the diameter of a circle of the blob's area.
+        void detect(cv::Mat const &grayImage, double threshold,
+                    std::vector<cv::KeyPoint> &keypoints);
+
+        /// @brief Like the other overload, but only looks at the pixels in the
+        /// union of the given regions. A blob crossing the edge of the regions
+        /// is measured by the part inside them.
+        void detect(cv::Mat const &grayImage, double threshold,
+                    std::vector<cv::Rect> const &regions,
+                    std::vector<cv::KeyPoint> &keypoints);
+
+      private:
+        struct Run {
+            int y;
+            int xBegin;
+            /// inclusive
+            int xEnd;
+            std::uint32_t sumW;
+            std::uint64_t sumWX;
+        };
+        void m_scan(cv::Mat const &grayImage, double threshold,
+                    std::vector<cv::Rect> const *regions,
+                    std::vector<cv::KeyPoint> &keypoints);
+        void m_labelRegions(cv::Mat const &grayImage,
+                            std::vector<cv::Rect> const &regions,
+                            std::uint8_t threshold);
+        void m_labelSpan(std::uint8_t const *row, int y, int xBegin,
+                         int xEnd, std::uint8_t threshold);
+        void m_addRun(int y, int xBegin, int xEnd, std::uint32_t sumW,
+                      std::uint64_t sumWX);
+        std::size_t m_findRoot(std::size_t run);
+        void m_measureBlob(std::size_t begin, std::size_t end,
+                           std::vector<cv::KeyPoint> &keypoints);
+        void m_mergeCloseBlobs(std::vector<cv::KeyPoint> &keypoints);
+
+        BlobParams m_params;
+        std::vector<Run> m_runs;
+        std::vector<std::size_t> m_parent;
+        /// @name Region scanning
+        /// @{
+        std::vector<cv::Rect> m_regions;
+        std::vector<cv::Rect> m_active;
+        /// Half-open column ranges to scan on the current row.
+        std::vector<std::pair<int, int> > m_spans;
+        /// @}
+        /// Index of the first run on the previous row.
+        std::size_t m_prevRowBegin = 0;
+        /// Index of the first run on the current row.
+        std::size_t m_rowBegin = 0;
+
+        /// @name Runs grouped by blob
+        /// @{
+        std::vector<std::size_t> m_blobOfRun;
+        std::vector<std::size_t> m_blobStart;
+        std::vector<std::size_t> m_sortedRuns;
+        /// @}
+        std::vector<cv::Point> m_endpoints;
+        std::vector<cv::Point> m_hull;
+        /// Total brightness weight of each keypoint found, for merging.
+        std::vector<double> m_weights;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_SinglePassBlobDetector_h_GUID_9B2D7E40_3C1A_4F86_A5D2_6E0F8B1C4A97
@@ -79,6 +79,10 @@ namespace client {
                 // handlers.
                 m_pathTreeOwner.replaceTree(nodes);
             }));
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                m_pathTreeOwner.applyTreeDelta(delta);
+            });
 
         // No startup spin.
     }
@@ -32,9 +32,11 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/PathElementTypes.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
+#include <json/value.h>
 
 // Standard includes
 #include <unordered_set>
@@ -52,6 +54,16 @@ namespace client {
         m_treeObserver->setEventCallback(
             common::PathTreeEvents::AfterUpdate,
             [&](common::PathTree &) { m_connectNeededCallbacks(); });
+        m_treeObserver->setPartialEventCallback(
+            common::PathTreeEvents::AboutToUpdate,
+            [&](common::PathTree &, std::vector<std::string> const &) {
+                m_recordHandlerSources();
+            });
+        m_treeObserver->setPartialEventCallback(
+            common::PathTreeEvents::AfterUpdate,
+            [&](common::PathTree &, std::vector<std::string> const &) {
+                m_reconnectChangedCallbacks();
+            });
     }
 
     void ClientInterfaceObjectManager::addInterface(
@@ -132,6 +144,53 @@ namespace client {
                          << " unconnected paths successfully";
     }
 
+    /// @brief Summarizes everything a remote handler is constructed from, so
+    /// that we can tell if it would come out differently.
+    static inline std::string getSourceSummary(common::PathTree &tree,
+                                               std::string const &path) {
+        auto source = common::resolveTreeNode(tree, path);
+        if (!source.is_initialized()) {
+            return std::string();
+        }
+        Json::Value summary(Json::objectValue);
+        auto const &dev = source->getDeviceElement();
+        summary["device"] = source->getDevicePath();
+        summary["deviceName"] = dev.getDeviceName();
+        summary["server"] = dev.getServer();
+        summary["descriptor"] = dev.getDescriptor();
+        summary["interface"] = source->getInterfaceName();
+        auto sensor = source->getSensorNumber();
+        if (sensor) {
+            summary["sensor"] = *sensor;
+        }
+        summary["transform"] = source->getTransformJson();
+        return summary.toStyledString();
+    }
+
+    void ClientInterfaceObjectManager::m_recordHandlerSources() {
+        m_sourcesBeforeUpdate.clear();
+        m_interfaces.visitPathsWithHandlers([&](std::string const &path) {
+            m_sourcesBeforeUpdate[path] = getSourceSummary(m_pathTree, path);
+        });
+    }
+
+    void ClientInterfaceObjectManager::m_reconnectChangedCallbacks() {
+        auto changed = size_t{0};
+        for (auto const &pathAndSource : m_sourcesBeforeUpdate) {
+            auto const &path = pathAndSource.first;
+            if (getSourceSummary(m_pathTree, path) != pathAndSource.second) {
+                /// Drop it so it gets reconnected below.
+                m_interfaces.eraseHandlerForPath(path);
+                changed++;
+            }
+        }
+        logger()->info() << "Partial path tree update changed the source of "
+                         << changed << " of " << m_sourcesBeforeUpdate.size()
+                         << " connected paths";
+        m_sourcesBeforeUpdate.clear();
+        m_connectNeededCallbacks();
+    }
+
     util::log::LoggerPtr const &ClientInterfaceObjectManager::logger() const {
         return m_ctx->logger();
     }
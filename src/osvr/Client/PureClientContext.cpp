@@ -29,6 +29,7 @@
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/PathTreeSerialization.h>
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/DeduplicatingFunctionWrapper.h>
@@ -123,6 +124,19 @@ namespace client {
                 m_pathTreeOwner.replaceTree(nodes);
             }));
 
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                logger()->debug("Got path tree changes, processing");
+                auto localDelta = delta;
+                replaceLocalhostServers(
+                    localDelta[common::tree_delta_keys::nodes()], m_host);
+                if (!m_pathTreeOwner.applyTreeDelta(localDelta)) {
+                    logger()->debug(
+                        "Path tree changes don't apply to our version of the "
+                        "tree, waiting for the full tree.");
+                }
+            });
+
         typedef std::chrono::system_clock clock;
         auto begin = clock::now();
 
@@ -170,10 +184,18 @@ namespace client {
         /// Mainloop connections
         m_vrpnConns.updateAll();
 
-        if (!m_gotConnection && m_mainConn->connected()) {
+        auto connected = m_mainConn->connected();
+        if (!m_gotConnection && connected) {
             logger()->info("Got connection to main OSVR server");
             m_gotConnection = true;
         }
+        /// Ask for binary path trees each time we (re-)connect.
+        if (connected && !m_requestedBinaryTree) {
+            m_systemComponent->requestBinaryTree();
+            m_requestedBinaryTree = true;
+        } else if (!connected) {
+            m_requestedBinaryTree = false;
+        }
 
         /// Update system device
         m_systemDevice->update();
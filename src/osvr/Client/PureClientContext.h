@@ -108,6 +108,9 @@ namespace client {
         /// @brief Have we gotten a connection to the main server?
         bool m_gotConnection = false;
 
+        /// @brief Have we asked for binary path trees on this connection?
+        bool m_requestedBinaryTree = false;
+
         /// @brief Room to world transform.
         common::Transform m_roomToWorld;
 
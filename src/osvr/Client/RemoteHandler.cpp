@@ -34,5 +34,9 @@
 namespace osvr {
 namespace client {
     RemoteHandler::~RemoteHandler() {}
+
+    void RemoteHandler::applyPendingState() {}
+
+    void RemoteHandler::triggerPendingCallbacks() {}
 } // namespace client
 } // namespace osvr
@@ -54,26 +54,58 @@ namespace client {
         template <typename ReportType>
         void setStateAndTriggerCallbacks(const OSVR_TimeValue &timestamp,
                                          ReportType const &report) {
+            forEachInterface(
+                [&timestamp, &report](common::ClientInterface &iface) {
+                    applyReport(iface, timestamp, report);
+                });
+        }
+
+        /// @brief Set state and call callbacks for a report type on a single
+        /// interface: for use within forEachInterface when dispatching a batch
+        /// of reports.
+        template <typename ReportType>
+        static void applyReport(common::ClientInterface &iface,
+                                const OSVR_TimeValue &timestamp,
+                                ReportType const &report) {
             static_assert(
                 osvr::common::traits::KeepStateForReport<ReportType>::value,
                 "Should only call a state setter if we're keeping state for "
                 "this report type!");
-
-            forEachInterface(
-                [&timestamp, &report](common::ClientInterface &iface) {
-                    iface.setState(timestamp, report);
-                    iface.triggerCallbacks(timestamp, report);
-                });
+            iface.setState(timestamp, report);
+            iface.triggerCallbacks(timestamp, report);
         }
 
+        /// @brief Functor setting state for a report type on an interface,
+        /// for handlers that set state and call callbacks in separate passes.
+        struct SetState {
+            template <typename ReportType>
+            void operator()(common::ClientInterface &iface,
+                            const OSVR_TimeValue &timestamp,
+                            ReportType const &report) const {
+                iface.setState(timestamp, report);
+            }
+        };
+
+        /// @brief Functor calling the callbacks for a report type on an
+        /// interface: the counterpart of SetState.
+        struct TriggerCallbacks {
+            template <typename ReportType>
+            void operator()(common::ClientInterface &iface,
+                            const OSVR_TimeValue &timestamp,
+                            ReportType const &report) const {
+                iface.triggerCallbacks(timestamp, report);
+            }
+        };
+
         /// @brief Do something with every client interface object, if the above
         /// options don't suit your needs.
+        ///
+        /// Each interface is kept alive for the duration of the call, so
+        /// handlers with several reports to deliver should deliver all of them
+        /// within one call rather than calling this once per report.
         template <typename F> void forEachInterface(F &&f) {
-            common::ClientInterfacePtr pin;
             for (auto &iface : m_interfaces) {
-                /// @todo is this needed? it increments a shared_ptr reference
-                /// count which is expensive.
-                pin = iface;
+                common::ClientInterfacePtr pin{iface};
                 f(*pin);
             }
         }
@@ -28,11 +28,15 @@
 #include "RemoteHandlerInternals.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Client/InterfaceTree.h>
+#include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Common/LocalReportChannel.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/Tracing.h>
+#include <osvr/Common/TrackerComponent.h>
 #include <osvr/Common/TrackerSensorInfo.h>
 #include <osvr/Common/Transform.h>
 #include <osvr/Util/ChannelCountC.h>
@@ -50,229 +54,603 @@
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace ei = osvr::util::eigen_interop;
 
 namespace osvr {
 namespace client {
-    class VRPNTrackerHandler : public RemoteHandler {
+    /// Seconds without a local report after which the local channel is
+    /// checked to still be the one published under its name.
+    static const double LOCAL_RECHECK_SECONDS = 1.0;
+    /// Minimum seconds between attempts to open a local channel.
+    static const double LOCAL_REOPEN_SECONDS = 1.0;
+
+    /// Receives tracker reports from a device as native tracker messages,
+    /// falling back to VRPN tracker messages for servers that don't send
+    /// them, or, if the device is on this host and publishes them that way,
+    /// through a local report channel in shared memory.
+    ///
+    /// While a local channel is in use, no tracker message handlers are
+    /// registered on the connection, so the copies of the reports it carries
+    /// aren't parsed at all. The connection only serves to notice the server
+    /// going away: the channel is dropped for the connection's reports if the
+    /// connection drops, if the device closes the channel, or if a quiet
+    /// channel turns out to have been replaced (by a restarted server) or
+    /// removed, and is reopened once the device publishes one again.
+    class TrackerHandler : public RemoteHandler {
       public:
         struct Options {
             bool reportPose = false;
             bool reportPosition = false;
             bool reportOrientation = false;
         };
-        VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
-                           Options const &options,
-                           common::TrackerSensorInfo const &info,
-                           common::Transform const &t,
-                           boost::optional<int> sensor,
-                           common::InterfaceList &ifaces,
-                           common::ClientContext &ctx)
-            : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
-              m_info(info), m_sensor(sensor) {
+        TrackerHandler(vrpn_ConnectionPtr const &conn,
+                       std::string const &localNamespace,
+                       std::string const &localDevice, const char *src,
+                       Options const &options,
+                       common::TrackerSensorInfo const &info,
+                       common::Transform const &t,
+                       boost::optional<int> sensor,
+                       common::InterfaceList &ifaces,
+                       common::ClientContext &ctx)
+            : m_conn(conn), m_src(src), m_localNamespace(localNamespace),
+              m_localDevice(localDevice), m_transform(t), m_ctx(ctx),
+              m_internals(ifaces), m_opts(options), m_info(info),
+              m_sensor(sensor) {
+            m_droppedType =
+                m_conn->register_message_type(vrpn_dropped_connection);
+            m_conn->register_handler(m_droppedType,
+                                     &TrackerHandler::handleDropped, this,
+                                     vrpn_ANY_SENDER);
+            if (!m_openLocal()) {
+                m_connectRemote();
+            }
+            OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
+                             << src << " sensor " << m_sensor.get_value_or(-1)
+                             << (m_local ? " using local reports" : ""));
+        }
+        virtual ~TrackerHandler() {
+            m_disconnectRemote();
+            m_conn->unregister_handler(m_droppedType,
+                                       &TrackerHandler::handleDropped, this,
+                                       vrpn_ANY_SENDER);
+        }
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
+            auto self = static_cast<TrackerHandler *>(userdata);
+            self->m_handle(info);
+        }
+        static void VRPN_CALLBACK handleVel(void *userdata,
+                                            vrpn_TRACKERVELCB info) {
+            auto self = static_cast<TrackerHandler *>(userdata);
+            self->m_handle(info);
+        }
+        static void VRPN_CALLBACK handleAccel(void *userdata,
+                                              vrpn_TRACKERACCCB info) {
+            auto self = static_cast<TrackerHandler *>(userdata);
+            self->m_handle(info);
+        }
+        static int VRPN_CALLBACK handleDropped(void *userdata,
+                                               vrpn_HANDLERPARAM) {
+            auto self = static_cast<TrackerHandler *>(userdata);
+            self->m_connectionDropped = true;
+            return 0;
+        }
+
+        /// The callbacks (or the local channel) only queue transformed
+        /// reports: they're delivered to the interfaces afterwards, once every
+        /// handler has received its share of them.
+        virtual void update() {
+            m_now = util::time::getNow();
+            if (m_local && m_localIsStale()) {
+                OSVR_DEV_VERBOSE("Local report channel "
+                                 << m_local->getName()
+                                 << " went stale, using the connection");
+                m_local.reset();
+                m_connectRemote();
+            } else if (!m_local && !m_localNamespace.empty() &&
+                       m_conn->connected() &&
+                       util::time::duration(m_now, m_lastOpenAttempt) >
+                           LOCAL_REOPEN_SECONDS &&
+                       m_openLocal()) {
+                m_disconnectRemote();
+            }
+            if (m_local) {
+                common::LocalTrackerReport report;
+                while (m_local->receive(report)) {
+                    m_handle(report);
+                    m_lastLocal = m_now;
+                }
+            }
+            if (m_dev) {
+                m_dev->update();
+            }
+            if (m_remote) {
+                m_remote->mainloop();
+            }
+            if (m_gotNative) {
+                // Not done from the handler, since it's called while
+                // the connection is dispatching messages.
+                m_dropRemote();
+            }
+        }
+
+        virtual void applyPendingState() {
+            m_deliverPending(RemoteHandlerInternals::SetState());
+        }
+
+        virtual void triggerPendingCallbacks() {
+            m_deliverPending(RemoteHandlerInternals::TriggerCallbacks());
+            /// Keeps its capacity, so steady-state delivery doesn't allocate.
+            m_pending.clear();
+        }
+
+      private:
+        /// Tries to open the device's local report channel, if it has one.
+        ///
+        /// @return true if it's open.
+        bool m_openLocal() {
+            m_lastOpenAttempt = util::time::getNow();
+            if (m_localNamespace.empty()) {
+                return false;
+            }
+            m_local = common::LocalReportChannel::open(m_localNamespace,
+                                                       m_localDevice);
+            m_lastLocal = m_lastOpenAttempt;
+            m_connectionDropped = false;
+            return bool(m_local);
+        }
+
+        /// Whether the local channel will bring no more reports, so the
+        /// connection's should be used instead.
+        bool m_localIsStale() {
+            if (m_connectionDropped || !m_local->isWriterOpen()) {
+                return true;
+            }
+            if (util::time::duration(m_now, m_lastLocal) <=
+                LOCAL_RECHECK_SECONDS) {
+                return false;
+            }
+            /// Quiet for a while: a server that crashed never closes its
+            /// channel, and a restarted one replaces it, so make sure this is
+            /// still the channel published under its name.
+            m_lastLocal = m_now;
+            auto current = common::LocalReportChannel::open(m_localNamespace,
+                                                            m_localDevice);
+            if (!current) {
+                return true;
+            }
+            if (current->getGeneration() != m_local->getGeneration()) {
+                OSVR_DEV_VERBOSE("Local report channel "
+                                 << m_local->getName() << " was replaced");
+                m_local = std::move(current);
+            }
+            return false;
+        }
+
+        /// Registers for tracker messages on the connection: native ones, and
+        /// VRPN ones unless the server is known to send native ones.
+        void m_connectRemote() {
+            if (m_dev) {
+                return;
+            }
+            m_dev = common::createClientDevice(m_src, m_conn);
+            auto native = common::TrackerComponent::create();
+            m_dev->addComponent(native);
+            if (m_info.reportsPosition || m_info.reportsOrientation) {
+                native->registerPoseHandler(
+                    [&](OSVR_PoseReport const &report,
+                        util::time::TimeValue const &timestamp) {
+                        m_handle(report, timestamp);
+                    });
+                native->registerPoseBatchHandler(
+                    [&](std::vector<OSVR_PoseReport> const &reports,
+                        util::time::TimeValue const &timestamp) {
+                        for (auto const &report : reports) {
+                            m_handle(report, timestamp);
+                        }
+                    });
+            }
+            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
+                native->registerVelocityHandler(
+                    [&](OSVR_VelocityReport const &report,
+                        util::time::TimeValue const &timestamp) {
+                        m_handle(report, timestamp);
+                    });
+            }
+            if (m_info.reportsLinearAcceleration ||
+                m_info.reportsAngularAcceleration) {
+                native->registerAccelerationHandler(
+                    [&](OSVR_AccelerationReport const &report,
+                        util::time::TimeValue const &timestamp) {
+                        m_handle(report, timestamp);
+                    });
+            }
+            if (m_gotNative) {
+                return;
+            }
+
+            m_remote.reset(
+                new vrpn_Tracker_Remote(m_src.c_str(), m_conn.get()));
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->register_change_handler(this,
-                                                  &VRPNTrackerHandler::handle,
+                                                  &TrackerHandler::handle,
                                                   m_sensor.get_value_or(-1));
             }
             if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
                 m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
+                    this, &TrackerHandler::handleVel,
                     m_sensor.get_value_or(-1));
             }
             if (m_info.reportsLinearAcceleration ||
                 m_info.reportsAngularAcceleration) {
                 m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
+                    this, &TrackerHandler::handleAccel,
                     m_sensor.get_value_or(-1));
             }
-            OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
-                             << src << " sensor " << m_sensor.get_value_or(-1));
         }
-        virtual ~VRPNTrackerHandler() {
+
+        /// Unregisters all tracker message handlers from the connection, so
+        /// its tracker messages are no longer even parsed.
+        void m_disconnectRemote() {
+            m_dropRemote();
+            m_dev.reset();
+        }
+
+        /// Stops receiving VRPN tracker messages: their handlers are
+        /// unregistered so they're no longer even parsed.
+        void m_dropRemote() {
+            if (!m_remote) {
+                return;
+            }
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->unregister_change_handler(this,
-                                                    &VRPNTrackerHandler::handle,
+                                                    &TrackerHandler::handle,
                                                     m_sensor.get_value_or(-1));
             }
             if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
                 m_remote->unregister_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
+                    this, &TrackerHandler::handleVel,
                     m_sensor.get_value_or(-1));
             }
             if (m_info.reportsLinearAcceleration ||
                 m_info.reportsAngularAcceleration) {
                 m_remote->unregister_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
+                    this, &TrackerHandler::handleAccel,
                     m_sensor.get_value_or(-1));
             }
+            m_remote.reset();
         }
 
-        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        enum class PendingType { Pose, Velocity, Acceleration };
+        /// @brief A report received during mainloop, already transformed,
+        /// waiting to be delivered.
+        struct PendingReport {
+            PendingType type;
+            OSVR_TimeValue timestamp;
+            union {
+                OSVR_PoseReport pose;
+                OSVR_VelocityReport velocity;
+                OSVR_AccelerationReport acceleration;
+            };
+        };
 
-        common::Transform getCurrentTransform() const {
-            auto ret = m_transform;
-            ret.transform(m_ctx.getRoomToWorldTransform());
-            return ret;
+        /// @brief Returns the sensor transform composed with the room to world
+        /// transform, recomputing it only if the latter has changed since the
+        /// last call. (Changes to the path tree result in new handlers.)
+        common::Transform &m_getCurrentTransform() {
+            auto generation = m_ctx.getRoomToWorldTransformGeneration();
+            if (!m_composedValid || generation != m_composedGeneration) {
+                m_composed = m_transform;
+                m_composed.transform(m_ctx.getRoomToWorldTransform());
+                m_composedGeneration = generation;
+                m_composedValid = true;
+            }
+            return m_composed;
         }
 
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
-            auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
+        PendingReport &m_addPending(PendingType type,
+                                    OSVR_TimeValue const &timestamp) {
+            m_pending.emplace_back();
+            auto &pending = m_pending.back();
+            pending.type = type;
+            pending.timestamp = timestamp;
+            return pending;
         }
-        static void VRPN_CALLBACK handleVel(void *userdata,
-                                            vrpn_TRACKERVELCB info) {
-            auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
-        }
-        static void VRPN_CALLBACK handleAccel(void *userdata,
-                                              vrpn_TRACKERACCCB info) {
-            auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
-        }
-        virtual void update() { m_remote->mainloop(); }
 
-      private:
-        /// Pass pose messages on to the client
+        /// Queue pose messages for the client
         void m_handle(vrpn_TRACKERCB const &info) {
-            common::tracing::markNewTrackerData();
-            OSVR_PoseReport report;
-            report.sensor = info.sensor;
+            if (m_gotNative) {
+                return;
+            }
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            auto xform = getCurrentTransform();
-            ei::map(report.pose) =
-                xform.transform(ei::map(report.pose).matrix());
+            OSVR_PoseState pose;
+            osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+            osvrVec3FromQuatlib(&(pose.translation), info.pos);
+            m_queuePose(info.sensor, timestamp, pose);
+        }
 
-            if (m_opts.reportPose) {
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
+        /// Queue velocity messages for the client
+        void m_handle(vrpn_TRACKERVELCB const &info) {
+            if (m_gotNative) {
+                return;
             }
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_VelocityState state;
+            state.linearVelocityValid = OSVR_TRUE;
+            state.angularVelocityValid = OSVR_TRUE;
+            osvrVec3FromQuatlib(&(state.linearVelocity), info.vel);
+            osvrQuatFromQuatlib(&(state.angularVelocity.incrementalRotation),
+                                info.vel_quat);
+            state.angularVelocity.dt = info.vel_quat_dt;
+            m_queueVelocity(info.sensor, timestamp, state);
+        }
 
-            if (m_opts.reportPosition) {
-                OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
-                positionReport.xyz = report.pose.translation;
-
-                m_internals.setStateAndTriggerCallbacks(timestamp,
-                                                        positionReport);
+        /// Queue acceleration messages for the client
+        void m_handle(vrpn_TRACKERACCCB const &info) {
+            if (m_gotNative) {
+                return;
             }
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_AccelerationState state;
+            state.linearAccelerationValid = OSVR_TRUE;
+            state.angularAccelerationValid = OSVR_TRUE;
+            osvrVec3FromQuatlib(&(state.linearAcceleration), info.acc);
+            osvrQuatFromQuatlib(
+                &(state.angularAcceleration.incrementalRotation),
+                info.acc_quat);
+            state.angularAcceleration.dt = info.acc_quat_dt;
+            m_queueAcceleration(info.sensor, timestamp, state);
+        }
 
-            if (m_opts.reportOrientation) {
-                OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
-                oriReport.rotation = report.pose.rotation;
+        /// Called for every native report: the first one means the server
+        /// sends them, so VRPN tracker messages are ignored from then on.
+        void m_checkNative() {
+            if (m_gotNative) {
+                return;
+            }
+            OSVR_DEV_VERBOSE("Got a native tracker report, ignoring VRPN "
+                             "tracker messages from now on");
+            m_gotNative = true;
+            // Anything queued so far is a VRPN copy of this report.
+            m_pending.clear();
+        }
 
-                m_internals.setStateAndTriggerCallbacks(timestamp, oriReport);
+        /// Queue native pose messages for the client
+        void m_handle(OSVR_PoseReport const &report,
+                      util::time::TimeValue const &timestamp) {
+            m_checkNative();
+            if (m_sensor && report.sensor != *m_sensor) {
+                return;
             }
+            m_queuePose(report.sensor, timestamp, report.pose);
         }
 
-        /// Pass velocity messages on to the client
-        void m_handle(vrpn_TRACKERVELCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
+        /// Queue native velocity messages for the client
+        void m_handle(OSVR_VelocityReport const &report,
+                      util::time::TimeValue const &timestamp) {
+            m_checkNative();
+            if (m_sensor && report.sensor != *m_sensor) {
+                return;
+            }
+            m_queueVelocity(report.sensor, timestamp, report.state);
+        }
 
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+        /// Queue native acceleration messages for the client
+        void m_handle(OSVR_AccelerationReport const &report,
+                      util::time::TimeValue const &timestamp) {
+            m_checkNative();
+            if (m_sensor && report.sensor != *m_sensor) {
+                return;
+            }
+            m_queueAcceleration(report.sensor, timestamp, report.state);
+        }
 
-            OSVR_VelocityReport overallReport;
-            overallReport.sensor = info.sensor;
-            auto xform = getCurrentTransform();
+        /// Queue reports from the local channel for the client, filtered the
+        /// way the VRPN change handlers would be.
+        void m_handle(common::LocalTrackerReport const &report) {
+            if (m_sensor && report.sensor != OSVR_ChannelCount(*m_sensor)) {
+                return;
+            }
+            typedef common::LocalTrackerReport::Type Type;
+            switch (report.type) {
+            case Type::Pose:
+                if (m_info.reportsPosition || m_info.reportsOrientation) {
+                    m_queuePose(report.sensor, report.timestamp, report.pose);
+                }
+                break;
+            case Type::Velocity:
+                if (m_info.reportsLinearVelocity ||
+                    m_info.reportsAngularVelocity) {
+                    m_queueVelocity(report.sensor, report.timestamp,
+                                    report.velocity);
+                }
+                break;
+            case Type::Acceleration:
+                if (m_info.reportsLinearAcceleration ||
+                    m_info.reportsAngularAcceleration) {
+                    m_queueAcceleration(report.sensor, report.timestamp,
+                                        report.acceleration);
+                }
+                break;
+            }
+        }
 
-            overallReport.state.linearVelocityValid =
-                m_info.reportsLinearVelocity;
-            if (m_info.reportsLinearVelocity) {
-                OSVR_LinearVelocityState vel;
-                osvrVec3FromQuatlib(&(vel), info.vel);
+        void m_queuePose(OSVR_ChannelCount sensor,
+                         OSVR_TimeValue const &timestamp,
+                         OSVR_PoseState const &pose) {
+            common::tracing::markNewTrackerData();
+            auto &report = m_addPending(PendingType::Pose, timestamp).pose;
+            report.sensor = sensor;
+            auto &xform = m_getCurrentTransform();
+            ei::map(report.pose) = xform.transform(ei::map(pose).matrix());
+        }
 
+        void m_queueVelocity(OSVR_ChannelCount sensor,
+                             OSVR_TimeValue const &timestamp,
+                             OSVR_VelocityState const &velocity) {
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
+            auto &report =
+                m_addPending(PendingType::Velocity, timestamp).velocity;
+            report.sensor = sensor;
+            auto &xform = m_getCurrentTransform();
+
+            report.state.linearVelocityValid =
+                m_info.reportsLinearVelocity && velocity.linearVelocityValid;
+            if (report.state.linearVelocityValid) {
+                auto &vel = report.state.linearVelocity;
+                vel = velocity.linearVelocity;
                 ei::map(vel) = xform.transformDerivative(ei::map(vel));
-
-                overallReport.state.linearVelocity = vel;
-                OSVR_LinearVelocityReport report;
-                report.sensor = info.sensor;
-                report.state = vel;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
-            overallReport.state.angularVelocityValid =
-                m_info.reportsAngularVelocity;
-            if (m_info.reportsAngularVelocity) {
-                OSVR_AngularVelocityState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.vel_quat);
-                state.dt = info.vel_quat_dt;
-
+            report.state.angularVelocityValid =
+                m_info.reportsAngularVelocity && velocity.angularVelocityValid;
+            if (report.state.angularVelocityValid) {
+                auto &state = report.state.angularVelocity;
+                state = velocity.angularVelocity;
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
-
-                overallReport.state.angularVelocity = state;
-                OSVR_AngularVelocityReport report;
-                report.sensor = info.sensor;
-                report.state = state;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
-
-            m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
 
-        /// Pass acceleration messages on to the client
-        void m_handle(vrpn_TRACKERACCCB const &info) {
+        void m_queueAcceleration(OSVR_ChannelCount sensor,
+                                 OSVR_TimeValue const &timestamp,
+                                 OSVR_AccelerationState const &acceleration) {
             /// @todo should we be marking a trace event here?
             // common::tracing::markNewTrackerData();
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-
-            OSVR_AccelerationReport overallReport;
-            overallReport.sensor = info.sensor;
-
-            auto xform = getCurrentTransform();
-
-            overallReport.state.linearAccelerationValid =
-                m_info.reportsLinearAcceleration;
-            if (m_info.reportsLinearAcceleration) {
-                OSVR_LinearAccelerationState accel;
-                osvrVec3FromQuatlib(&(accel), info.acc);
-
+            auto &report =
+                m_addPending(PendingType::Acceleration, timestamp)
+                    .acceleration;
+            report.sensor = sensor;
+            auto &xform = m_getCurrentTransform();
+
+            report.state.linearAccelerationValid =
+                m_info.reportsLinearAcceleration &&
+                acceleration.linearAccelerationValid;
+            if (report.state.linearAccelerationValid) {
+                auto &accel = report.state.linearAcceleration;
+                accel = acceleration.linearAcceleration;
                 ei::map(accel) = xform.transformDerivative(ei::map(accel));
-
-                overallReport.state.linearAcceleration = accel;
-                OSVR_LinearAccelerationReport report;
-                report.sensor = info.sensor;
-                report.state = accel;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
-            overallReport.state.angularAccelerationValid =
-                m_info.reportsAngularAcceleration;
-            if (m_info.reportsAngularAcceleration) {
-
-                OSVR_AngularAccelerationState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.acc_quat);
-                state.dt = info.acc_quat_dt;
 
+            report.state.angularAccelerationValid =
+                m_info.reportsAngularAcceleration &&
+                acceleration.angularAccelerationValid;
+            if (report.state.angularAccelerationValid) {
+                auto &state = report.state.angularAcceleration;
+                state = acceleration.angularAcceleration;
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
+            }
+        }
 
-                overallReport.state.angularAcceleration = state;
-                OSVR_AngularAccelerationReport report;
-                report.sensor = info.sensor;
-                report.state = state;
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
+        /// Pass all reports queued during update on to the client, visiting
+        /// each interface once: @p f either sets state or calls callbacks.
+        template <typename F> void m_deliverPending(F const &f) {
+            if (m_pending.empty()) {
+                return;
             }
+            m_internals.forEachInterface([&](common::ClientInterface &iface) {
+                for (auto const &pending : m_pending) {
+                    m_deliver(iface, pending, f);
+                }
+            });
+        }
 
-            m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
+        template <typename F>
+        void m_deliver(common::ClientInterface &iface,
+                       PendingReport const &pending, F const &f) {
+            auto const &timestamp = pending.timestamp;
+            switch (pending.type) {
+            case PendingType::Pose: {
+                auto const &report = pending.pose;
+                if (m_opts.reportPose) {
+                    f(iface, timestamp, report);
+                }
+                if (m_opts.reportPosition) {
+                    OSVR_PositionReport positionReport;
+                    positionReport.sensor = report.sensor;
+                    positionReport.xyz = report.pose.translation;
+                    f(iface, timestamp, positionReport);
+                }
+                if (m_opts.reportOrientation) {
+                    OSVR_OrientationReport oriReport;
+                    oriReport.sensor = report.sensor;
+                    oriReport.rotation = report.pose.rotation;
+                    f(iface, timestamp, oriReport);
+                }
+                break;
+            }
+            case PendingType::Velocity: {
+                auto const &overall = pending.velocity;
+                if (overall.state.linearVelocityValid) {
+                    OSVR_LinearVelocityReport report;
+                    report.sensor = overall.sensor;
+                    report.state = overall.state.linearVelocity;
+                    f(iface, timestamp, report);
+                }
+                if (overall.state.angularVelocityValid) {
+                    OSVR_AngularVelocityReport report;
+                    report.sensor = overall.sensor;
+                    report.state = overall.state.angularVelocity;
+                    f(iface, timestamp, report);
+                }
+                f(iface, timestamp, overall);
+                break;
+            }
+            case PendingType::Acceleration: {
+                auto const &overall = pending.acceleration;
+                if (overall.state.linearAccelerationValid) {
+                    OSVR_LinearAccelerationReport report;
+                    report.sensor = overall.sensor;
+                    report.state = overall.state.linearAcceleration;
+                    f(iface, timestamp, report);
+                }
+                if (overall.state.angularAccelerationValid) {
+                    OSVR_AngularAccelerationReport report;
+                    report.sensor = overall.sensor;
+                    report.state = overall.state.angularAcceleration;
+                    f(iface, timestamp, report);
+                }
+                f(iface, timestamp, overall);
+                break;
+            }
+            }
         }
+
+        vrpn_ConnectionPtr m_conn;
+        std::string m_src;
+        vrpn_int32 m_droppedType = 0;
+        bool m_connectionDropped = false;
+        /// Only while not using a local channel.
+        common::BaseDevicePtr m_dev;
         unique_ptr<vrpn_Tracker_Remote> m_remote;
+        bool m_gotNative = false;
+        std::string m_localNamespace;
+        std::string m_localDevice;
+        common::LocalReportChannelPtr m_local;
+        /// When the local channel last brought a report or was checked.
+        util::time::TimeValue m_lastLocal = {};
+        util::time::TimeValue m_lastOpenAttempt = {};
+        /// When the current update() started.
+        util::time::TimeValue m_now = {};
         common::Transform m_transform;
+        common::Transform m_composed;
+        std::size_t m_composedGeneration = 0;
+        bool m_composedValid = false;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
         Options m_opts;
         common::TrackerSensorInfo m_info;
         boost::optional<int> m_sensor;
+        std::vector<PendingReport> m_pending;
     };
 
     TrackerRemoteFactory::TrackerRemoteFactory(
@@ -287,7 +665,7 @@ namespace client {
 
         auto info = common::getTrackerSensorInfo(source);
 
-        VRPNTrackerHandler::Options opts;
+        TrackerHandler::Options opts;
         /// @todo right now always reporting pose if we report either position
         /// or orientation as a backward-compatibility move, since we did so
         /// before, at least until we have a report like pose with validity
@@ -304,10 +682,15 @@ namespace client {
             xform = xformParse.getTransform();
         }
 
+        /// Prefer shared memory for devices that publish their reports on
+        /// this host.
+        auto localNamespace = m_conns.getLocalReportNamespace(devElt);
+
         /// @todo find out why make_shared causes a crash here
-        ret.reset(new VRPNTrackerHandler(
-            m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
-            opts, info, xform, source.getSensorNumber(), ifaces, ctx));
+        ret.reset(new TrackerHandler(
+            m_conns.getConnection(devElt), localNamespace,
+            devElt.getDeviceName(), devElt.getFullDeviceName().c_str(), opts,
+            info, xform, source.getSensorNumber(), ifaces, ctx));
         return ret;
     }
 
@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include "VRPNConnectionCollection.h"
+#include <osvr/Common/LocalReportChannel.h>
 
 // Library/third-party includes
 #include <vrpn_Connection.h>
@@ -34,7 +35,8 @@
 namespace osvr {
 namespace client {
     VRPNConnectionCollection::VRPNConnectionCollection()
-        : m_connMap(make_shared<ConnectionMap>()) {}
+        : m_connMap(make_shared<ConnectionMap>()),
+          m_localNamespaces(make_shared<NamespaceMap>()) {}
 
     vrpn_ConnectionPtr VRPNConnectionCollection::getConnection(
         common::elements::DeviceElement const &elt) {
@@ -79,5 +81,21 @@ namespace client {
         }
     }
 
+    void
+    VRPNConnectionCollection::setLocalReportNamespace(std::string const &host,
+                                                      std::string const &ns) {
+        (*m_localNamespaces)[host] = ns;
+    }
+
+    std::string VRPNConnectionCollection::getLocalReportNamespace(
+        common::elements::DeviceElement const &elt) const {
+        auto const &host = elt.getServer();
+        auto existing = m_localNamespaces->find(host);
+        if (existing != end(*m_localNamespaces)) {
+            return existing->second;
+        }
+        return common::LocalReportChannel::getNamespaceForServer(host);
+    }
+
 } // namespace client
 } // namespace osvr
@@ -51,6 +51,19 @@ namespace client {
         vrpn_ConnectionPtr
         getConnection(common::elements::DeviceElement const &elt);
         OSVR_CLIENT_EXPORT void updateAll();
+
+        /// @brief Records the namespace in which devices on the given host
+        /// publish local reports, when it's known directly rather than worked
+        /// out from the host and port (as for a server in this process).
+        OSVR_CLIENT_EXPORT void
+        setLocalReportNamespace(std::string const &host,
+                                std::string const &ns);
+
+        /// @brief Gets the namespace in which the device publishes local
+        /// reports, or an empty string if it's not on this host.
+        std::string
+        getLocalReportNamespace(common::elements::DeviceElement const &elt)
+            const;
         bool empty() const {
             return m_connMap->empty();
         }
@@ -59,6 +72,8 @@ namespace client {
         typedef std::unordered_map<std::string, vrpn_ConnectionPtr>
             ConnectionMap;
         shared_ptr<ConnectionMap> m_connMap;
+        typedef std::unordered_map<std::string, std::string> NamespaceMap;
+        shared_ptr<NamespaceMap> m_localNamespaces;
     };
 
 } // namespace client
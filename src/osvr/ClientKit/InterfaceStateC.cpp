@@ -61,3 +61,11 @@ OSVR_CALLBACK_METHODS(NaviVelocity)
 OSVR_CALLBACK_METHODS(NaviPosition)
 
 #undef OSVR_CALLBACK_METHODS
+
+OSVR_ReturnCode
+osvrGetPredictedPoseState(OSVR_ClientInterface iface,
+                          struct OSVR_TimeValue const *targetTime,
+                          OSVR_PoseState *state) {
+    bool hasState = iface->getPredictedPose(*targetTime, *state);
+    return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
@@ -152,6 +152,12 @@ OSVR_ClientContextObject::getRoomToWorldTransform() const {
 void OSVR_ClientContextObject::setRoomToWorldTransform(
     osvr::common::Transform const &xform) {
     m_setRoomToWorldTransform(xform);
+    ++m_roomToWorldGeneration;
+}
+
+std::size_t
+OSVR_ClientContextObject::getRoomToWorldTransformGeneration() const {
+    return m_roomToWorldGeneration;
 }
 
 ClientContextDeleter OSVR_ClientContextObject::getDeleter() const {
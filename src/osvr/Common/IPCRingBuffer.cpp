@@ -52,7 +52,7 @@ namespace common {
     /// shared-memory objects (Bookkeeping, ElementData) changes, if Boost
     /// Interprocess changes affect the utilized ABI, or if other changes occur
     /// that would interfere with communication.
-    static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 0;
+    static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 1;
 
 /// Some tests that can be automated for ensuring validity of the ABI level
 /// number.
@@ -109,9 +109,10 @@ namespace common {
             size_t alignedEntrySize = opts.getEntrySize() + opts.getAlignment();
             size_t dataSize = alignedEntrySize * (opts.getEntries() + 1);
             // Give 33% overhead on the raw bookkeeping data
-            static const size_t BOOKKEEPING_SIZE =
+            const size_t BOOKKEEPING_SIZE =
                 (sizeof(detail::Bookkeeping) +
-                 (sizeof(detail::ElementData) * opts.getEntries())) *
+                 (sizeof(detail::ElementData) * opts.getEntries()) +
+                 (sizeof(detail::ReaderCursor) * opts.getMaxReaders())) *
                 4 / 3;
             return dataSize + BOOKKEEPING_SIZE;
         }
@@ -294,6 +295,12 @@ namespace common {
         m_entrySize = entrySize;
         return *this;
     }
+
+    IPCRingBuffer::Options &
+    IPCRingBuffer::Options::setMaxReaders(reader_count_type readers) {
+        m_maxReaders = readers;
+        return *this;
+    }
     class IPCRingBuffer::Impl {
       public:
         Impl(unique_ptr<SharedMemorySegmentHolder> &&segment,
@@ -302,16 +309,52 @@ namespace common {
             m_bookkeeping = m_seg->getBookkeeping();
             m_opts.setEntries(m_bookkeeping->getCapacity());
             m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            m_opts.setMaxReaders(m_bookkeeping->getReaderCapacity());
+        }
+
+        ~Impl() {
+            if (m_hasReader) {
+                m_bookkeeping->releaseReader(m_reader);
+            }
         }
 
         detail::IPCPutResultPtr put() {
-            return m_bookkeeping->produceElement();
+            auto ret = m_bookkeeping->produceElement();
+            /// The bounds have been updated and we hold the element lock, so
+            /// we can let readers of other elements proceed while the caller
+            /// fills this one.
+            ret->boundsLock.unlock();
+            return ret;
         }
 
         detail::IPCGetResultPtr get(sequence_type num) {
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
+            if (nullptr != elt) {
+                if (m_hasReader) {
+                    m_bookkeeping->noteRead(m_reader, num);
+                }
+                auto readerLock = elt->getSharableLock();
+                auto buf = elt->getBuf(readerLock);
+                /// The nullptr will be filled in by the main object.
+                ret.reset(new detail::IPCGetResult{buf, std::move(readerLock),
+                                                   num, nullptr});
+            }
+            return ret;
+        }
+
+        detail::IPCGetResultPtr getNext() {
+            detail::IPCGetResultPtr ret;
+            if (!m_hasReader) {
+                return ret;
+            }
+            auto boundsLock = m_bookkeeping->getSharableLock();
+            sequence_type num;
+            if (!m_bookkeeping->claimNext(m_reader, num, boundsLock)) {
+                return ret;
+            }
+            auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
             if (nullptr != elt) {
                 auto readerLock = elt->getSharableLock();
                 auto buf = elt->getBuf(readerLock);
@@ -337,6 +380,41 @@ namespace common {
             return ret;
         }
 
+        bool registerReader() {
+            if (!m_hasReader) {
+                m_hasReader = m_bookkeeping->acquireReader(m_reader);
+            }
+            return m_hasReader;
+        }
+
+        bool hasReader() const { return m_hasReader; }
+
+        bool waitForNext(uint32_t timeoutMilliseconds) {
+            if (!m_hasReader) {
+                return false;
+            }
+            namespace pt = boost::posix_time;
+            auto deadline = pt::microsec_clock::universal_time() +
+                            pt::milliseconds(timeoutMilliseconds);
+            return m_bookkeeping->waitForNext(m_reader, deadline);
+        }
+
+        ReaderStats getReaderStats() const {
+            if (!m_hasReader) {
+                return ReaderStats{};
+            }
+            return m_bookkeeping->getReaderStats(m_reader);
+        }
+
+        std::vector<ReaderStats> getAllReaderStats() const {
+            std::vector<ReaderStats> ret;
+            auto n = m_bookkeeping->getReaderCapacity();
+            for (reader_count_type i = 0; i < n; ++i) {
+                ret.push_back(m_bookkeeping->getReaderStats(i));
+            }
+            return ret;
+        }
+
         Options const &getOpts() const { return m_opts; }
 
       private:
@@ -344,6 +422,8 @@ namespace common {
         detail::Bookkeeping *m_bookkeeping;
 
         Options m_opts;
+        bool m_hasReader = false;
+        reader_count_type m_reader = 0;
     };
 
     IPCRingBufferPtr IPCRingBuffer::m_constructorHelper(Options const &opts,
@@ -439,5 +519,26 @@ namespace common {
         return BufferReadProxy(m_impl->getLatest(), shared_from_this());
     }
 
+    bool IPCRingBuffer::registerReader() { return m_impl->registerReader(); }
+
+    bool IPCRingBuffer::hasReaderCursor() const { return m_impl->hasReader(); }
+
+    IPCRingBuffer::BufferReadProxy IPCRingBuffer::getNext() {
+        return BufferReadProxy(m_impl->getNext(), shared_from_this());
+    }
+
+    bool IPCRingBuffer::waitForNext(uint32_t timeoutMilliseconds) {
+        return m_impl->waitForNext(timeoutMilliseconds);
+    }
+
+    IPCRingBuffer::ReaderStats IPCRingBuffer::getReaderStats() const {
+        return m_impl->getReaderStats();
+    }
+
+    std::vector<IPCRingBuffer::ReaderStats>
+    IPCRingBuffer::getAllReaderStats() const {
+        return m_impl->getAllReaderStats();
+    }
+
 } // namespace common
 } // namespace osvr
@@ -40,20 +40,17 @@ namespace osvr {
 namespace common {
 
     namespace detail {
+        class Bookkeeping;
         struct IPCPutResult {
-            ~IPCPutResult() {
-#ifdef OSVR_SHM_LOCK_DEBUGGING
-                OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence "
-                                 << seq);
-#endif
-                elementLock.unlock();
-                boundsLock.unlock();
-            }
+            /// @brief Releases the locks and publishes the entry to waiting
+            /// readers: defined along with Bookkeeping.
+            inline ~IPCPutResult();
             IPCRingBuffer::value_type *buffer;
             IPCRingBuffer::sequence_type seq;
             ipc::exclusive_lock_type elementLock;
             ipc::exclusive_lock_type boundsLock;
             IPCRingBufferPtr shm;
+            Bookkeeping *bookkeeping;
         };
 
         struct IPCGetResult {
@@ -35,8 +35,12 @@
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 // Standard includes
+#include <limits>
 #include <utility>
 
 namespace osvr {
@@ -76,10 +80,22 @@ namespace common {
             ipc_offset_ptr<BufferType> m_buf;
         };
 
+        /// @brief A registered reader's position, kept in shared memory so
+        /// the producer can see it.
+        struct ReaderCursor {
+            ReaderCursor() : inUse(false), next(0), consumed(0), missed(0) {}
+            bool inUse;
+            IPCRingBuffer::sequence_type next;
+            uint64_t consumed;
+            uint64_t missed;
+        };
+
         class Bookkeeping : public ipc::ObjectWithMutex, boost::noncopyable {
           public:
             typedef IPCRingBuffer::sequence_type sequence_type;
             typedef uint16_t raw_index_type;
+            typedef IPCRingBuffer::reader_count_type reader_index_type;
+            typedef bip::scoped_lock<bip::interprocess_mutex> notify_lock_type;
 
             template <typename ManagedMemory>
             static Bookkeeping *find(ManagedMemory &shm) {
@@ -111,8 +127,15 @@ namespace common {
                   elementArray(shm.template construct<ElementData>(
                       bip::unique_instance)[m_capacity]()),
                   m_beginSequenceNumber(0), m_nextSequenceNumber(0), m_begin(0),
-                  m_size(0), m_bufLen(opts.getEntrySize()) {
+                  m_size(0), m_bufLen(opts.getEntrySize()),
+                  m_readerCapacity(opts.getMaxReaders()),
+                  m_readers(nullptr),
+                  m_publishedSequenceNumber(0) {
 
+                if (m_readerCapacity > 0) {
+                    m_readers = shm.template construct<ReaderCursor>(
+                        bip::unique_instance)[m_readerCapacity]();
+                }
                 auto lock = getExclusiveLock();
                 {
                     for (raw_index_type i = 0; i < m_capacity; ++i) {
@@ -137,6 +160,11 @@ namespace common {
                         getByRawIndex(i, lock).freeBuf(shm);
                     }
                     shm.template destroy<ElementData>(bip::unique_instance);
+                    if (m_readers) {
+                        shm.template destroy<ReaderCursor>(
+                            bip::unique_instance);
+                        m_readers = nullptr;
+                    }
                 }
             }
 
@@ -201,7 +229,123 @@ namespace common {
                 /// shared memory nullptr filled in by outer class
                 IPCPutResultPtr ret(new IPCPutResult{
                     back(lock)->getBuf(elementLock), sequenceNumber,
-                    std::move(elementLock), std::move(lock), nullptr});
+                    std::move(elementLock), std::move(lock), nullptr, this});
+                return ret;
+            }
+
+            /// @brief Called once an entry has been filled in: records it as
+            /// available to cursor readers and wakes any waiting ones.
+            void publish(sequence_type seq) {
+                {
+                    notify_lock_type lock(m_notifyMutex);
+                    auto next = sequence_type(seq + 1);
+                    /// Only move forward (mod 2^32), in case write proxies are
+                    /// released out of order.
+                    if (sequence_type(next - m_publishedSequenceNumber) <
+                        sequence_type(m_capacity) + 1) {
+                        m_publishedSequenceNumber = next;
+                    }
+                }
+                m_notifyCond.notify_all();
+            }
+
+            /// @brief Get the number of reader slots.
+            reader_index_type getReaderCapacity() const {
+                return m_readerCapacity;
+            }
+
+            /// @brief Claims a free reader slot, with the cursor at the next
+            /// entry to be published.
+            /// @returns false if there was no free slot.
+            bool acquireReader(reader_index_type &index) {
+                notify_lock_type lock(m_notifyMutex);
+                for (reader_index_type i = 0; i < m_readerCapacity; ++i) {
+                    auto &reader = m_readers[i];
+                    if (!reader.inUse) {
+                        reader = ReaderCursor{};
+                        reader.inUse = true;
+                        reader.next = m_publishedSequenceNumber;
+                        index = i;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void releaseReader(reader_index_type index) {
+                notify_lock_type lock(m_notifyMutex);
+                m_readers[index].inUse = false;
+            }
+
+            /// @brief Advances a reader's cursor past the next available
+            /// entry, counting any it can no longer get as missed.
+            ///
+            /// @returns false if there are no unconsumed published entries.
+            template <typename LockType>
+            bool claimNext(reader_index_type index, sequence_type &seq,
+                           LockType &boundsLock) {
+                verifyReaderLock(boundsLock);
+                notify_lock_type lock(m_notifyMutex);
+                auto &reader = m_readers[index];
+                auto published = m_publishedSequenceNumber;
+                if (reader.next == published) {
+                    return false;
+                }
+                /// Compare distances back from the published end, to be
+                /// robust to sequence number wraparound.
+                if (sequence_type(published - reader.next) >
+                    sequence_type(published - m_beginSequenceNumber)) {
+                    reader.missed += sequence_type(m_beginSequenceNumber -
+                                                   reader.next);
+                    reader.next = m_beginSequenceNumber;
+                    if (reader.next == published) {
+                        return false;
+                    }
+                }
+                seq = reader.next;
+                reader.next++;
+                reader.consumed++;
+                return true;
+            }
+
+            /// @brief Records that a reader explicitly accessed a given entry:
+            /// moves its cursor past it, counting any it skipped as missed.
+            void noteRead(reader_index_type index, sequence_type seq) {
+                notify_lock_type lock(m_notifyMutex);
+                auto &reader = m_readers[index];
+                auto skipped = sequence_type(seq - reader.next);
+                if (skipped > (std::numeric_limits<sequence_type>::max)() / 2) {
+                    /// Re-reading an older entry (serial number arithmetic):
+                    /// doesn't move the cursor.
+                    return;
+                }
+                reader.missed += skipped;
+                reader.next = seq + 1;
+                reader.consumed++;
+            }
+
+            /// @brief Waits for an entry past the reader's cursor to be
+            /// published.
+            bool waitForNext(reader_index_type index,
+                             boost::posix_time::ptime const &deadline) {
+                notify_lock_type lock(m_notifyMutex);
+                auto &reader = m_readers[index];
+                return m_notifyCond.timed_wait(lock, deadline, [&] {
+                    return reader.next != m_publishedSequenceNumber;
+                });
+            }
+
+            IPCRingBuffer::ReaderStats getReaderStats(reader_index_type index) {
+                notify_lock_type lock(m_notifyMutex);
+                IPCRingBuffer::ReaderStats ret;
+                auto const &reader = m_readers[index];
+                ret.active = reader.inUse;
+                if (reader.inUse) {
+                    ret.next = reader.next;
+                    ret.consumed = reader.consumed;
+                    ret.missed = reader.missed;
+                    ret.lag = m_publishedSequenceNumber - reader.next;
+                }
                 return ret;
             }
 
@@ -213,7 +357,28 @@ namespace common {
             raw_index_type m_begin;
             raw_index_type m_size;
             uint32_t m_bufLen;
+            reader_index_type m_readerCapacity;
+            ipc_offset_ptr<ReaderCursor> m_readers;
+            /// @brief One past the most recent entry completely written.
+            IPCRingBuffer::sequence_type m_publishedSequenceNumber;
+            /// @brief Guards the reader cursors and the published sequence
+            /// number.
+            bip::interprocess_mutex m_notifyMutex;
+            bip::interprocess_condition m_notifyCond;
         };
+
+        inline IPCPutResult::~IPCPutResult() {
+#ifdef OSVR_SHM_LOCK_DEBUGGING
+            OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence " << seq);
+#endif
+            elementLock.unlock();
+            if (boundsLock.owns()) {
+                boundsLock.unlock();
+            }
+            if (bookkeeping) {
+                bookkeeping->publish(seq);
+            }
+        }
     } // namespace detail
 
 } // namespace common
@@ -193,15 +193,40 @@ namespace common {
         const char *ImagePlacedInSharedMemory::identifier() {
             return "com.osvr.imaging.imageplacedinsharedmemory";
         }
+
+        class ImageWireRequest::MessageSerialization {
+          public:
+            MessageSerialization() : m_sensor(0) {}
+            explicit MessageSerialization(OSVR_ChannelCount sensor)
+                : m_sensor(sensor) {}
+
+            template <typename T> void processMessage(T &p) { p(m_sensor); }
+
+            OSVR_ChannelCount getSensor() const { return m_sensor; }
+
+          private:
+            OSVR_ChannelCount m_sensor;
+        };
+
+        const char *ImageWireRequest::identifier() {
+            return "com.osvr.imaging.imagewirerequest";
+        }
     } // namespace messages
 
+    /// @brief How long a request for wire images from a client stays in effect.
+    static const double WIRE_REQUEST_LIFETIME = 3.0;
+    /// @brief How often a client that can't use shared memory re-sends its
+    /// request for wire images. Must be shorter than the lifetime above.
+    static const double WIRE_REQUEST_INTERVAL = 1.0;
+
     shared_ptr<ImagingComponent>
     ImagingComponent::create(OSVR_ChannelCount numChan) {
         shared_ptr<ImagingComponent> ret(new ImagingComponent(numChan));
         return ret;
     }
     ImagingComponent::ImagingComponent(OSVR_ChannelCount numChan)
-        : m_numSensor(numChan) {}
+        : m_numSensor(numChan),
+          m_wireRequested(numChan, util::time::TimeValue{0, 0}) {}
 
     void ImagingComponent::sendImageData(OSVR_ImagingMetadata metadata,
                                          OSVR_ImageBufferElement *imageData,
@@ -217,13 +242,76 @@ namespace common {
         dataSent += m_sendImageDataViaSharedMemory(metadata, imageData, sensor,
                                                    timestamp);
 #endif
-        dataSent +=
-            m_sendImageDataOnTheWire(metadata, imageData, sensor, timestamp);
+        if (m_isWireRequested(sensor)) {
+            dataSent += m_sendImageDataOnTheWire(metadata, imageData, sensor,
+                                                 timestamp);
+        }
         if (dataSent) {
             m_checkFirst(metadata);
         }
     }
 
+    OSVR_ImageBufferElement *
+    ImagingComponent::acquireImageBuffer(OSVR_ImagingMetadata const &metadata,
+                                         OSVR_ChannelCount sensor) {
+        if (m_acquired.size() <= sensor) {
+            m_acquired.resize(sensor + 1);
+        }
+        auto &frame = m_acquired[sensor];
+        // Abandon any previous frame that was never sent.
+        frame = AcquiredFrame{};
+        frame.metadata = metadata;
+#ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+        frame.inProcessBuffer =
+            util::makeAlignedImageBuffer(getBufferSize(metadata));
+        frame.buffer = frame.inProcessBuffer.get();
+#else
+        auto shm = m_getShmBuf(metadata, sensor);
+        if (!shm) {
+            return nullptr;
+        }
+        frame.shm = m_shmBuf[sensor];
+        frame.proxy.reset(new IPCRingBuffer::BufferWriteProxy(shm->put()));
+        frame.buffer = frame.proxy->get();
+#endif
+        return frame.buffer;
+    }
+
+    bool
+    ImagingComponent::sendAcquiredImageData(OSVR_ChannelCount sensor,
+                                            OSVR_TimeValue const &timestamp) {
+        if (m_acquired.size() <= sensor || !m_acquired[sensor].buffer) {
+            return false;
+        }
+        auto &frame = m_acquired[sensor];
+        // Wire copy comes straight out of the acquired buffer, before we hand
+        // it off.
+        if (m_isWireRequested(sensor)) {
+            m_sendImageDataOnTheWire(frame.metadata, frame.buffer, sensor,
+                                     timestamp);
+        }
+#ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+        m_sendInProcessNotification(frame.metadata,
+                                    std::move(frame.inProcessBuffer), sensor,
+                                    timestamp);
+        auto &stats = m_getStats(sensor).inProcessMemory;
+        stats.frames++;
+        stats.bytes += getBufferSize(frame.metadata);
+#else
+        auto seq = frame.proxy->getSequenceNumber();
+        // Release the element lock before telling anyone about it.
+        frame.proxy.reset();
+        m_sendSharedMemoryNotification(frame.metadata, seq, sensor,
+                                       *frame.shm, timestamp);
+        auto &stats = m_getStats(sensor).sharedMemory;
+        stats.frames++;
+        stats.bytes += getBufferSize(frame.metadata);
+#endif
+        m_checkFirst(frame.metadata);
+        frame = AcquiredFrame{};
+        return true;
+    }
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
     bool ImagingComponent::m_sendImageDataViaInProcessMemory(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
@@ -233,24 +321,32 @@ namespace common {
         auto imageBufferCopy = util::makeAlignedImageBuffer(imageBufferSize);
         memcpy(imageBufferCopy.get(), imageData, imageBufferSize);
 
+        m_sendInProcessNotification(metadata, std::move(imageBufferCopy),
+                                    sensor, timestamp);
+        auto &stats = m_getStats(sensor).inProcessMemory;
+        stats.frames++;
+        stats.bytes += imageBufferSize;
+        return true;
+    }
+
+    void ImagingComponent::m_sendInProcessNotification(
+        OSVR_ImagingMetadata metadata, util::AlignedImageBufferPtr &&buffer,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
         Buffer<> buf;
         messages::ImagePlacedInProcessMemory::MessageSerialization
             serialization(messages::InProcessMemoryMessage{
                 metadata, sensor,
-                reinterpret_cast<intptr_t>(imageBufferCopy.release())});
+                reinterpret_cast<intptr_t>(buffer.release())});
 
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInProcessMemory.getMessageType(), timestamp);
-
-        return true;
     }
 #endif
 
-    bool ImagingComponent::m_sendImageDataViaSharedMemory(
-        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
-        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-
+    IPCRingBuffer *
+    ImagingComponent::m_getShmBuf(OSVR_ImagingMetadata const &metadata,
+                                  OSVR_ChannelCount sensor) {
         m_growShmVecIfRequired(sensor);
         uint32_t imageBufferSize = getBufferSize(metadata);
         if (!m_shmBuf[sensor] ||
@@ -270,11 +366,31 @@ namespace common {
         if (!m_shmBuf[sensor]) {
             OSVR_DEV_VERBOSE(
                 "Some issue creating shared memory for imaging, skipping out.");
+            return nullptr;
+        }
+        return m_shmBuf[sensor].get();
+    }
+
+    bool ImagingComponent::m_sendImageDataViaSharedMemory(
+        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+
+        auto shm = m_getShmBuf(metadata, sensor);
+        if (!shm) {
             return false;
         }
-        auto &shm = *(m_shmBuf[sensor]);
-        auto seq = shm.put(imageData, imageBufferSize);
+        auto seq = shm->put(imageData, getBufferSize(metadata));
+        m_sendSharedMemoryNotification(metadata, seq, sensor, *shm, timestamp);
+        auto &stats = m_getStats(sensor).sharedMemory;
+        stats.frames++;
+        stats.bytes += getBufferSize(metadata);
+        return true;
+    }
 
+    void ImagingComponent::m_sendSharedMemoryNotification(
+        OSVR_ImagingMetadata metadata, IPCRingBuffer::sequence_type seq,
+        OSVR_ChannelCount sensor, IPCRingBuffer const &shm,
+        OSVR_TimeValue const &timestamp) {
         Buffer<> buf;
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
             messages::SharedMemoryMessage{metadata, seq, sensor,
@@ -283,8 +399,6 @@ namespace common {
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInSharedMemory.getMessageType(), timestamp);
-
-        return true;
     }
 
     bool ImagingComponent::m_sendImageDataOnTheWire(
@@ -308,9 +422,81 @@ namespace common {
         }
         m_getParent().packMessage(buf, imageRegion.getMessageType(), timestamp);
         m_getParent().sendPending();
+        auto &stats = m_getStats(sensor).wire;
+        stats.frames++;
+        stats.bytes += buf.size();
         return true;
     }
 
+    bool ImagingComponent::m_isWireRequested(OSVR_ChannelCount sensor) const {
+        if (m_wireRequested.size() <= sensor) {
+            return false;
+        }
+        return util::time::duration(util::time::getNow(),
+                                    m_wireRequested[sensor]) <
+               WIRE_REQUEST_LIFETIME;
+    }
+
+    void ImagingComponent::m_requestWire(OSVR_ChannelCount sensor) {
+        if (m_wireRequestSent.size() <= sensor) {
+            m_wireRequestSent.resize(sensor + 1, util::time::TimeValue{0, 0});
+        }
+        auto now = util::time::getNow();
+        if (util::time::duration(now, m_wireRequestSent[sensor]) <
+            WIRE_REQUEST_INTERVAL) {
+            return;
+        }
+        m_wireRequestSent[sensor] = now;
+        Buffer<> buf;
+        messages::ImageWireRequest::MessageSerialization msg(sensor);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, imageWireRequest.getMessageType(), now);
+        m_getParent().sendPending();
+    }
+
+    int VRPN_CALLBACK ImagingComponent::m_handleImageWireRequest(
+        void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageWireRequest::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto sensor = msg.getSensor();
+        if (sensor >= self->m_numSensor) {
+            OSVR_DEV_VERBOSE("Ignoring image wire request for sensor "
+                             << sensor << ": only have " << self->m_numSensor);
+            return 0;
+        }
+        /// Use our own clock, not the client's.
+        self->m_wireRequested[sensor] = util::time::getNow();
+        return 0;
+    }
+
+    ImagingSensorStats
+    ImagingComponent::getSensorStats(OSVR_ChannelCount sensor) const {
+        if (m_stats.size() <= sensor) {
+            return ImagingSensorStats{};
+        }
+        return m_stats[sensor];
+    }
+
+    std::vector<IPCRingBuffer::ReaderStats>
+    ImagingComponent::getSharedMemoryReaderStats(
+        OSVR_ChannelCount sensor) const {
+        if (m_shmBuf.size() <= sensor || !m_shmBuf[sensor]) {
+            return std::vector<IPCRingBuffer::ReaderStats>{};
+        }
+        return m_shmBuf[sensor]->getAllReaderStats();
+    }
+
+    ImagingSensorStats &
+    ImagingComponent::m_getStats(OSVR_ChannelCount sensor) {
+        if (m_stats.size() <= sensor) {
+            m_stats.resize(sensor + 1);
+        }
+        return m_stats[sensor];
+    }
+
     int VRPN_CALLBACK
     ImagingComponent::m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p) {
         auto self = static_cast<ImagingComponent *>(userdata);
@@ -366,6 +552,7 @@ namespace common {
         if (IPCRingBuffer::getABILevel() != msg.abiLevel) {
             /// Can't interoperate with this server over shared memory
             OSVR_DEV_VERBOSE("Can't handle SHM ABI level " << msg.abiLevel);
+            self->m_requestWire(msg.sensor);
             return 0;
         }
         self->m_growShmVecIfRequired(msg.sensor);
@@ -379,12 +566,17 @@ namespace common {
             !checkSameRingBuf(msg, self->m_shmBuf[msg.sensor])) {
             self->m_shmBuf[msg.sensor] = IPCRingBuffer::find(
                 IPCRingBuffer::Options(msg.shmName, msg.backend));
+            if (self->m_shmBuf[msg.sensor]) {
+                /// So the server can see if we fall behind: best-effort.
+                self->m_shmBuf[msg.sensor]->registerReader();
+            }
         }
         if (!self->m_shmBuf[msg.sensor]) {
             /// Can't find the shared memory referred to - possibly not a local
             /// client
             OSVR_DEV_VERBOSE("Can't find desired IPC ring buffer "
                              << msg.shmName);
+            self->m_requestWire(msg.sensor);
             return 0;
         }
 
@@ -425,6 +617,10 @@ namespace common {
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         m_getParent().registerMessageType(imagePlacedInProcessMemory);
 #endif
+        m_getParent().registerMessageType(imageWireRequest);
+        /// Only the server side will ever receive these.
+        m_registerHandler(&ImagingComponent::m_handleImageWireRequest, this,
+                          imageWireRequest.getMessageType());
     }
 
     void ImagingComponent::m_checkFirst(OSVR_ImagingMetadata const &metadata) {
@@ -0,0 +1,345 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SharedMemory.h"
+#include <osvr/Common/LocalReportChannel.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/assert.hpp>
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <new>
+#include <random>
+#include <sstream>
+#include <type_traits>
+
+namespace osvr {
+namespace common {
+    /// Grab a logger for LocalReportChannel verbosity and errors.
+    static util::log::Logger &getLocalReportChannelLogger() {
+        static util::log::LoggerPtr logger =
+            util::log::make_logger("LocalReportChannel");
+        return *logger;
+    }
+
+    /// @brief the ABI level: this must be bumped if the layout of the shared
+    /// memory (ChannelHeader, ChannelSlot, LocalTrackerReport) changes.
+    static const uint32_t LOCAL_REPORT_ABI_LEVEL = 2;
+
+    static_assert(std::is_pod<LocalTrackerReport>::value,
+                  "Local tracker reports are copied in and out of shared "
+                  "memory, so must be plain old data.");
+
+    namespace {
+        /// Lives at the start of the segment, followed by the slots.
+        struct ChannelHeader {
+            /// Stored last by the writer, so a reader that sees the right
+            /// value knows the rest is set up.
+            std::atomic<uint32_t> abiLevel;
+            uint32_t capacity;
+            /// Chosen at random when the channel is created, so a reader can
+            /// tell a channel re-created under the same name from its own.
+            uint64_t generation;
+            /// Number of reports published so far.
+            std::atomic<uint64_t> published;
+            /// Cleared by the writer when it closes the channel.
+            std::atomic<uint32_t> writerOpen;
+        };
+
+        struct ChannelSlot {
+            /// 2n + 1 while report n is being written into this slot, 2n + 2
+            /// once it's done.
+            std::atomic<uint64_t> seq;
+            LocalTrackerReport report;
+        };
+
+        inline std::size_t getSegmentSize(uint32_t capacity) {
+            return sizeof(ChannelHeader) + capacity * sizeof(ChannelSlot);
+        }
+
+        inline std::string getSegmentName(std::string const &ns,
+                                          std::string const &deviceName) {
+            return ipc::make_name_safe("osvr_local_" + ns + "_" + deviceName);
+        }
+
+        inline bool haveLockFreeAtomics() {
+            std::atomic<uint64_t> test(0);
+            return test.is_lock_free();
+        }
+
+        namespace bip = boost::interprocess;
+    } // namespace
+
+    class LocalReportChannel::Impl {
+      public:
+        Impl(std::string const &name, bip::shared_memory_object &&shm,
+             bool writer)
+            : m_name(name), m_shm(std::move(shm)),
+              m_region(m_shm, bip::read_write), m_writer(writer) {}
+
+        ~Impl() {
+            if (m_writer) {
+                if (m_header) {
+                    m_header->writerOpen.store(0, std::memory_order_release);
+                }
+                bip::shared_memory_object::remove(m_name.c_str());
+            }
+        }
+
+        /// Lays out a fresh channel in the segment.
+        void initialize(uint32_t capacity) {
+            auto header = new (m_region.get_address()) ChannelHeader;
+            header->capacity = capacity;
+            std::random_device rd;
+            header->generation = (uint64_t(rd()) << 32) | rd();
+            header->published.store(0);
+            header->writerOpen.store(1);
+            auto slots = reinterpret_cast<ChannelSlot *>(header + 1);
+            for (uint32_t i = 0; i < capacity; ++i) {
+                auto slot = new (&slots[i]) ChannelSlot;
+                slot->seq.store(0);
+            }
+            header->abiLevel.store(LOCAL_REPORT_ABI_LEVEL,
+                                   std::memory_order_release);
+            m_attach();
+        }
+
+        /// Checks that the segment holds a channel we can use, and if so
+        /// starts reading at the next report to be published.
+        bool attach() {
+            if (m_region.get_size() < sizeof(ChannelHeader)) {
+                return false;
+            }
+            auto header = static_cast<ChannelHeader *>(m_region.get_address());
+            if (header->abiLevel.load(std::memory_order_acquire) !=
+                LOCAL_REPORT_ABI_LEVEL) {
+                return false;
+            }
+            if (m_region.get_size() < getSegmentSize(header->capacity) ||
+                header->capacity == 0) {
+                return false;
+            }
+            m_attach();
+            m_next = m_header->published.load(std::memory_order_acquire);
+            return true;
+        }
+
+        void send(LocalTrackerReport const &report) {
+            BOOST_ASSERT_MSG(m_writer, "Only the channel's creator may send!");
+            auto n = m_next;
+            auto &slot = m_slots[n % m_capacity];
+            slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+            // Make sure readers can see the slot is being written before any
+            // of the new contents.
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&slot.report, &report, sizeof(report));
+            slot.seq.store(2 * n + 2, std::memory_order_release);
+            m_header->published.store(n + 1, std::memory_order_release);
+            ++m_next;
+        }
+
+        bool receive(LocalTrackerReport &report) {
+            while (true) {
+                auto published =
+                    m_header->published.load(std::memory_order_acquire);
+                if (m_next == published) {
+                    return false;
+                }
+                if (published - m_next > m_capacity) {
+                    // Lapped: skip to the oldest report still in the ring.
+                    m_missed += published - m_capacity - m_next;
+                    m_next = published - m_capacity;
+                }
+                auto &slot = m_slots[m_next % m_capacity];
+                auto expected = 2 * m_next + 2;
+                auto before = slot.seq.load(std::memory_order_acquire);
+                if (before == expected) {
+                    std::memcpy(&report, &slot.report, sizeof(report));
+                    // The copy must be done before checking nothing changed
+                    // under it.
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.seq.load(std::memory_order_relaxed) == expected) {
+                        ++m_next;
+                        return true;
+                    }
+                }
+                // Overwritten before or while we copied it.
+                ++m_missed;
+                ++m_next;
+            }
+        }
+
+        sequence_type getMissed() const { return m_missed; }
+        std::string const &getName() const { return m_name; }
+        bool isWriterOpen() const {
+            return m_header->writerOpen.load(std::memory_order_acquire) != 0;
+        }
+        uint64_t getGeneration() const { return m_header->generation; }
+
+      private:
+        void m_attach() {
+            m_header = static_cast<ChannelHeader *>(m_region.get_address());
+            m_capacity = m_header->capacity;
+            m_slots = reinterpret_cast<ChannelSlot *>(m_header + 1);
+        }
+        std::string m_name;
+        bip::shared_memory_object m_shm;
+        bip::mapped_region m_region;
+        bool m_writer;
+        ChannelHeader *m_header = nullptr;
+        ChannelSlot *m_slots = nullptr;
+        uint32_t m_capacity = 0;
+        /// For the writer, the number of the next report to send; for a
+        /// reader, the next one to receive.
+        sequence_type m_next = 0;
+        sequence_type m_missed = 0;
+    };
+
+    std::string LocalReportChannel::getServerNamespace(int port) {
+        if (port == 0) {
+            port = vrpn_DEFAULT_LISTEN_PORT_NO;
+        }
+        std::ostringstream os;
+        os << "server" << port;
+        return os.str();
+    }
+
+    std::string LocalReportChannel::makeUniqueNamespace() {
+        std::random_device rd;
+        std::ostringstream os;
+        os << "joint" << std::hex << rd() << rd();
+        return os.str();
+    }
+
+    std::string
+    LocalReportChannel::getNamespaceForServer(std::string const &server) {
+        auto host = server;
+        int port = 0;
+        auto colon = server.rfind(':');
+        if (colon != std::string::npos && colon + 1 < server.size() &&
+            std::all_of(server.begin() + colon + 1, server.end(),
+                        [](char c) { return std::isdigit(c) != 0; })) {
+            host = server.substr(0, colon);
+            port = std::stoi(server.substr(colon + 1));
+        }
+        if (host == "localhost" || host == "127.0.0.1" || host == "::1" ||
+            host == "[::1]") {
+            return getServerNamespace(port);
+        }
+        return std::string{};
+    }
+
+    LocalReportChannelPtr
+    LocalReportChannel::create(std::string const &ns,
+                               std::string const &deviceName,
+                               uint32_t capacity) {
+        LocalReportChannelPtr ret;
+        if (!haveLockFreeAtomics() || capacity == 0) {
+            return ret;
+        }
+        auto name = getSegmentName(ns, deviceName);
+        try {
+            bip::shared_memory_object::remove(name.c_str());
+            bip::shared_memory_object shm(bip::create_only, name.c_str(),
+                                          bip::read_write);
+            shm.truncate(getSegmentSize(capacity));
+            unique_ptr<Impl> impl(new Impl(name, std::move(shm), true));
+            impl->initialize(capacity);
+            ret.reset(new LocalReportChannel(std::move(impl)));
+        } catch (bip::interprocess_exception &e) {
+            getLocalReportChannelLogger().error()
+                << "Could not create local report channel " << name << ": "
+                << e.what();
+            bip::shared_memory_object::remove(name.c_str());
+        }
+        return ret;
+    }
+
+    LocalReportChannelPtr
+    LocalReportChannel::open(std::string const &ns,
+                             std::string const &deviceName) {
+        LocalReportChannelPtr ret;
+        if (!haveLockFreeAtomics()) {
+            return ret;
+        }
+        auto name = getSegmentName(ns, deviceName);
+        try {
+            bip::shared_memory_object shm(bip::open_only, name.c_str(),
+                                          bip::read_write);
+            unique_ptr<Impl> impl(new Impl(name, std::move(shm), false));
+            if (!impl->attach()) {
+                getLocalReportChannelLogger().debug()
+                    << "Local report channel " << name
+                    << " found but not usable";
+                return ret;
+            }
+            ret.reset(new LocalReportChannel(std::move(impl)));
+        } catch (bip::interprocess_exception &) {
+            // No such channel: not an error, the device just isn't local or
+            // doesn't publish this way.
+        }
+        return ret;
+    }
+
+    void LocalReportChannel::send(LocalTrackerReport const &report) {
+        m_impl->send(report);
+    }
+
+    bool LocalReportChannel::receive(LocalTrackerReport &report) {
+        return m_impl->receive(report);
+    }
+
+    LocalReportChannel::sequence_type LocalReportChannel::getMissed() const {
+        return m_impl->getMissed();
+    }
+
+    std::string const &LocalReportChannel::getName() const {
+        return m_impl->getName();
+    }
+
+    bool LocalReportChannel::isWriterOpen() const {
+        return m_impl->isWriterOpen();
+    }
+
+    uint64_t LocalReportChannel::getGeneration() const {
+        return m_impl->getGeneration();
+    }
+
+    LocalReportChannel::LocalReportChannel(unique_ptr<Impl> &&impl)
+        : m_impl(std::move(impl)) {}
+
+    LocalReportChannel::~LocalReportChannel() {}
+
+} // namespace common
+} // namespace osvr
@@ -45,12 +45,18 @@ namespace osvr {
 namespace common {
     PathTree::PathTree() : m_root(PathNode::createRoot()) {}
     PathNode &PathTree::getNodeByPath(std::string const &path) {
-        return pathParseAndRetrieve(*m_root, path);
+        auto cached = m_getCached(path);
+        if (cached) {
+            return *cached;
+        }
+        auto &ret = pathParseAndRetrieve(*m_root, path);
+        m_pathCache.emplace(path, &ret);
+        return ret;
     }
     PathNode &
     PathTree::getNodeByPath(std::string const &path,
                             PathElement const &finalComponentDefault) {
-        auto &ret = pathParseAndRetrieve(*m_root, path);
+        auto &ret = getNodeByPath(path);
 
         // Handle null elements as final component.
         elements::ifNullReplaceWith(ret.value(), finalComponentDefault);
@@ -58,11 +64,28 @@ namespace common {
     }
 
     PathNode const &PathTree::getNodeByPath(std::string const &path) const {
+        /// Only reads the cache: const lookups may not modify the tree, and
+        /// so shouldn't modify the cache either.
+        auto cached = m_getCached(path);
+        if (cached) {
+            return *cached;
+        }
         return pathParseAndRetrieve(const_cast<PathNode const &>(*m_root),
                                     path);
     }
 
-    void PathTree::reset() { m_root = PathNode::createRoot(); }
+    void PathTree::reset() {
+        m_pathCache.clear();
+        m_root = PathNode::createRoot();
+    }
+
+    PathNode *PathTree::m_getCached(std::string const &path) const {
+        auto it = m_pathCache.find(path);
+        if (it == m_pathCache.end()) {
+            return nullptr;
+        }
+        return it->second;
+    }
 
     /// @brief Determine if the node needs updating given that we want to add an
     /// alias there pointing to source with the given automatic status.
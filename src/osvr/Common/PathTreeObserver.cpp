@@ -50,5 +50,22 @@ namespace common {
         m_handlers[e] = callback;
     }
 
+    void PathTreeObserver::notifyPartialEvent(
+        PathTreeEvents e, PathTreeObserver::callback_argument arg,
+        PathTreeObserver::paths_argument paths) const {
+        auto it = m_partialHandlers.find(e);
+        if (end(m_partialHandlers) != it && (*it).second) {
+            (*it).second(arg, paths);
+            return;
+        }
+        notifyEvent(e, arg);
+    }
+
+    void PathTreeObserver::setPartialEventCallback(
+        PathTreeEvents e,
+        PathTreeObserver::partial_callback_type const &callback) {
+        m_partialHandlers[e] = callback;
+    }
+
 } // namespace common
 } // namespace osvr
@@ -72,6 +72,12 @@ namespace common {
     }
 
     void PathTreeOwner::replaceTree(Json::Value const &nodes) {
+        /// The version of this tree is given by the marker that follows it.
+        m_haveVersion = false;
+        if (m_valid) {
+            m_applyDelta(pathTreeDelta(pathTreeToJson(m_tree), nodes));
+            return;
+        }
         for_each_cleanup_pointers(
             m_observers, [&](PathTreeObserver const &observer) {
                 observer.notifyEvent(PathTreeEvents::AboutToUpdate, m_tree);
@@ -88,5 +94,45 @@ namespace common {
                 observer.notifyEvent(PathTreeEvents::AfterUpdate, m_tree);
             });
     }
+
+    bool PathTreeOwner::applyTreeDelta(Json::Value const &delta) {
+        if (!m_valid) {
+            return false;
+        }
+        auto base = delta[tree_delta_keys::baseVersion()].asUInt();
+        auto version = delta[tree_delta_keys::version()].asUInt();
+        if (base == version) {
+            /// Version marker following a full tree.
+            m_version = version;
+            m_haveVersion = true;
+            return true;
+        }
+        if (!m_haveVersion || base != m_version) {
+            return false;
+        }
+        m_applyDelta(delta);
+        m_version = version;
+        return true;
+    }
+
+    void PathTreeOwner::m_applyDelta(Json::Value const &delta) {
+        if (isPathTreeDeltaEmpty(delta)) {
+            return;
+        }
+        auto paths = getPathTreeDeltaPaths(delta);
+        for_each_cleanup_pointers(
+            m_observers, [&](PathTreeObserver const &observer) {
+                observer.notifyPartialEvent(PathTreeEvents::AboutToUpdate,
+                                            m_tree, paths);
+            });
+
+        applyPathTreeDelta(m_tree, delta);
+
+        for_each_cleanup_pointers(
+            m_observers, [&](PathTreeObserver const &observer) {
+                observer.notifyPartialEvent(PathTreeEvents::AfterUpdate,
+                                            m_tree, paths);
+            });
+    }
 } // namespace common
 } // namespace osvr
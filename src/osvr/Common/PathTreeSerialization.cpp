@@ -29,13 +29,23 @@
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathNode.h>
 #include <osvr/Common/ApplyPathNodeVisitor.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/JSONSerializationTags.h>
+#include <osvr/Common/RoutingConstants.h>
+#include <osvr/Common/SerializationTraits.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 #include <json/value.h>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/for_each.hpp>
+#include <boost/noncopyable.hpp>
 
 // Standard includes
-// - none
+#include <unordered_map>
+#include <stdexcept>
 
 namespace osvr {
 namespace common {
@@ -101,5 +111,310 @@ namespace common {
             tree.getNodeByPath(node["path"].asString()).value() = elt;
         }
     }
+
+    namespace {
+        typedef uint32_t BinaryNodeIndex;
+        typedef uint8_t BinaryElementType;
+        static const uint8_t BINARY_FORMAT_VERSION = 1;
+
+        /// @brief Functor for use with a serializationDescription overload, for
+        /// the direction PathElement->binary
+        template <typename BufferType>
+        class PathElementToBinaryFunctor : boost::noncopyable {
+          public:
+            PathElementToBinaryFunctor(BufferType &buf) : m_buf(buf) {}
+
+            template <typename T>
+            void operator()(const char[], T const &data) {
+                serialization::serializeRaw(m_buf, data);
+            }
+
+            void operator()(const char[], Json::Value const &data) {
+                serialization::serializeRaw(m_buf, data,
+                                            serialization::JsonBinaryTag());
+            }
+
+          private:
+            BufferType &m_buf;
+        };
+
+        /// @brief Functor for use with a serializationDescription overload, for
+        /// the direction binary->PathElement
+        template <typename BufferReaderType>
+        class PathElementFromBinaryFunctor : boost::noncopyable {
+          public:
+            PathElementFromBinaryFunctor(BufferReaderType &reader)
+                : m_reader(reader) {}
+
+            template <typename T> void operator()(const char[], T &data) {
+                serialization::deserializeRaw(m_reader, data);
+            }
+
+            void operator()(const char[], Json::Value &data) {
+                serialization::deserializeRaw(m_reader, data,
+                                              serialization::JsonBinaryTag());
+            }
+
+          private:
+            BufferReaderType &m_reader;
+        };
+
+        /// @brief A PathElement visitor writing the element type and data.
+        template <typename BufferType>
+        class PathElementToBinaryVisitor : public boost::static_visitor<> {
+          public:
+            PathElementToBinaryVisitor(BufferType &buf) : m_buf(buf) {}
+
+            /// @brief Don't try to generate an assignment operator.
+            PathElementToBinaryVisitor &
+            operator=(const PathElementToBinaryVisitor &) = delete;
+
+            template <typename T> void operator()(T const &elt) {
+                PathElementToBinaryFunctor<BufferType> functor(m_buf);
+                serializationDescription(functor, elt);
+            }
+
+          private:
+            BufferType &m_buf;
+        };
+
+        /// @brief A PathNode (tree) visitor to recursively write nodes in a
+        /// PathTree in binary form: nodes are numbered in the order visited,
+        /// starting with the root as 0, so each can refer to its parent. The
+        /// root itself isn't written.
+        template <typename BufferType> class PathTreeToBinaryVisitor {
+          public:
+            PathTreeToBinaryVisitor(BufferType &buf) : m_buf(buf) {}
+
+            /// @brief Don't try to generate an assignment operator.
+            PathTreeToBinaryVisitor &
+            operator=(const PathTreeToBinaryVisitor &) = delete;
+
+            void operator()(PathNode const &node) {
+                auto index = m_count;
+                m_count++;
+                if (!node.isRoot()) {
+                    serialization::serializeRaw(m_buf, m_parents.back());
+                    serialization::serializeRaw(m_buf, node.getName());
+                    serialization::serializeRaw(
+                        m_buf,
+                        static_cast<BinaryElementType>(node.value().which()));
+                    PathElementToBinaryVisitor<BufferType> visitor(m_buf);
+                    boost::apply_visitor(visitor, node.value());
+                }
+                m_parents.push_back(index);
+                node.visitConstChildren(*this);
+                m_parents.pop_back();
+            }
+
+          private:
+            BufferType &m_buf;
+            BinaryNodeIndex m_count = 0;
+            std::vector<BinaryNodeIndex> m_parents;
+        };
+
+        /// @brief Functor for use with the PathElement's type list and
+        /// mpl::for_each, to convert from type index to actual type and load
+        /// the data. Sets the referenced flag if the type was found.
+        template <typename BufferReaderType>
+        class DeserializeBinaryElementFunctor {
+          public:
+            DeserializeBinaryElementFunctor(BufferReaderType &reader,
+                                            BinaryElementType type,
+                                            elements::PathElement &elt,
+                                            bool &found)
+                : m_reader(reader), m_type(type), m_elt(elt), m_found(found) {}
+
+            /// @brief Don't try to generate an assignment operator.
+            DeserializeBinaryElementFunctor &
+            operator=(const DeserializeBinaryElementFunctor &) = delete;
+
+            template <typename T> void operator()(T const &) {
+                typedef elements::PathElement::types types;
+                typedef typename boost::mpl::distance<
+                    typename boost::mpl::begin<types>::type,
+                    typename boost::mpl::find<types, T>::type>::type index;
+                if (index::value == m_type) {
+                    T value;
+                    PathElementFromBinaryFunctor<BufferReaderType> functor(
+                        m_reader);
+                    serializationDescription(functor, value);
+                    m_elt = value;
+                    m_found = true;
+                }
+            }
+
+          private:
+            BufferReaderType &m_reader;
+            BinaryElementType m_type;
+            elements::PathElement &m_elt;
+            bool &m_found;
+        };
+
+        /// @brief Reads the binary form of a path tree, calling
+        /// `f(parentIndex, name, element)` for each non-root node in order.
+        template <typename F>
+        inline void readBinaryPathTree(const char *data, std::size_t len,
+                                       F &&f) {
+            auto reader = readExternalBuffer(data, len);
+            uint8_t version;
+            serialization::deserializeRaw(reader, version);
+            if (version != BINARY_FORMAT_VERSION) {
+                throw std::runtime_error(
+                    "Unsupported binary path tree format version!");
+            }
+            std::string name;
+            for (BinaryNodeIndex i = 1; reader.bytesRemaining() > 0; ++i) {
+                BinaryNodeIndex parent;
+                serialization::deserializeRaw(reader, parent);
+                if (parent >= i) {
+                    throw std::runtime_error(
+                        "Invalid parent index in binary path tree!");
+                }
+                serialization::deserializeRaw(reader, name);
+                BinaryElementType type;
+                serialization::deserializeRaw(reader, type);
+                elements::PathElement elt;
+                bool found = false;
+                DeserializeBinaryElementFunctor<decltype(reader)> functor{
+                    reader, type, elt, found};
+                boost::mpl::for_each<elements::PathElement::types>(functor);
+                if (!found) {
+                    throw std::runtime_error(
+                        "Unknown element type in binary path tree!");
+                }
+                f(parent, name, elt);
+            }
+        }
+
+        /// @brief A PathElement visitor producing the same JSON object as
+        /// PathNodeToJsonVisitor, given the full path.
+        class PathElementToJsonVisitor
+            : public boost::static_visitor<Json::Value> {
+          public:
+            PathElementToJsonVisitor(std::string const &path)
+                : boost::static_visitor<Json::Value>(), m_path(path) {}
+
+            /// @brief Don't try to generate an assignment operator.
+            PathElementToJsonVisitor &
+            operator=(const PathElementToJsonVisitor &) = delete;
+
+            template <typename T> Json::Value operator()(T const &elt) {
+                auto ret = pathElementToJson(elt);
+                ret["path"] = m_path;
+                ret["type"] = elements::getTypeName<T>();
+                return ret;
+            }
+
+          private:
+            std::string const &m_path;
+        };
+    } // namespace
+
+    std::uint8_t getPathTreeBinaryFormatVersion() {
+        return BINARY_FORMAT_VERSION;
+    }
+
+    std::string pathTreeToBinary(PathTree const &tree) {
+        Buffer<> buf;
+        serialization::serializeRaw(buf, BINARY_FORMAT_VERSION);
+        PathTreeToBinaryVisitor<Buffer<>> visitor{buf};
+        tree.visitConstTree(visitor);
+        return std::string(buf.data(), buf.size());
+    }
+
+    void binaryToPathTree(PathTree &tree, const char *data, std::size_t len) {
+        std::vector<PathNode *> nodes{&tree.getRoot()};
+        readBinaryPathTree(data, len,
+                           [&](BinaryNodeIndex parent, std::string const &name,
+                               elements::PathElement const &elt) {
+                               auto &node =
+                                   nodes[parent]->getOrCreateChildByName(name);
+                               node.value() = elt;
+                               nodes.push_back(&node);
+                           });
+    }
+
+    Json::Value binaryToPathTreeJson(const char *data, std::size_t len) {
+        Json::Value ret(Json::arrayValue);
+        std::vector<std::string> paths{std::string{}};
+        readBinaryPathTree(
+            data, len, [&](BinaryNodeIndex parent, std::string const &name,
+                           elements::PathElement const &elt) {
+                paths.push_back(paths[parent] + getPathSeparator() + name);
+                if (!elements::isNull(elt)) {
+                    PathElementToJsonVisitor visitor{paths.back()};
+                    ret.append(boost::apply_visitor(visitor, elt));
+                }
+            });
+        return ret;
+    }
+
+    namespace tree_delta_keys {
+        const char *nodes() { return "nodes"; }
+
+        const char *removed() { return "removed"; }
+
+        const char *baseVersion() { return "base"; }
+
+        const char *version() { return "version"; }
+    } // namespace tree_delta_keys
+
+    Json::Value pathTreeDelta(Json::Value const &oldNodes,
+                              Json::Value const &newNodes) {
+        std::unordered_map<std::string, Json::Value const *> remaining;
+        for (auto const &node : oldNodes) {
+            remaining[node["path"].asString()] = &node;
+        }
+        Json::Value ret(Json::objectValue);
+        auto &changed = ret[tree_delta_keys::nodes()] =
+            Json::Value(Json::arrayValue);
+        auto &removed = ret[tree_delta_keys::removed()] =
+            Json::Value(Json::arrayValue);
+        for (auto const &node : newNodes) {
+            auto it = remaining.find(node["path"].asString());
+            if (it == end(remaining)) {
+                changed.append(node);
+                continue;
+            }
+            if (!(*(it->second) == node)) {
+                changed.append(node);
+            }
+            remaining.erase(it);
+        }
+        /// Walk the old nodes again, rather than the map, to keep the output
+        /// in a stable order.
+        for (auto const &node : oldNodes) {
+            auto path = node["path"].asString();
+            if (remaining.find(path) != end(remaining)) {
+                removed.append(path);
+            }
+        }
+        return ret;
+    }
+
+    bool isPathTreeDeltaEmpty(Json::Value const &delta) {
+        return delta[tree_delta_keys::nodes()].empty() &&
+               delta[tree_delta_keys::removed()].empty();
+    }
+
+    std::vector<std::string> getPathTreeDeltaPaths(Json::Value const &delta) {
+        std::vector<std::string> ret;
+        for (auto const &path : delta[tree_delta_keys::removed()]) {
+            ret.push_back(path.asString());
+        }
+        for (auto const &node : delta[tree_delta_keys::nodes()]) {
+            ret.push_back(node["path"].asString());
+        }
+        return ret;
+    }
+
+    void applyPathTreeDelta(PathTree &tree, Json::Value const &delta) {
+        for (auto const &path : delta[tree_delta_keys::removed()]) {
+            tree.getNodeByPath(path.asString()).value() =
+                elements::NullElement();
+        }
+        jsonToPathTree(tree, delta[tree_delta_keys::nodes()]);
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
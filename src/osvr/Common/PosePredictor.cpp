@@ -0,0 +1,158 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PosePredictor.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/EigenQuatExponentialMap.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    namespace ei = util::eigen_interop;
+
+    /// @brief Seconds past the last pose beyond which predictions don't
+    /// extrapolate further.
+    static const double MAX_PREDICTION = 0.25;
+
+    /// @brief Poses further apart than this, in seconds, are too stale to
+    /// estimate a velocity from, and velocity reports older than this
+    /// compared to the last pose are no longer used.
+    static const double MAX_ESTIMATE_INTERVAL = 0.1;
+
+    /// @brief Log map of a rotation, taking the short way around.
+    static inline Eigen::Vector3d rotationLog(Eigen::Quaterniond q) {
+        if (q.w() < 0) {
+            q.coeffs() *= -1;
+        }
+        return util::quat_exp_map(q).ln();
+    }
+
+    static inline void setZero(OSVR_Vec3 &v) {
+        ei::map(v) = Eigen::Vector3d::Zero();
+    }
+
+    PosePredictor::PosePredictor()
+        : m_hasPose(false), m_poseTime(), m_reportedLinear(),
+          m_reportedAngular() {
+        osvrPose3SetIdentity(&m_pose);
+        setZero(m_estimatedLinear);
+        setZero(m_estimatedAngular);
+    }
+
+    void PosePredictor::update(OSVR_TimeValue const &timestamp,
+                               OSVR_PoseReport const &report) {
+        if (m_hasPose) {
+            auto dt = osvrTimeValueDurationSeconds(&timestamp, &m_poseTime);
+            if (dt < 0) {
+                /// The clock stepped back (a clock adjustment, a restarted
+                /// server): still the latest pose, as far as the interface
+                /// state is concerned, but velocities from before the step
+                /// can't be placed relative to it.
+                setZero(m_estimatedLinear);
+                setZero(m_estimatedAngular);
+                m_reportedLinear.valid = false;
+                m_reportedAngular.valid = false;
+            } else if (dt > MAX_ESTIMATE_INTERVAL) {
+                setZero(m_estimatedLinear);
+                setZero(m_estimatedAngular);
+            } else if (dt > 0) {
+                ei::map(m_estimatedLinear) =
+                    (ei::map(report.pose.translation) -
+                     ei::map(m_pose.translation)) /
+                    dt;
+                Eigen::Quaterniond inc =
+                    ei::map(report.pose.rotation).quat() *
+                    ei::map(m_pose.rotation).quat().conjugate();
+                ei::map(m_estimatedAngular) = rotationLog(inc) / dt;
+            }
+            /// A repeated timestamp has no velocity to estimate from, but
+            /// it's still the latest pose.
+        }
+        m_hasPose = true;
+        m_poseTime = timestamp;
+        m_pose = report.pose;
+    }
+
+    void PosePredictor::update(OSVR_TimeValue const &timestamp,
+                               OSVR_VelocityReport const &report) {
+        auto const &state = report.state;
+        if (state.linearVelocityValid) {
+            m_reportedLinear.valid = true;
+            m_reportedLinear.timestamp = timestamp;
+            m_reportedLinear.value = state.linearVelocity;
+        }
+        auto const &angular = state.angularVelocity;
+        if (state.angularVelocityValid && angular.dt > 0) {
+            m_reportedAngular.valid = true;
+            m_reportedAngular.timestamp = timestamp;
+            ei::map(m_reportedAngular.value) =
+                rotationLog(ei::map(angular.incrementalRotation)) / angular.dt;
+        }
+    }
+
+    OSVR_Vec3 const &
+    PosePredictor::m_choose(ReportedVelocity const &reported,
+                            OSVR_Vec3 const &estimated) const {
+        /// A device that stops sending velocity falls back to the estimate,
+        /// rather than extrapolating its last velocity forever.
+        if (reported.valid &&
+            osvrTimeValueDurationSeconds(&m_poseTime, &reported.timestamp) <=
+                MAX_ESTIMATE_INTERVAL) {
+            return reported.value;
+        }
+        return estimated;
+    }
+
+    bool PosePredictor::predict(OSVR_TimeValue const &target,
+                                OSVR_PoseState &pose) const {
+        if (!m_hasPose) {
+            return false;
+        }
+        /// Never extrapolate backwards: a target before the last pose gets
+        /// the last pose.
+        auto dt = std::max(
+            0., std::min(osvrTimeValueDurationSeconds(&target, &m_poseTime),
+                         MAX_PREDICTION));
+        auto const &linear = m_choose(m_reportedLinear, m_estimatedLinear);
+        auto const &angular = m_choose(m_reportedAngular, m_estimatedAngular);
+        ei::map(pose.translation) =
+            ei::map(m_pose.translation) + ei::map(linear) * dt;
+        Eigen::Vector3d rotation = ei::map(angular) * dt;
+        ei::map(pose.rotation) =
+            (util::quat_exp_map(rotation).exp() *
+             ei::map(m_pose.rotation).quat())
+                .normalized();
+        return true;
+    }
+
+} // namespace common
+} // namespace osvr
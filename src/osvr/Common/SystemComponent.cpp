@@ -35,7 +35,7 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <exception>
 
 namespace osvr {
 namespace common {
@@ -93,6 +93,55 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        class TreeDeltaFromServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *TreeDeltaFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaFromServer";
+        }
+
+        class BinaryTreeFormatRequestToServer::MessageSerialization {
+          public:
+            MessageSerialization(uint8_t version = 0) : m_version(version) {}
+
+            template <typename T> void processMessage(T &p) { p(m_version); }
+
+            uint8_t getVersion() const { return m_version; }
+
+          private:
+            uint8_t m_version;
+        };
+        const char *BinaryTreeFormatRequestToServer::identifier() {
+            return "com.osvr.system.BinaryTreeFormatRequest";
+        }
+
+        class BinaryTreeFromServer::MessageSerialization {
+          public:
+            MessageSerialization(std::string const &data = std::string())
+                : m_data(data) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_data, serialization::StringOnlyMessageTag());
+            }
+
+          private:
+            std::string m_data;
+        };
+        const char *BinaryTreeFromServer::identifier() {
+            return "com.osvr.system.BinaryTreeFromServer";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -131,15 +180,91 @@ namespace common {
     }
 
     void SystemComponent::sendReplacementTree(PathTree &tree) {
+        if (m_sendBinaryTree) {
+            /// Goes first, so that clients handling it can skip the JSON.
+            Buffer<> binBuf;
+            messages::BinaryTreeFromServer::MessageSerialization binMsg(
+                pathTreeToBinary(tree));
+            serialize(binBuf, binMsg);
+            m_getParent().packMessage(binBuf, binaryTreeOut.getMessageType());
+        }
         auto config = pathTreeToJson(tree);
         Buffer<> buf;
         messages::ReplacementTreeFromServer::MessageSerialization msg(config);
         serialize(buf, msg);
         m_getParent().packMessage(buf, treeOut.getMessageType());
 
+        /// Empty delta from the current version to itself marks the version
+        /// of the tree just sent.
+        if (m_haveSentTree) {
+            ++m_treeVersion;
+        }
+        m_sentTree = config;
+        m_haveSentTree = true;
+        Json::Value marker(Json::objectValue);
+        m_sendTreeDelta(marker, m_treeVersion);
+
+        m_getParent().sendPending(); // forcing this since it will cause
+                                     // shuffling of remotes on the client.
+    }
+
+    void SystemComponent::sendTreeUpdate(PathTree &tree) {
+        if (!m_haveSentTree) {
+            sendReplacementTree(tree);
+            return;
+        }
+        auto config = pathTreeToJson(tree);
+        auto delta = pathTreeDelta(m_sentTree, config);
+        if (isPathTreeDeltaEmpty(delta)) {
+            return;
+        }
+        auto base = m_treeVersion;
+        ++m_treeVersion;
+        m_sentTree = config;
+        m_sendTreeDelta(delta, base);
         m_getParent().sendPending(); // forcing this since it will cause
                                      // shuffling of remotes on the client.
     }
+
+    void SystemComponent::m_sendTreeDelta(Json::Value &delta,
+                                          Json::UInt base) {
+        delta[tree_delta_keys::baseVersion()] = base;
+        delta[tree_delta_keys::version()] = m_treeVersion;
+        Buffer<> buf;
+        messages::TreeDeltaFromServer::MessageSerialization msg(delta);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaOut.getMessageType());
+    }
+
+    void SystemComponent::registerTreeDeltaHandler(JsonHandler cb) {
+        if (m_treeDeltaHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDelta, this,
+                              treeDeltaOut.getMessageType());
+        }
+        m_treeDeltaHandlers.push_back(cb);
+    }
+    void SystemComponent::requestBinaryTree() {
+        if (!m_requestedBinaryTree) {
+            m_registerHandler(&SystemComponent::m_handleBinaryTree, this,
+                              binaryTreeOut.getMessageType());
+            m_requestedBinaryTree = true;
+        }
+        Buffer<> buf;
+        messages::BinaryTreeFormatRequestToServer::MessageSerialization msg(
+            getPathTreeBinaryFormatVersion());
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, binaryTreeRequestIn.getMessageType());
+    }
+
+    void SystemComponent::registerBinaryTreeRequestHandler(
+        BinaryTreeRequestHandler cb) {
+        if (m_binaryTreeRequestHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleBinaryTreeRequest,
+                              this, binaryTreeRequestIn.getMessageType());
+        }
+        m_binaryTreeRequestHandlers.push_back(cb);
+    }
+
     void SystemComponent::registerReplaceTreeHandler(JsonHandler cb) {
         if (m_replaceTreeHandlers.empty()) {
             m_registerHandler(&SystemComponent::m_handleReplaceTree, this,
@@ -153,11 +278,19 @@ namespace common {
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeDeltaOut);
+        m_getParent().registerMessageType(binaryTreeRequestIn);
+        m_getParent().registerMessageType(binaryTreeOut);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
                                              vrpn_HANDLERPARAM p) {
         auto self = static_cast<SystemComponent *>(userdata);
+        if (self->m_skipNextJsonTree) {
+            /// Already handled this tree in binary form.
+            self->m_skipNextJsonTree = false;
+            return 0;
+        }
         auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
         messages::ReplacementTreeFromServer::MessageSerialization msg;
         deserialize(bufReader, msg);
@@ -169,5 +302,55 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeDelta(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        BOOST_ASSERT_MSG(msg.getValue().isObject(),
+                         "tree delta message must be an object!");
+        for (auto const &cb : self->m_treeDeltaHandlers) {
+            cb(msg.getValue(), timestamp);
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleBinaryTree(void *userdata,
+                                            vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        Json::Value nodes;
+        try {
+            nodes = binaryToPathTreeJson(p.buffer, p.payload_len);
+        } catch (std::exception &) {
+            /// Leave it to the JSON copy that follows.
+            return 0;
+        }
+        self->m_skipNextJsonTree = true;
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        for (auto const &cb : self->m_replaceTreeHandlers) {
+            cb(nodes, timestamp);
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleBinaryTreeRequest(void *userdata,
+                                                   vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::BinaryTreeFormatRequestToServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        if (msg.getVersion() != getPathTreeBinaryFormatVersion()) {
+            /// Client will just have to use the JSON.
+            return 0;
+        }
+        self->m_sendBinaryTree = true;
+        for (auto const &cb : self->m_binaryTreeRequestHandlers) {
+            cb();
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
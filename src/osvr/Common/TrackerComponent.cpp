@@ -0,0 +1,327 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerComponent.h>
+#include <osvr/Common/TrackerComponentSerialization.h>
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+
+    namespace messages {
+        const char *TrackerPoseRecord::identifier() {
+            return "com.osvr.tracker.poserecord";
+        }
+        const char *TrackerVelocityRecord::identifier() {
+            return "com.osvr.tracker.velocityrecord";
+        }
+        const char *TrackerAccelerationRecord::identifier() {
+            return "com.osvr.tracker.accelerationrecord";
+        }
+        const char *TrackerPoseBatchRecord::identifier() {
+            return "com.osvr.tracker.posebatchrecord";
+        }
+    } // namespace messages
+
+    shared_ptr<TrackerComponent>
+    TrackerComponent::create(TrackerPrecision precision) {
+        shared_ptr<TrackerComponent> ret(new TrackerComponent(precision));
+        return ret;
+    }
+
+    TrackerComponent::TrackerComponent(TrackerPrecision precision)
+        : m_precision(precision) {}
+
+    void TrackerComponent::setPrecision(TrackerPrecision precision) {
+        m_precision = precision;
+    }
+
+    void TrackerComponent::sendReport(OSVR_PositionState const &val,
+                                      OSVR_ChannelCount sensor,
+                                      OSVR_TimeValue const &timestamp) {
+        auto &pose = m_getPose(sensor);
+        pose.translation = val;
+        m_sendPose(sensor, pose, timestamp);
+    }
+
+    void TrackerComponent::sendReport(OSVR_OrientationState const &val,
+                                      OSVR_ChannelCount sensor,
+                                      OSVR_TimeValue const &timestamp) {
+        auto &pose = m_getPose(sensor);
+        pose.rotation = val;
+        m_sendPose(sensor, pose, timestamp);
+    }
+
+    void TrackerComponent::sendReport(OSVR_PoseState const &val,
+                                      OSVR_ChannelCount sensor,
+                                      OSVR_TimeValue const &timestamp) {
+        auto &pose = m_getPose(sensor);
+        pose = val;
+        m_sendPose(sensor, pose, timestamp);
+    }
+
+    void TrackerComponent::sendVelReport(OSVR_VelocityState const &val,
+                                         OSVR_ChannelCount sensor,
+                                         OSVR_TimeValue const &timestamp) {
+        m_sendVelocity(sensor, val, timestamp);
+    }
+
+    void TrackerComponent::sendVelReport(OSVR_LinearVelocityState const &val,
+                                         OSVR_ChannelCount sensor,
+                                         OSVR_TimeValue const &timestamp) {
+        OSVR_VelocityState state = {};
+        state.linearVelocity = val;
+        state.linearVelocityValid = OSVR_TRUE;
+        m_sendVelocity(sensor, state, timestamp);
+    }
+
+    void
+    TrackerComponent::sendVelReport(OSVR_AngularVelocityState const &val,
+                                    OSVR_ChannelCount sensor,
+                                    OSVR_TimeValue const &timestamp) {
+        OSVR_VelocityState state = {};
+        state.angularVelocity = val;
+        state.angularVelocityValid = OSVR_TRUE;
+        m_sendVelocity(sensor, state, timestamp);
+    }
+
+    void TrackerComponent::sendAccelReport(OSVR_AccelerationState const &val,
+                                           OSVR_ChannelCount sensor,
+                                           OSVR_TimeValue const &timestamp) {
+        m_sendAcceleration(sensor, val, timestamp);
+    }
+
+    void TrackerComponent::sendAccelReport(
+        OSVR_LinearAccelerationState const &val, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
+        OSVR_AccelerationState state = {};
+        state.linearAcceleration = val;
+        state.linearAccelerationValid = OSVR_TRUE;
+        m_sendAcceleration(sensor, state, timestamp);
+    }
+
+    void TrackerComponent::sendAccelReport(
+        OSVR_AngularAccelerationState const &val, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
+        OSVR_AccelerationState state = {};
+        state.angularAcceleration = val;
+        state.angularAccelerationValid = OSVR_TRUE;
+        m_sendAcceleration(sensor, state, timestamp);
+    }
+
+    void
+    TrackerComponent::sendPoseBatch(std::vector<OSVR_PoseReport> const &reports,
+                                    OSVR_TimeValue const &timestamp) {
+        for (auto const &report : reports) {
+            m_getPose(report.sensor) = report.pose;
+        }
+
+        m_buf.getContents().clear();
+        messages::TrackerPoseBatchRecord::MessageSerialization msg(reports,
+                                                                   m_precision);
+        serialize(m_buf, msg);
+
+        m_getParent().packMessage(m_buf, poseBatchRecord.getMessageType(),
+                                  timestamp);
+    }
+
+    void TrackerComponent::registerPoseHandler(PoseHandler handler) {
+        if (m_poseCb.empty()) {
+            m_registerHandler(&TrackerComponent::m_handlePoseRecord, this,
+                              poseRecord.getMessageType());
+        }
+        m_poseCb.push_back(handler);
+    }
+
+    void TrackerComponent::registerVelocityHandler(VelocityHandler handler) {
+        if (m_velocityCb.empty()) {
+            m_registerHandler(&TrackerComponent::m_handleVelocityRecord, this,
+                              velocityRecord.getMessageType());
+        }
+        m_velocityCb.push_back(handler);
+    }
+
+    void TrackerComponent::registerAccelerationHandler(
+        AccelerationHandler handler) {
+        if (m_accelerationCb.empty()) {
+            m_registerHandler(&TrackerComponent::m_handleAccelerationRecord,
+                              this, accelerationRecord.getMessageType());
+        }
+        m_accelerationCb.push_back(handler);
+    }
+
+    void TrackerComponent::registerPoseBatchHandler(PoseBatchHandler handler) {
+        if (m_poseBatchCb.empty()) {
+            m_registerHandler(&TrackerComponent::m_handlePoseBatchRecord, this,
+                              poseBatchRecord.getMessageType());
+        }
+        m_poseBatchCb.push_back(handler);
+    }
+
+    void TrackerComponent::m_parentSet() {
+        m_getParent().registerMessageType(poseRecord);
+        m_getParent().registerMessageType(velocityRecord);
+        m_getParent().registerMessageType(accelerationRecord);
+        m_getParent().registerMessageType(poseBatchRecord);
+    }
+
+    int VRPN_CALLBACK
+    TrackerComponent::m_handlePoseRecord(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TrackerComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::TrackerPoseRecord::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+        for (auto const &cb : self->m_poseCb) {
+            cb(msg.getReport(), timestamp);
+        }
+        return 0;
+    }
+
+    int VRPN_CALLBACK
+    TrackerComponent::m_handleVelocityRecord(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TrackerComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::TrackerVelocityRecord::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+        for (auto const &cb : self->m_velocityCb) {
+            cb(msg.getReport(), timestamp);
+        }
+        return 0;
+    }
+
+    int VRPN_CALLBACK
+    TrackerComponent::m_handleAccelerationRecord(void *userdata,
+                                                 vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TrackerComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::TrackerAccelerationRecord::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+        for (auto const &cb : self->m_accelerationCb) {
+            cb(msg.getReport(), timestamp);
+        }
+        return 0;
+    }
+
+    int VRPN_CALLBACK
+    TrackerComponent::m_handlePoseBatchRecord(void *userdata,
+                                              vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TrackerComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::TrackerPoseBatchRecord::MessageSerialization msg(
+            p.payload_len);
+        deserialize(bufReader, msg);
+        if (!msg.isValid()) {
+            OSVR_DEV_VERBOSE("Dropping pose batch: its count of entries "
+                             "doesn't fit in the message.");
+            return 0;
+        }
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+        for (auto const &cb : self->m_poseBatchCb) {
+            cb(msg.getReports(), timestamp);
+        }
+        return 0;
+    }
+
+    OSVR_PoseState &TrackerComponent::m_getPose(OSVR_ChannelCount sensor) {
+        if (sensor >= m_poses.size()) {
+            OSVR_PoseState identity;
+            osvrPose3SetIdentity(&identity);
+            m_poses.resize(sensor + 1, identity);
+        }
+        return m_poses[sensor];
+    }
+
+    void TrackerComponent::m_sendPose(OSVR_ChannelCount sensor,
+                                      OSVR_PoseState const &pose,
+                                      OSVR_TimeValue const &timestamp) {
+        OSVR_PoseReport report;
+        report.sensor = sensor;
+        report.pose = pose;
+
+        m_buf.getContents().clear();
+        messages::TrackerPoseRecord::MessageSerialization msg(report,
+                                                              m_precision);
+        serialize(m_buf, msg);
+
+        m_getParent().packMessage(m_buf, poseRecord.getMessageType(),
+                                  timestamp);
+    }
+
+    void TrackerComponent::m_sendVelocity(OSVR_ChannelCount sensor,
+                                          OSVR_VelocityState const &state,
+                                          OSVR_TimeValue const &timestamp) {
+        OSVR_VelocityReport report;
+        report.sensor = sensor;
+        report.state = state;
+
+        m_buf.getContents().clear();
+        messages::TrackerVelocityRecord::MessageSerialization msg(report,
+                                                                  m_precision);
+        serialize(m_buf, msg);
+
+        m_getParent().packMessage(m_buf, velocityRecord.getMessageType(),
+                                  timestamp);
+    }
+
+    void TrackerComponent::m_sendAcceleration(
+        OSVR_ChannelCount sensor, OSVR_AccelerationState const &state,
+        OSVR_TimeValue const &timestamp) {
+        OSVR_AccelerationReport report;
+        report.sensor = sensor;
+        report.state = state;
+
+        m_buf.getContents().clear();
+        messages::TrackerAccelerationRecord::MessageSerialization msg(
+            report, m_precision);
+        serialize(m_buf, msg);
+
+        m_getParent().packMessage(m_buf, accelerationRecord.getMessageType(),
+                                  timestamp);
+    }
+
+} // namespace common
+} // namespace osvr
@@ -56,7 +56,7 @@ namespace connection {
             m_condMainThread.notify_one();
         }
     }
-    bool RequestToSend::request() {
+    bool RequestToSend::request(std::function<void()> const &onRequested) {
         BOOST_ASSERT_MSG(m_calledRequest == false,
                          "Can only try to request once "
                          "on a single RequestToSend "
@@ -84,6 +84,9 @@ namespace connection {
             {
                 m_lockDone.lock();
                 m_sharedDone = false;
+                if (onRequested) {
+                    onRequested();
+                }
                 while (m_mainMessage == AsyncAccessControl::MTM_WAIT) {
                     m_condAsyncThread.wait(
                         m_lock); // In here we unlock the mutex
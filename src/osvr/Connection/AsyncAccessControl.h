@@ -34,7 +34,7 @@
 #include <boost/optional/optional.hpp>
 
 // Standard includes
-// - none
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -140,8 +140,13 @@ namespace connection {
         ///
         /// Can only be called once in the lifetime of a RequestToSend object!
         ///
+        /// @param onRequested If supplied, called once the request is visible
+        /// to the main thread and before waiting on it: the place to wake the
+        /// main thread so it can't miss the request.
+        ///
         /// @returns true if request granted, false if denied.
-        bool request();
+        bool request(std::function<void()> const &onRequested =
+                         std::function<void()>());
 
         /// @brief Method to find out if this is a nested RTS - primarily for
         /// testing
@@ -27,7 +27,10 @@
 // Internal Includes
 #include "AsyncDeviceToken.h"
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/Connection.h>
 #include <osvr/Util/Verbosity.h>
+#include <osvr/Util/Logger.h>
+#include <osvr/Util/LogNames.h>
 
 // Library/third-party includes
 // - none
@@ -43,6 +46,12 @@ namespace connection {
     AsyncDeviceToken::AsyncDeviceToken(std::string const &name)
         : OSVR_DeviceTokenObject(name) {}
 
+    AsyncDeviceToken::AsyncDeviceToken(std::string const &name,
+                                       std::size_t queueCapacity)
+        : OSVR_DeviceTokenObject(name),
+          m_queue(new AsyncSendQueue(queueCapacity)),
+          m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
+
     AsyncDeviceToken::~AsyncDeviceToken() {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
                          "In ~AsyncDeviceToken");
@@ -105,11 +114,21 @@ namespace connection {
     void AsyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                       MessageType *type, const char *bytestream,
                                       size_t len) {
+        if (m_queue) {
+            /// Queued mode: never block the device thread. Drops are
+            /// counted by the queue and reported from the main thread.
+            if (m_queue->push(timestamp, type, bytestream, len)) {
+                m_getConnection()->signalWork();
+            }
+            return;
+        }
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
                          "about to create RTS object");
         RequestToSend rts(m_accessControl);
-
-        bool clear = rts.request();
+        /// Wake the main loop so it services our request promptly - once the
+        /// request is visible, so the wakeup can't come too early to see it.
+        auto conn = m_getConnection();
+        bool clear = rts.request([&] { conn->signalWork(); });
         if (!clear) {
             OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
                              "RTS request responded with not clear to send.");
@@ -125,21 +144,49 @@ namespace connection {
 
     class AsyncSendGuard : public util::GuardInterface {
       public:
-        AsyncSendGuard(AsyncAccessControl &control) : m_rts(control) {}
-        virtual bool lock() { return m_rts.request(); }
+        AsyncSendGuard(AsyncAccessControl &control, ConnectionPtr const &conn)
+            : m_rts(control), m_conn(conn) {}
+        virtual bool lock() {
+            return m_rts.request([&] { m_conn->signalWork(); });
+        }
         virtual ~AsyncSendGuard() {}
 
       private:
         RequestToSend m_rts;
+        ConnectionPtr m_conn;
     };
 
     util::GuardPtr AsyncDeviceToken::m_getSendGuard() {
-        util::GuardPtr ret(new AsyncSendGuard(m_accessControl));
+        util::GuardPtr ret(
+            new AsyncSendGuard(m_accessControl, m_getConnection()));
         return ret;
     }
 
+    AsyncSendQueueStats AsyncDeviceToken::getSendQueueStats() const {
+        if (!m_queue) {
+            return AsyncSendQueueStats{};
+        }
+        return m_queue->getStats();
+    }
+
     void AsyncDeviceToken::m_connectionInteract() {
         m_ensureThreadStarted();
+        if (m_queue) {
+            auto dev = m_getConnectionDevice();
+            m_queue->drain([&](AsyncSendQueue::Message const &msg) {
+                dev->sendData(msg.timestamp, msg.type, msg.data.data(),
+                              msg.data.size());
+            });
+            auto stats = m_queue->getStats();
+            if (stats.dropped != m_reportedDrops) {
+                m_log->warn()
+                    << getName() << ": send queue full, dropped "
+                    << (stats.dropped - m_reportedDrops)
+                    << " messages (capacity " << m_queue->capacity()
+                    << ", max depth " << stats.maxDepth << ")";
+                m_reportedDrops = stats.dropped;
+            }
+        }
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                          "Going to send a CTS if waiting");
         bool handled = m_accessControl.mainThreadCTS();
@@ -28,13 +28,17 @@
 // Internal Includes
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/CallbackWrapper.h>
+#include <osvr/Util/Log.h>
 #include "AsyncAccessControl.h"
+#include "AsyncSendQueue.h"
 
 // Library/third-party includes
 #include <boost/thread.hpp>
 #include <util/RunLoopManagerBoost.h>
 
 // Standard includes
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace osvr {
@@ -42,25 +46,40 @@ namespace connection {
     class AsyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
         AsyncDeviceToken(std::string const &name);
+        /// @brief Constructor for the queued mode: raw data sent from the
+        /// async thread is placed in a bounded lock-free queue of the given
+        /// capacity instead of waiting for a clear-to-send, and the whole
+        /// queue is flushed on each connection interaction.
+        ///
+        /// Sends made through a send guard (the built-in interface types)
+        /// still use the RTS/CTS handshake.
+        AsyncDeviceToken(std::string const &name, std::size_t queueCapacity);
         virtual ~AsyncDeviceToken();
 
         void signalShutdown();
         void signalAndWaitForShutdown();
 
+        /// @brief Whether this token was created in queued mode.
+        bool isQueued() const { return bool(m_queue); }
+
+        /// @brief Get the send queue counters - only valid in queued mode.
+        AsyncSendQueueStats getSendQueueStats() const;
+
       private:
         /// @brief Registers the given "wait callback" to service the device.
         /// The thread will be launched as soon as the first connection
         /// interaction occurs.
         void m_setUpdateCallback(DeviceUpdateCallback const &cb) override;
         /// Called from the async thread - only permitted to actually
-        /// send data when m_connectionInteract says so.
+        /// send data when m_connectionInteract says so, or enqueues the data
+        /// to be sent then if in queued mode.
         void m_sendData(util::time::TimeValue const &timestamp,
                         MessageType *type, const char *bytestream,
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
 
-        /// Called from the main thread - services requests to send from
-        /// the async thread.
+        /// Called from the main thread - flushes the send queue (if any)
+        /// and services requests to send from the async thread.
         void m_connectionInteract() override;
 
         void m_stopThreads() override;
@@ -71,6 +90,12 @@ namespace connection {
 
         AsyncAccessControl m_accessControl;
 
+        unique_ptr<AsyncSendQueue> m_queue;
+        util::log::LoggerPtr m_log;
+        /// @brief Value of the dropped-message counter last time we reported
+        /// it.
+        std::uint64_t m_reportedDrops = 0;
+
         ::util::RunLoopManagerBoost m_run;
     };
 } // namespace connection
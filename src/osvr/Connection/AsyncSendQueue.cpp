@@ -0,0 +1,81 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncSendQueue.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+
+namespace osvr {
+namespace connection {
+
+    AsyncSendQueue::AsyncSendQueue(std::size_t capacity)
+        : m_slots(capacity), m_free(capacity), m_pending(capacity),
+          m_depth(0), m_maxDepth(0), m_enqueued(0), m_dropped(0),
+          m_drained(0) {
+        if (0 == capacity) {
+            throw std::invalid_argument(
+                "AsyncSendQueue requires a non-zero capacity!");
+        }
+        for (auto &slot : m_slots) {
+            m_free.bounded_push(&slot);
+        }
+    }
+
+    AsyncSendQueue::~AsyncSendQueue() {}
+
+    bool AsyncSendQueue::push(util::time::TimeValue const &timestamp,
+                              MessageType *type, const char *bytestream,
+                              std::size_t len) {
+        Message *msg = nullptr;
+        if (!m_free.pop(msg)) {
+            ++m_dropped;
+            return false;
+        }
+        msg->timestamp = timestamp;
+        msg->type = type;
+        msg->data.assign(bytestream, bytestream + len);
+        ++m_depth;
+        /// Can't fail: there are exactly as many slots as queue capacity.
+        m_pending.bounded_push(msg);
+        ++m_enqueued;
+        return true;
+    }
+
+    AsyncSendQueueStats AsyncSendQueue::getStats() const {
+        AsyncSendQueueStats ret;
+        ret.enqueued = m_enqueued.load();
+        ret.dropped = m_dropped.load();
+        ret.drained = m_drained.load();
+        ret.depth = m_depth.load();
+        ret.maxDepth = m_maxDepth.load();
+        return ret;
+    }
+
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,132 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncSendQueue_h_GUID_2C4E8B7A_5D1F_4A36_9E02_7B61C3F8A4D9
+#define INCLUDED_AsyncSendQueue_h_GUID_2C4E8B7A_5D1F_4A36_9E02_7B61C3F8A4D9
+
+// Internal Includes
+#include <osvr/Connection/MessageTypePtr.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/lockfree/queue.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    /// @brief A snapshot of the counters kept by an AsyncSendQueue.
+    struct AsyncSendQueueStats {
+        /// @brief Messages successfully enqueued by device threads.
+        std::uint64_t enqueued = 0;
+        /// @brief Messages dropped because the queue was full.
+        std::uint64_t dropped = 0;
+        /// @brief Messages handed off to the connection by the main thread.
+        std::uint64_t drained = 0;
+        /// @brief Number of messages waiting at the time of the snapshot.
+        std::size_t depth = 0;
+        /// @brief Largest depth observed at the start of a drain.
+        std::size_t maxDepth = 0;
+    };
+
+    /// @brief A bounded, lock-free multiple-producer single-consumer queue of
+    /// timestamped messages, used by async device tokens so that device
+    /// threads never have to wait for the server main loop to send.
+    ///
+    /// All message slots are allocated up front: after each slot's payload
+    /// buffer has grown to the largest message size, no further allocation
+    /// takes place. When full, new messages are dropped (and counted) rather
+    /// than blocking the producer.
+    class AsyncSendQueue : boost::noncopyable {
+      public:
+        /// @brief A queued message, as presented to the drain callback.
+        struct Message {
+            util::time::TimeValue timestamp;
+            MessageType *type;
+            std::vector<char> data;
+        };
+
+        /// @brief Constructor
+        /// @param capacity Maximum number of messages that may be pending.
+        explicit AsyncSendQueue(std::size_t capacity);
+
+        /// @brief Destructor
+        ~AsyncSendQueue();
+
+        /// @brief Copy a message into the queue. Safe to call from any number
+        /// of producer threads.
+        ///
+        /// @returns false if the queue was full and the message was dropped.
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, std::size_t len);
+
+        /// @brief Pass every pending message, in order, to the given
+        /// function, then recycle its slot. Only one thread may drain at a
+        /// time.
+        ///
+        /// @returns the number of messages drained.
+        template <typename F> std::size_t drain(F &&f) {
+            auto depth = m_depth.load();
+            if (depth > m_maxDepth.load()) {
+                m_maxDepth = depth;
+            }
+            std::size_t count = 0;
+            Message *msg = nullptr;
+            while (m_pending.pop(msg)) {
+                --m_depth;
+                f(static_cast<Message const &>(*msg));
+                m_free.bounded_push(msg);
+                ++count;
+            }
+            m_drained += count;
+            return count;
+        }
+
+        /// @brief Get the maximum number of pending messages.
+        std::size_t capacity() const { return m_slots.size(); }
+
+        /// @brief Get a snapshot of the queue counters.
+        AsyncSendQueueStats getStats() const;
+
+      private:
+        std::vector<Message> m_slots;
+        typedef boost::lockfree::queue<Message *> SlotQueue;
+        SlotQueue m_free;
+        SlotQueue m_pending;
+
+        std::atomic<std::size_t> m_depth;
+        std::atomic<std::size_t> m_maxDepth;
+        std::atomic<std::uint64_t> m_enqueued;
+        std::atomic<std::uint64_t> m_dropped;
+        std::atomic<std::uint64_t> m_drained;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncSendQueue_h_GUID_2C4E8B7A_5D1F_4A36_9E02_7B61C3F8A4D9
@@ -36,6 +36,7 @@
 // Library/third-party includes
 #include <boost/range/algorithm.hpp>
 #include <boost/assert.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 // Standard includes
 // - none
@@ -149,6 +150,26 @@ namespace connection {
         }
     }
 
+    void Connection::signalWork() {
+        {
+            boost::unique_lock<boost::mutex> lock(m_workMutex);
+            m_workPending = true;
+        }
+        m_workCondition.notify_one();
+    }
+
+    bool Connection::waitForWork(int microseconds) {
+        boost::unique_lock<boost::mutex> lock(m_workMutex);
+        if (!m_workPending && microseconds > 0) {
+            m_workCondition.timed_wait(
+                lock, boost::posix_time::microseconds(microseconds),
+                [&] { return m_workPending; });
+        }
+        auto ret = m_workPending;
+        m_workPending = false;
+        return ret;
+    }
+
     void Connection::registerConnectionHandler(std::function<void()> handler) {
         m_registerConnectionHandler(handler);
     }
@@ -171,5 +192,13 @@ namespace connection {
 
     const char *Connection::getConnectionKindID() { return nullptr; }
 
+    std::string const &Connection::getLocalReportNamespace() const {
+        return m_localReportNamespace;
+    }
+
+    void Connection::m_setLocalReportNamespace(std::string const &ns) {
+        m_localReportNamespace = ns;
+    }
+
 } // namespace connection
 } // namespace osvr
@@ -78,6 +78,14 @@ void OSVR_DeviceInitObject::returnAnalogInterface(
     *m_analogIface = &iface;
 }
 
+void OSVR_DeviceInitObject::setAsyncSendQueueCapacity(size_t capacity) {
+    if (0 == capacity) {
+        m_asyncSendQueueCapacity.reset();
+        return;
+    }
+    m_asyncSendQueueCapacity = capacity;
+}
+
 void OSVR_DeviceInitObject::setButtons(
     OSVR_ChannelCount num, osvr::connection::ButtonServerInterface **iface) {
     if (setOptional(num, iface, m_buttons)) {
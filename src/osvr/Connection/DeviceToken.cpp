@@ -49,7 +49,14 @@ using osvr::util::GuardPtr;
 
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createAsyncDevice(DeviceInitObject &init) {
-    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName()));
+    DeviceTokenPtr ret;
+    auto queueCapacity = init.getAsyncSendQueueCapacity();
+    if (queueCapacity) {
+        ret.reset(
+            new AsyncDeviceToken(init.getQualifiedName(), *queueCapacity));
+    } else {
+        ret.reset(new AsyncDeviceToken(init.getQualifiedName()));
+    }
     ret->m_sharedInit(init);
     return ret;
 }
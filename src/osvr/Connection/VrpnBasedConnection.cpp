@@ -27,6 +27,7 @@
 #include "VrpnMessageType.h"
 #include "VrpnConnectionDevice.h"
 #include "VrpnConnectionKind.h"
+#include <osvr/Common/LocalReportChannel.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -79,6 +80,16 @@ namespace connection {
         }
         m_vrpnConnection = vrpn_ConnectionPtr::create_server_connection(
             port, nullptr, nullptr, iface);
+
+        // Clients in the same process as a loopback connection find out its
+        // namespace directly; others on this host work it out from the port.
+        if (iface && std::string(iface) == "loopback:") {
+            m_setLocalReportNamespace(
+                common::LocalReportChannel::makeUniqueNamespace());
+        } else {
+            m_setLocalReportNamespace(
+                common::LocalReportChannel::getServerNamespace(port));
+        }
     }
 
     MessageTypePtr
@@ -27,7 +27,9 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include <osvr/Connection/Connection.h>
 #include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Common/LocalReportChannel.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
 // Library/third-party includes
@@ -52,6 +54,13 @@ namespace connection {
             m_resetVel();
             m_resetAccel();
 
+            auto const &ns =
+                init.obj.getConnection()->getLocalReportNamespace();
+            if (!ns.empty()) {
+                m_local = common::LocalReportChannel::create(
+                    ns, init.getQualifiedName());
+            }
+
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
@@ -81,6 +90,17 @@ namespace connection {
             m_sendPose(sensor, timestamp);
         }
 
+        void publishLocalReport(
+            OSVR_PoseState const &val, OSVR_ChannelCount sensor,
+            util::time::TimeValue const &timestamp) override {
+            if (m_local) {
+                auto report = m_makeLocalReport(
+                    common::LocalTrackerReport::Type::Pose, sensor, timestamp);
+                report.pose = val;
+                m_local->send(report);
+            }
+        }
+
         void sendVelReport(OSVR_VelocityState const &val,
                            OSVR_ChannelCount sensor,
                            util::time::TimeValue const &timestamp) override {
@@ -172,6 +192,13 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp,
                                        Base::position_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
+            if (m_local) {
+                auto report = m_makeLocalReport(
+                    common::LocalTrackerReport::Type::Pose, sensor, ts);
+                osvrVec3FromQuatlib(&(report.pose.translation), Base::pos);
+                osvrQuatFromQuatlib(&(report.pose.rotation), Base::d_quat);
+                m_local->send(report);
+            }
         }
 
         void m_sendVelocity(OSVR_ChannelCount sensor,
@@ -184,6 +211,19 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp,
                                        Base::velocity_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
+            if (m_local) {
+                auto report = m_makeLocalReport(
+                    common::LocalTrackerReport::Type::Velocity, sensor, ts);
+                auto &state = report.velocity;
+                state.linearVelocityValid = OSVR_TRUE;
+                state.angularVelocityValid = OSVR_TRUE;
+                osvrVec3FromQuatlib(&(state.linearVelocity), Base::vel);
+                osvrQuatFromQuatlib(
+                    &(state.angularVelocity.incrementalRotation),
+                    Base::vel_quat);
+                state.angularVelocity.dt = Base::vel_quat_dt;
+                m_local->send(report);
+            }
         }
 
         void m_sendAccel(OSVR_ChannelCount sensor,
@@ -196,7 +236,38 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp, Base::accel_m_id,
                                        Base::d_sender_id, msgbuf,
                                        CLASS_OF_SERVICE);
+            if (m_local) {
+                auto report = m_makeLocalReport(
+                    common::LocalTrackerReport::Type::Acceleration, sensor,
+                    ts);
+                auto &state = report.acceleration;
+                state.linearAccelerationValid = OSVR_TRUE;
+                state.angularAccelerationValid = OSVR_TRUE;
+                osvrVec3FromQuatlib(&(state.linearAcceleration), Base::acc);
+                osvrQuatFromQuatlib(
+                    &(state.angularAcceleration.incrementalRotation),
+                    Base::acc_quat);
+                state.angularAcceleration.dt = Base::acc_quat_dt;
+                m_local->send(report);
+            }
         }
+
+        /// Starts a zeroed report for clients on this host. Like VRPN
+        /// messages, these always carry both the linear and angular parts.
+        static common::LocalTrackerReport
+        m_makeLocalReport(common::LocalTrackerReport::Type type,
+                          OSVR_ChannelCount sensor,
+                          util::time::TimeValue const &ts) {
+            common::LocalTrackerReport report = {};
+            report.type = type;
+            report.sensor = sensor;
+            report.timestamp = ts;
+            return report;
+        }
+
+        /// Also carries reports to clients on this host, if the connection
+        /// publishes locally and shared memory is available.
+        common::LocalReportChannelPtr m_local;
     };
 
 } // namespace connection
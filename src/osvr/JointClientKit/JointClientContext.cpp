@@ -65,6 +65,9 @@ namespace client {
         /// Get the VRPN connection out and use it.
         m_mainConn = static_cast<vrpn_Connection *>(std::get<0>(conn));
         m_vrpnConns.addConnection(m_mainConn, HOST);
+        /// Our devices' tracker reports can skip the loopback connection.
+        m_vrpnConns.setLocalReportNamespace(
+            HOST, std::get<1>(conn)->getLocalReportNamespace());
         BOOST_ASSERT(!m_vrpnConns.empty());
 
         /// Get the OSVR connection out and use it to make a server.
@@ -91,6 +94,10 @@ namespace client {
                 // handlers.
                 m_pathTreeOwner.replaceTree(nodes);
             }));
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                m_pathTreeOwner.applyTreeDelta(delta);
+            });
     }
 
     JointClientContext::~JointClientContext() {}
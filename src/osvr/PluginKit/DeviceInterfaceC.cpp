@@ -210,6 +210,15 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
                                  OSVR_DeviceTokenObject::createAsyncDevice);
 }
 
+OSVR_ReturnCode
+osvrDeviceAsyncSetSendQueueCapacity(OSVR_IN_PTR OSVR_DeviceInitOptions options,
+                                    OSVR_IN size_t capacity) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAsyncSetSendQueueCapacity",
+                                    options);
+    options->setAsyncSendQueueCapacity(capacity);
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
     boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
@@ -112,3 +112,34 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
 
     return OSVR_RETURN_FAILURE;
 }
+
+OSVR_ReturnCode osvrDeviceImagingAcquireFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken, OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingMetadata metadata, OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_OUT_PTR OSVR_ImageBufferElement **buffer) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrameBuffer",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrameBuffer",
+                                    buffer);
+    /// Only touches the shared memory, not the connection, so no send guard.
+    *buffer = iface->imaging->acquireImageBuffer(metadata, sensor);
+    return (nullptr == *buffer) ? OSVR_RETURN_FAILURE : OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceImagingReportAcquiredFrame(
+    OSVR_IN_PTR OSVR_DeviceToken, OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingReportAcquiredFrame",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingReportAcquiredFrame",
+                                    timestamp);
+    auto guard = iface->getSendGuard();
+    if (guard->lock()) {
+        return iface->imaging->sendAcquiredImageData(sensor, *timestamp)
+                   ? OSVR_RETURN_SUCCESS
+                   : OSVR_RETURN_FAILURE;
+    }
+
+    return OSVR_RETURN_FAILURE;
+}
@@ -28,6 +28,7 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Connection/DeviceInitObject.h>
 #include <osvr/Connection/DeviceInterfaceBase.h>
+#include <osvr/Common/TrackerComponent.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include "HandleNullContext.h"
 #include <osvr/Util/PointerWrapper.h>
@@ -37,12 +38,20 @@
 // - none
 
 // Standard includes
-// - none
+#include <vector>
 
 struct OSVR_TrackerDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
     osvr::util::PointerWrapper<osvr::connection::TrackerServerInterface>
         tracker;
+    /// Sends the same reports as native messages, alongside the VRPN ones.
+    osvr::common::TrackerComponent *native;
+    /// Whether a batch of poses is being assembled.
+    bool batchOpen = false;
+    /// Whether a batch is also sent as per-sensor VRPN reports.
+    bool batchLegacyReports = false;
+    OSVR_TimeValue batchTimestamp;
+    std::vector<OSVR_PoseReport> batch;
 };
 
 OSVR_ReturnCode
@@ -54,6 +63,21 @@ osvrDeviceTrackerConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
         opts->makeInterfaceObject<OSVR_TrackerDeviceInterfaceObject>();
     *iface = ifaceObj;
     opts->setTracker(ifaceObj->tracker);
+
+    auto native = osvr::common::TrackerComponent::create();
+    ifaceObj->native = native.get();
+    opts->addComponent(native);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceTrackerSetSinglePrecision(
+    OSVR_INOUT_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN OSVR_CBool singlePrecision) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSetSinglePrecision",
+                                    iface);
+    iface->native->setPrecision(singlePrecision
+                                    ? osvr::common::TrackerPrecision::Float
+                                    : osvr::common::TrackerPrecision::Double);
     return OSVR_RETURN_SUCCESS;
 }
 
@@ -64,8 +88,10 @@ osvrTrackerSend(const char method[], OSVR_DeviceToken,
                 OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(
-        iface, [&]() { iface->tracker->sendReport(*val, sensor, *timestamp); });
+    return useSendGuardVoid(iface, [&]() {
+        iface->tracker->sendReport(*val, sensor, *timestamp);
+        iface->native->sendReport(*val, sensor, *timestamp);
+    });
 }
 
 template <typename StateType>
@@ -77,6 +103,7 @@ osvrTrackerSendVel(const char method[], OSVR_DeviceToken,
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
     return useSendGuardVoid(iface, [&]() {
         iface->tracker->sendVelReport(*val, sensor, *timestamp);
+        iface->native->sendVelReport(*val, sensor, *timestamp);
     });
 }
 
@@ -91,6 +118,7 @@ osvrTrackerSendAccel(const char method[], OSVR_DeviceToken,
 
     return useSendGuardVoid(iface, [&]() {
         iface->tracker->sendAccelReport(*val, sensor, *timestamp);
+        iface->native->sendAccelReport(*val, sensor, *timestamp);
     });
 }
 
@@ -217,3 +245,72 @@ OSVR_ReturnCode osvrDeviceTrackerSendAngularAccelerationTimestamped(
         "osvrDeviceTrackerSendAngularAccelerationTimestamped", dev, iface, val,
         sensor, timestamp);
 }
+
+OSVR_ReturnCode osvrDeviceTrackerSetBatchLegacyReports(
+    OSVR_INOUT_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN OSVR_CBool perSensorReports) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSetBatchLegacyReports",
+                                    iface);
+    iface->batchLegacyReports = (perSensorReports == OSVR_TRUE);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceTrackerBeginBatch(OSVR_IN_PTR OSVR_DeviceToken,
+                            OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                            OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerBeginBatch", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerBeginBatch", timestamp);
+    if (iface->batchOpen) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->batchOpen = true;
+    iface->batchTimestamp = *timestamp;
+    iface->batch.clear();
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceTrackerBatchSetPose(OSVR_IN_PTR OSVR_DeviceToken,
+                              OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                              OSVR_IN_PTR OSVR_PoseState const *val,
+                              OSVR_IN OSVR_ChannelCount sensor) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerBatchSetPose", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerBatchSetPose", val);
+    if (!iface->batchOpen) {
+        return OSVR_RETURN_FAILURE;
+    }
+    OSVR_PoseReport report;
+    report.sensor = sensor;
+    report.pose = *val;
+    iface->batch.push_back(report);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceTrackerCommitBatch(OSVR_IN_PTR OSVR_DeviceToken,
+                             OSVR_IN_PTR OSVR_TrackerDeviceInterface iface) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerCommitBatch", iface);
+    if (!iface->batchOpen) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->batchOpen = false;
+    if (iface->batch.empty()) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    auto const &timestamp = iface->batchTimestamp;
+    return useSendGuardVoid(iface, [&]() {
+        for (auto const &report : iface->batch) {
+            auto sensor = static_cast<OSVR_ChannelCount>(report.sensor);
+            if (iface->batchLegacyReports) {
+                /// One VRPN message per sensor, for clients that only
+                /// understand those.
+                iface->tracker->sendReport(report.pose, sensor, timestamp);
+            } else {
+                iface->tracker->publishLocalReport(report.pose, sensor,
+                                                   timestamp);
+            }
+        }
+        iface->native->sendPoseBatch(iface->batch, timestamp);
+    });
+}
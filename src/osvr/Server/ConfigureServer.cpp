@@ -121,6 +121,9 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char LOOP_KEY[] = "loop";
+    static const char LOOP_SLEEP[] = "sleep";
+    static const char LOOP_EVENT[] = "event";
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
@@ -132,6 +135,7 @@ namespace server {
 #else
         int sleepTime = 1000; // microseconds
 #endif
+        bool eventDriven = false;
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -163,6 +167,19 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            Json::Value jsonLoop = jsonServer[LOOP_KEY];
+            if (jsonLoop.isString()) {
+                auto loop = jsonLoop.asString();
+                if (loop == LOOP_EVENT) {
+                    eventDriven = true;
+                } else if (loop != LOOP_SLEEP) {
+                    throw std::invalid_argument(
+                        "Invalid server loop mode: must be \"" +
+                        std::string(LOOP_SLEEP) + "\" or \"" +
+                        std::string(LOOP_EVENT) + "\"");
+                }
+            }
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -182,6 +199,7 @@ namespace server {
         if (sleepTime > 0.0) {
             m_server->setSleepTime(sleepTime);
         }
+        m_server->setEventDrivenLoop(eventDriven);
 
         m_server->setHardwareDetectOnConnection();
 
@@ -132,6 +132,13 @@ namespace server {
     void Server::setSleepTime(int microseconds) {
         m_impl->setSleepTime(microseconds);
     }
+
+    void Server::setEventDrivenLoop(bool eventDriven) {
+        m_impl->setEventDrivenLoop(eventDriven);
+    }
+
+    void Server::wakeUp() { m_impl->wakeUp(); }
+
 #if 0
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 #endif
@@ -94,6 +94,9 @@ namespace server {
             m_systemDevice->addComponent(common::SystemComponent::create());
         m_systemComponent->registerClientRouteUpdateHandler(
             &ServerImpl::m_handleUpdatedRoute, this);
+        // A client asking for binary trees needs a full tree sent again.
+        m_systemComponent->registerBinaryTreeRequestHandler(
+            [&] { m_queueTreeSend(); });
 
         // Things to do when we get a new incoming connection
         // No longer doing hardware detect unconditionally here - see
@@ -171,6 +174,7 @@ namespace server {
     void ServerImpl::signalStop() {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         m_run.signalShutdown();
+        m_signalWork();
     }
 
     void ServerImpl::loadPlugin(std::string const &pluginName) {
@@ -227,6 +231,7 @@ namespace server {
             m_log->debug() << "Path tree updated or connection detected";
             m_sendTree();
             m_treeDirty.reset();
+            m_fullTreeRequested.reset();
         }
     }
 
@@ -240,10 +245,19 @@ namespace server {
             shouldContinue = m_run.shouldContinue();
         }
 
-        if (m_currentSleepTime > 0) {
+        m_idle();
+        return shouldContinue;
+    }
+
+    void ServerImpl::m_idle() {
+        if (m_eventDriven) {
+            // VRPN doesn't let us block on its sockets, so bound the wait to
+            // keep servicing network traffic.
+            m_conn->waitForWork(m_currentSleepTime > 0 ? m_currentSleepTime
+                                                       : IDLE_SLEEP_TIME);
+        } else if (m_currentSleepTime > 0) {
             osvr::util::time::microsleep(m_currentSleepTime);
         }
-        return shouldContinue;
     }
 
     bool ServerImpl::addRoute(std::string const &routingDirective) {
@@ -359,18 +373,39 @@ namespace server {
         return change;
     }
     void ServerImpl::m_queueTreeSend() {
-        m_callControlled([&] { m_treeDirty += true; });
+        m_callControlled([&] {
+            m_treeDirty += true;
+            m_fullTreeRequested += true;
+        });
     }
     void ServerImpl::m_sendTree() {
 
         common::tracing::markPathTreeBroadcast();
-        m_systemComponent->sendReplacementTree(m_tree);
-        m_log->info() << "Sent path tree to clients.";
+        if (m_fullTreeRequested) {
+            m_systemComponent->sendReplacementTree(m_tree);
+            m_log->info() << "Sent path tree to clients.";
+        } else {
+            m_systemComponent->sendTreeUpdate(m_tree);
+            m_log->info() << "Sent path tree changes to clients.";
+        }
     }
 
     void ServerImpl::setSleepTime(int microseconds) {
         m_sleepTime = microseconds;
     }
+
+    void ServerImpl::setEventDrivenLoop(bool eventDriven) {
+        m_eventDriven = eventDriven;
+    }
+
+    void ServerImpl::wakeUp() { m_signalWork(); }
+
+    void ServerImpl::m_signalWork() {
+        auto conn = m_conn;
+        if (conn) {
+            conn->signalWork();
+        }
+    }
 #if 0
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 #endif
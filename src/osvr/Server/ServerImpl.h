@@ -121,6 +121,12 @@ namespace server {
 
         /// @copydoc Server::setSleepTime()
         void setSleepTime(int microseconds);
+
+        /// @copydoc Server::setEventDrivenLoop()
+        void setEventDrivenLoop(bool eventDriven);
+
+        /// @copydoc Server::wakeUp()
+        void wakeUp();
 #if 0
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
@@ -138,6 +144,13 @@ namespace server {
         /// @returns true if the loop should continue running
         bool m_loop();
 
+        /// @brief Sleep or wait for a wakeup after a loop iteration, depending
+        /// on the loop mode.
+        void m_idle();
+
+        /// @brief Wake the loop if it is waiting in event-driven mode.
+        void m_signalWork();
+
         /// @brief The actual guts of the update
         void m_update();
 
@@ -152,10 +165,11 @@ namespace server {
         /// order.
         void m_orderedDestruction();
 
-        /// @brief Queues up a tree transmission for next time around
+        /// @brief Queues up a full tree transmission for next time around
         void m_queueTreeSend();
 
-        /// @brief sends full path tree contents
+        /// @brief sends full path tree contents if requested, otherwise just
+        /// the changes since the last send.
         void m_sendTree();
 
         /// @brief handles updated route message from client
@@ -215,6 +229,9 @@ namespace server {
         /// @brief Path tree
         common::PathTree m_tree;
         util::Flag m_treeDirty;
+        /// @brief Whether the next tree send must be the full tree (e.g. for a
+        /// newly-connected client) rather than a delta.
+        util::Flag m_fullTreeRequested;
 
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
@@ -248,6 +265,10 @@ namespace server {
         /// right now. 0 = no sleeping.
         int m_currentSleepTime = IDLE_SLEEP_TIME;
 
+        /// @brief Whether to wait for a wakeup signal (with m_currentSleepTime
+        /// as an upper bound) rather than sleeping unconditionally.
+        bool m_eventDriven = false;
+
         /// The host/interface we're listening on, if any.
         std::string m_host;
 
@@ -285,9 +306,13 @@ namespace server {
     inline void ServerImpl::m_callControlled(Callable f) {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_running && boost::this_thread::get_id() != m_thread.get_id()) {
-            boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
-            TemporaryThreadIDChanger changer(m_mainThreadId);
-            f();
+            {
+                boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
+                TemporaryThreadIDChanger changer(m_mainThreadId);
+                f();
+            }
+            /// Let the loop act on whatever we just changed right away.
+            m_signalWork();
         } else {
             f();
         }
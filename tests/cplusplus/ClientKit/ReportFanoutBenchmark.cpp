@@ -0,0 +1,175 @@
+/** @file
+    @brief Implementation of a manual benchmark measuring how many tracker
+   reports per second one client context delivers to its interfaces, driving
+   the real tracker handler with reports from a server on a local connection.
+
+   Uses the default local port, so don't run it alongside an OSVR server.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/ClientKit/Context.h>
+#include <osvr/ClientKit/Interface.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Server/Server.h>
+
+// Library/third-party includes
+#include <vrpn_Connection.h>
+#include <vrpn_Shared.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static const char DEVICE_NAME[] = "ReportFanoutBench";
+static const char DEVICE_PATH[] = "/bench";
+
+static std::size_t g_poses = 0;
+static std::size_t g_callbacks = 0;
+
+static void poseCallback(void *, const OSVR_TimeValue *,
+                         const OSVR_PoseReport *) {
+    ++g_poses;
+    ++g_callbacks;
+}
+static void positionCallback(void *, const OSVR_TimeValue *,
+                             const OSVR_PositionReport *) {
+    ++g_callbacks;
+}
+static void orientationCallback(void *, const OSVR_TimeValue *,
+                                const OSVR_OrientationReport *) {
+    ++g_callbacks;
+}
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+int main(int argc, char *argv[]) {
+    int sensors = 50;
+    int reportsPerUpdate = 10;
+    int updates = 2000;
+    if (argc > 1) {
+        sensors = std::atoi(argv[1]);
+    }
+    if (argc > 2) {
+        reportsPerUpdate = std::atoi(argv[2]);
+    }
+    if (argc > 3) {
+        updates = std::atoi(argv[3]);
+    }
+
+    /// Server side: a local-only server with a plain VRPN tracker device on
+    /// its connection, entered in the path tree as an external device.
+    auto conn = osvr::connection::Connection::createLocalConnection();
+    auto server = osvr::server::Server::create(conn);
+    auto vrpnConn = static_cast<vrpn_Connection *>(conn->getUnderlyingObject());
+    vrpn_Tracker_Server tracker(DEVICE_NAME, vrpnConn, sensors);
+    server->registerMainloopMethod([&] { tracker.mainloop(); });
+    server->addExternalDevice(
+        DEVICE_PATH, DEVICE_NAME, "localhost",
+        "{\"interfaces\": {\"tracker\": {\"count\": " +
+            std::to_string(sensors) + "}}}");
+
+    /// Client side: one interface per sensor, each with the three callback
+    /// types a tracker handler fans out to.
+    osvr::clientkit::ClientContext context("com.osvr.bench.ReportFanout");
+    std::vector<osvr::clientkit::Interface> ifaces;
+    for (int i = 0; i < sensors; ++i) {
+        auto iface = context.getInterface(std::string(DEVICE_PATH) +
+                                          "/tracker/" + std::to_string(i));
+        iface.registerCallback(&poseCallback, nullptr);
+        iface.registerCallback(&positionCallback, nullptr);
+        iface.registerCallback(&orientationCallback, nullptr);
+        ifaces.push_back(iface);
+    }
+
+    const vrpn_float64 quat[4] = {0, 0, 0, 1};
+    auto sendReports = [&](int reports) {
+        struct timeval now;
+        vrpn_gettimeofday(&now, nullptr);
+        for (int s = 0; s < sensors; ++s) {
+            for (int i = 0; i < reports; ++i) {
+                const vrpn_float64 pos[3] = {0.01 * i, 1.5, -0.2};
+                tracker.report_pose(s, now, pos, quat,
+                                    vrpn_CONNECTION_RELIABLE);
+            }
+        }
+    };
+
+    /// Wait until the path tree has arrived and every sensor's handler is
+    /// connected and delivering.
+    {
+        auto deadline = clock_type::now() + std::chrono::seconds(10);
+        while (g_poses < std::size_t(sensors)) {
+            if (clock_type::now() > deadline) {
+                std::cerr << "Timed out waiting for the client to connect and "
+                             "receive reports."
+                          << std::endl;
+                return -1;
+            }
+            sendReports(1);
+            server->update();
+            context.update();
+        }
+    }
+    g_poses = 0;
+    g_callbacks = 0;
+
+    std::cout << sensors << " tracked sensors, " << reportsPerUpdate
+              << " reports per sensor per update, " << updates << " updates\n";
+
+    clock_type::duration clientTime{};
+    auto begin = clock_type::now();
+    for (int u = 0; u < updates; ++u) {
+        sendReports(reportsPerUpdate);
+        server->update();
+        auto clientBegin = clock_type::now();
+        context.update();
+        clientTime += clock_type::now() - clientBegin;
+    }
+    /// Drain anything still in flight.
+    auto expected = std::size_t(updates) * sensors * reportsPerUpdate;
+    {
+        auto deadline = clock_type::now() + std::chrono::seconds(5);
+        while (g_poses < expected && clock_type::now() < deadline) {
+            server->update();
+            auto clientBegin = clock_type::now();
+            context.update();
+            clientTime += clock_type::now() - clientBegin;
+        }
+    }
+    auto seconds =
+        std::chrono::duration<double>(clock_type::now() - begin).count();
+    auto clientSeconds = std::chrono::duration<double>(clientTime).count();
+
+    std::cout << "Received " << g_poses << " of " << expected
+              << " pose reports (" << g_callbacks << " callbacks)\n";
+    std::cout << "End to end:          " << g_poses / seconds
+              << " reports/sec\n";
+    std::cout << "Client update only:  " << g_poses / clientSeconds
+              << " reports/sec" << std::endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <thread>
+
+using osvr::common::IPCRingBuffer;
+using osvr::common::IPCRingBufferPtr;
+
+namespace {
+static const IPCRingBuffer::entry_size_type ENTRY_SIZE = 1024;
+IPCRingBuffer::Options makeOptions(const char *name) {
+    return IPCRingBuffer::Options(name)
+        .setEntries(4)
+        .setEntrySize(ENTRY_SIZE)
+        .setMaxReaders(2);
+}
+void putValue(IPCRingBuffer &buf, IPCRingBuffer::value_type val) {
+    IPCRingBuffer::value_type data[ENTRY_SIZE] = {val};
+    buf.put(data, sizeof(data));
+}
+} // namespace
+
+TEST(IPCRingBuffer, ReaderCursorConsumesInOrder) {
+    auto server = IPCRingBuffer::create(makeOptions("TestIPCRingBufferOrder"));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("TestIPCRingBufferOrder"));
+    ASSERT_TRUE(bool(client));
+
+    ASSERT_FALSE(bool(client->getNext())) << "No cursor registered yet";
+    ASSERT_TRUE(client->registerReader());
+    ASSERT_TRUE(client->hasReaderCursor());
+    ASSERT_FALSE(bool(client->getNext())) << "Nothing published yet";
+
+    putValue(*server, 1);
+    putValue(*server, 2);
+    {
+        auto first = client->getNext();
+        ASSERT_TRUE(bool(first));
+        ASSERT_EQ(0, first.getSequenceNumber());
+        ASSERT_EQ(1, first.get()[0]);
+    }
+    {
+        auto second = client->getNext();
+        ASSERT_TRUE(bool(second));
+        ASSERT_EQ(2, second.get()[0]);
+    }
+    ASSERT_FALSE(bool(client->getNext()));
+
+    auto stats = client->getReaderStats();
+    ASSERT_TRUE(stats.active);
+    ASSERT_EQ(2, stats.consumed);
+    ASSERT_EQ(0, stats.missed);
+    ASSERT_EQ(0, stats.lag);
+}
+
+TEST(IPCRingBuffer, SlowReaderCountsMissed) {
+    auto server = IPCRingBuffer::create(makeOptions("TestIPCRingBufferMiss"));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("TestIPCRingBufferMiss"));
+    ASSERT_TRUE(bool(client));
+    ASSERT_TRUE(client->registerReader());
+
+    // Six entries into a four-entry ring: the first two are overwritten.
+    for (IPCRingBuffer::value_type i = 0; i < 6; ++i) {
+        putValue(*server, i);
+    }
+    auto all = server->getAllReaderStats();
+    ASSERT_EQ(2, all.size());
+    ASSERT_TRUE(all[0].active);
+    ASSERT_EQ(6, all[0].lag);
+    ASSERT_FALSE(all[1].active);
+
+    auto next = client->getNext();
+    ASSERT_TRUE(bool(next));
+    ASSERT_EQ(2, next.getSequenceNumber());
+    ASSERT_EQ(2, next.get()[0]);
+    ASSERT_EQ(2, client->getReaderStats().missed);
+}
+
+TEST(IPCRingBuffer, GetBySequenceNumberAdvancesCursor) {
+    auto server = IPCRingBuffer::create(makeOptions("TestIPCRingBufferGet"));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("TestIPCRingBufferGet"));
+    ASSERT_TRUE(bool(client));
+    ASSERT_TRUE(client->registerReader());
+
+    for (IPCRingBuffer::value_type i = 0; i < 3; ++i) {
+        putValue(*server, i);
+    }
+    ASSERT_TRUE(bool(client->get(2)));
+    auto stats = client->getReaderStats();
+    ASSERT_EQ(1, stats.consumed);
+    ASSERT_EQ(2, stats.missed);
+    ASSERT_EQ(3, stats.next);
+
+    // Re-reading an older entry doesn't move the cursor back.
+    ASSERT_TRUE(bool(client->get(1)));
+    ASSERT_EQ(3, client->getReaderStats().next);
+}
+
+TEST(IPCRingBuffer, ReaderSlotsAreLimitedAndReleased) {
+    auto server = IPCRingBuffer::create(makeOptions("TestIPCRingBufferSlots"));
+    ASSERT_TRUE(bool(server));
+    auto a = IPCRingBuffer::find(makeOptions("TestIPCRingBufferSlots"));
+    auto b = IPCRingBuffer::find(makeOptions("TestIPCRingBufferSlots"));
+    auto c = IPCRingBuffer::find(makeOptions("TestIPCRingBufferSlots"));
+    ASSERT_TRUE(a->registerReader());
+    ASSERT_TRUE(b->registerReader());
+    ASSERT_FALSE(c->registerReader());
+    a.reset();
+    ASSERT_TRUE(c->registerReader());
+}
+
+TEST(IPCRingBuffer, WaitForNextWakesOnPut) {
+    auto server = IPCRingBuffer::create(makeOptions("TestIPCRingBufferWait"));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("TestIPCRingBufferWait"));
+    ASSERT_TRUE(bool(client));
+    ASSERT_TRUE(client->registerReader());
+
+    ASSERT_FALSE(client->waitForNext(10));
+    std::thread producer([&] { putValue(*server, 42); });
+    ASSERT_TRUE(client->waitForNext(5000));
+    producer.join();
+    auto next = client->getNext();
+    ASSERT_TRUE(bool(next));
+    ASSERT_EQ(42, next.get()[0]);
+}
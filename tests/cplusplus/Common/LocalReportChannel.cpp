@@ -0,0 +1,172 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/LocalReportChannel.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <thread>
+
+using osvr::common::LocalReportChannel;
+using osvr::common::LocalTrackerReport;
+
+namespace {
+static const char NAMESPACE[] = "test";
+LocalTrackerReport makePose(OSVR_ChannelCount sensor, double x) {
+    LocalTrackerReport report;
+    report.type = LocalTrackerReport::Type::Pose;
+    report.sensor = sensor;
+    report.timestamp.seconds = 1;
+    report.timestamp.microseconds = sensor;
+    report.pose.translation.data[0] = x;
+    report.pose.translation.data[1] = 0;
+    report.pose.translation.data[2] = 0;
+    report.pose.rotation.data[0] = 1;
+    report.pose.rotation.data[1] = 0;
+    report.pose.rotation.data[2] = 0;
+    report.pose.rotation.data[3] = 0;
+    return report;
+}
+} // namespace
+
+TEST(LocalReportChannel, NamespaceForServer) {
+    auto defaultNs = LocalReportChannel::getServerNamespace();
+    ASSERT_EQ(defaultNs, LocalReportChannel::getNamespaceForServer("localhost"));
+    ASSERT_EQ(defaultNs,
+              LocalReportChannel::getNamespaceForServer("127.0.0.1"));
+    ASSERT_EQ(LocalReportChannel::getServerNamespace(7000),
+              LocalReportChannel::getNamespaceForServer("localhost:7000"));
+    ASSERT_NE(defaultNs, LocalReportChannel::getServerNamespace(7000));
+    ASSERT_TRUE(
+        LocalReportChannel::getNamespaceForServer("example.com").empty());
+    ASSERT_NE(LocalReportChannel::makeUniqueNamespace(),
+              LocalReportChannel::makeUniqueNamespace());
+}
+
+TEST(LocalReportChannel, OpenRequiresChannel) {
+    ASSERT_FALSE(bool(LocalReportChannel::open(NAMESPACE, "NoSuchDevice")));
+}
+
+TEST(LocalReportChannel, ReceivesInOrder) {
+    auto server = LocalReportChannel::create(NAMESPACE, "Order");
+    ASSERT_TRUE(bool(server));
+    server->send(makePose(0, 0.5));
+    auto client = LocalReportChannel::open(NAMESPACE, "Order");
+    ASSERT_TRUE(bool(client));
+
+    LocalTrackerReport report;
+    ASSERT_FALSE(client->receive(report))
+        << "Only reports sent after opening should be received";
+    server->send(makePose(1, 1.5));
+    server->send(makePose(2, 2.5));
+    ASSERT_TRUE(client->receive(report));
+    ASSERT_EQ(LocalTrackerReport::Type::Pose, report.type);
+    ASSERT_EQ(1, report.sensor);
+    ASSERT_EQ(1.5, report.pose.translation.data[0]);
+    ASSERT_TRUE(client->receive(report));
+    ASSERT_EQ(2, report.sensor);
+    ASSERT_FALSE(client->receive(report));
+    ASSERT_EQ(0, client->getMissed());
+}
+
+TEST(LocalReportChannel, SlowReaderSkipsAhead) {
+    auto server = LocalReportChannel::create(NAMESPACE, "Lapped", 4);
+    ASSERT_TRUE(bool(server));
+    auto client = LocalReportChannel::open(NAMESPACE, "Lapped");
+    ASSERT_TRUE(bool(client));
+    for (OSVR_ChannelCount i = 0; i < 10; ++i) {
+        server->send(makePose(i, i));
+    }
+    LocalTrackerReport report;
+    ASSERT_TRUE(client->receive(report));
+    ASSERT_EQ(6, report.sensor) << "Should start at the oldest report left";
+    ASSERT_EQ(6, client->getMissed());
+    for (OSVR_ChannelCount i = 7; i < 10; ++i) {
+        ASSERT_TRUE(client->receive(report));
+        ASSERT_EQ(i, report.sensor);
+    }
+    ASSERT_FALSE(client->receive(report));
+}
+
+TEST(LocalReportChannel, ConcurrentReaderSeesConsistentReports) {
+    static const OSVR_ChannelCount REPORTS = 100000;
+    auto server = LocalReportChannel::create(NAMESPACE, "Concurrent", 16);
+    ASSERT_TRUE(bool(server));
+    auto client = LocalReportChannel::open(NAMESPACE, "Concurrent");
+    ASSERT_TRUE(bool(client));
+
+    std::thread writer([&] {
+        for (OSVR_ChannelCount i = 1; i <= REPORTS; ++i) {
+            server->send(makePose(i, i));
+        }
+    });
+    OSVR_ChannelCount last = 0;
+    OSVR_ChannelCount received = 0;
+    LocalTrackerReport report;
+    while (last < REPORTS) {
+        if (!client->receive(report)) {
+            continue;
+        }
+        // Every field was written from the same number: a torn copy would
+        // show up as a mismatch.
+        ASSERT_EQ(double(report.sensor), report.pose.translation.data[0]);
+        ASSERT_EQ(report.sensor, report.timestamp.microseconds);
+        ASSERT_GT(report.sensor, last) << "Reports must arrive in order";
+        last = report.sensor;
+        ++received;
+    }
+    writer.join();
+    ASSERT_EQ(REPORTS, received + client->getMissed());
+}
+
+TEST(LocalReportChannel, ReaderSeesWriterClose) {
+    auto server = LocalReportChannel::create(NAMESPACE, "Close");
+    ASSERT_TRUE(bool(server));
+    auto client = LocalReportChannel::open(NAMESPACE, "Close");
+    ASSERT_TRUE(bool(client));
+    ASSERT_TRUE(client->isWriterOpen());
+    ASSERT_EQ(server->getGeneration(), client->getGeneration());
+    server.reset();
+    ASSERT_FALSE(client->isWriterOpen());
+    ASSERT_FALSE(bool(LocalReportChannel::open(NAMESPACE, "Close")));
+}
+
+TEST(LocalReportChannel, RecreatedChannelHasNewGeneration) {
+    auto server = LocalReportChannel::create(NAMESPACE, "Recreated");
+    ASSERT_TRUE(bool(server));
+    auto client = LocalReportChannel::open(NAMESPACE, "Recreated");
+    ASSERT_TRUE(bool(client));
+    /// As a restarted server would: the old channel is replaced, not closed.
+    auto replacement = LocalReportChannel::create(NAMESPACE, "Recreated");
+    ASSERT_TRUE(bool(replacement));
+    ASSERT_TRUE(client->isWriterOpen());
+    auto reopened = LocalReportChannel::open(NAMESPACE, "Recreated");
+    ASSERT_TRUE(bool(reopened));
+    ASSERT_EQ(replacement->getGeneration(), reopened->getGeneration());
+    ASSERT_NE(client->getGeneration(), reopened->getGeneration());
+}
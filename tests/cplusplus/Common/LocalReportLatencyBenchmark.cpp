@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation of a manual benchmark comparing the per-report
+   latency of tracker reports sent over a VRPN loopback connection with that
+   of a shared memory local report channel.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/LocalReportChannel.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace common = osvr::common;
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+/// @brief Times each of the given number of round trips, each one being a
+/// report sent and then received, returning the latencies in microseconds.
+template <typename F>
+static std::vector<double> timeEach(int iterations, F &&roundTrip) {
+    std::vector<double> ret;
+    ret.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        auto begin = clock_type::now();
+        roundTrip(i);
+        auto elapsed = clock_type::now() - begin;
+        ret.push_back(
+            std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+    return ret;
+}
+
+static void printStats(const char *label, std::vector<double> latencies) {
+    std::sort(begin(latencies), end(latencies));
+    double sum = 0;
+    for (auto latency : latencies) {
+        sum += latency;
+    }
+    auto percentile = [&](double p) {
+        return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))];
+    };
+    std::cout << label << ": mean " << sum / latencies.size()
+              << " us, median " << percentile(0.5) << " us, 99th percentile "
+              << percentile(0.99) << " us, max " << latencies.back()
+              << " us\n";
+}
+
+struct VrpnReceiver {
+    int received = 0;
+    static void VRPN_CALLBACK handle(void *userdata, const vrpn_TRACKERCB) {
+        static_cast<VrpnReceiver *>(userdata)->received++;
+    }
+};
+
+int main(int argc, char *argv[]) {
+    int iterations = 100000;
+    if (argc > 1) {
+        iterations = std::atoi(argv[1]);
+    }
+    static const auto DEVICE = "com_osvr_Benchmark/Tracker";
+    const vrpn_float64 pos[3] = {0.1, 0.2, 0.3};
+    const vrpn_float64 quat[4] = {0, 0, 0, 1};
+
+    /// What a joint client/server does without local reports: pack a
+    /// message, run it through the loopback connection and parse it back
+    /// out in a remote.
+    std::vector<double> vrpnLatencies;
+    {
+        auto conn = vrpn_ConnectionPtr::create_server_connection("loopback:");
+        vrpn_Tracker_Server server(DEVICE, conn.get());
+        vrpn_Tracker_Remote remote(DEVICE, conn.get());
+        VrpnReceiver receiver;
+        remote.register_change_handler(&receiver, &VrpnReceiver::handle);
+        // Let the sender and message types get registered.
+        for (int i = 0; i < 10; ++i) {
+            server.mainloop();
+            conn->mainloop();
+            remote.mainloop();
+        }
+        vrpnLatencies = timeEach(iterations, [&](int i) {
+            struct timeval now;
+            vrpn_gettimeofday(&now, nullptr);
+            server.report_pose(0, now, pos, quat);
+            server.mainloop();
+            conn->mainloop();
+            while (receiver.received <= i) {
+                remote.mainloop();
+            }
+        });
+    }
+
+    /// What the tracker remote handler does with local reports.
+    std::vector<double> localLatencies;
+    {
+        auto ns = common::LocalReportChannel::makeUniqueNamespace();
+        auto writer = common::LocalReportChannel::create(ns, DEVICE);
+        auto reader = common::LocalReportChannel::open(ns, DEVICE);
+        if (!writer || !reader) {
+            std::cerr << "Could not set up a local report channel!"
+                      << std::endl;
+            return -1;
+        }
+        common::LocalTrackerReport report;
+        report.type = common::LocalTrackerReport::Type::Pose;
+        report.sensor = 0;
+        report.pose.translation = {{pos[0], pos[1], pos[2]}};
+        report.pose.rotation = {{quat[3], quat[0], quat[1], quat[2]}};
+        localLatencies = timeEach(iterations, [&](int) {
+            osvr::util::time::getNow(report.timestamp);
+            writer->send(report);
+            common::LocalTrackerReport received;
+            while (!reader->receive(received)) {
+            }
+        });
+    }
+
+    std::cout << iterations << " pose reports, each sent and received\n";
+    printStats("VRPN loopback     ", vrpnLatencies);
+    printStats("Local report chan.", localLatencies);
+    return 0;
+}
@@ -0,0 +1,137 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/JSONSerializationTags.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/reader.h>
+#include <boost/variant/get.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+
+namespace common = osvr::common;
+namespace elements = osvr::common::elements;
+using osvr::common::PathTree;
+
+namespace {
+Json::Value parse(std::string const &json) {
+    Json::Value ret;
+    Json::Reader reader;
+    if (!reader.parse(json, ret)) {
+        throw std::runtime_error("Could not parse test JSON");
+    }
+    return ret;
+}
+
+void setupDescriptorTree(PathTree &tree) {
+    setupDummyTree(tree);
+    auto &dev = tree.getNodeByPath(dummy::getDevicePath()).value();
+    boost::get<elements::DeviceElement>(dev).getDescriptor() =
+        parse(R"({"interfaces": {"tracker": {"count": 2, "bounded": true},
+                 "analog": {"count": 3, "range": [-1.5, 1.5]}},
+                 "semantic": {"left": "tracker/0", "offset": -7},
+                 "empty": null, "name": "Some device"})");
+    tree.getNodeByPath("/me/head").value() =
+        elements::AliasElement("/some/source", 2);
+    tree.getNodeByPath("/display").value() =
+        elements::StringElement("{\"hmd\": true}");
+}
+} // namespace
+
+TEST(PathTreeBinary, JsonBinaryRoundtrip) {
+    auto val = parse(R"({"a": [1, -2, 3.25, "four", false, null, {}],
+                         "b": {"c": {"d": 18446744073709551615}}})");
+    osvr::common::Buffer<> buf;
+    common::serialization::serializeRaw(buf, val,
+                                        common::serialization::JsonBinaryTag());
+    ASSERT_EQ(buf.size(), common::serialization::getBufferSpaceRequiredRaw(
+                              0, val, common::serialization::JsonBinaryTag()));
+
+    Json::Value out;
+    auto reader = buf.startReading();
+    common::serialization::deserializeRaw(
+        reader, out, common::serialization::JsonBinaryTag());
+    ASSERT_EQ(0u, reader.bytesRemaining());
+    ASSERT_EQ(val, out);
+}
+
+TEST(PathTreeBinary, EmptyTree) {
+    PathTree tree;
+    auto binary = common::pathTreeToBinary(tree);
+    ASSERT_EQ(Json::Value(Json::arrayValue),
+              common::binaryToPathTreeJson(binary.data(), binary.size()));
+}
+
+TEST(PathTreeBinary, DecodesToSameJson) {
+    PathTree tree;
+    setupDescriptorTree(tree);
+    auto binary = common::pathTreeToBinary(tree);
+    auto json = common::pathTreeToJson(tree);
+    ASSERT_EQ(json,
+              common::binaryToPathTreeJson(binary.data(), binary.size()));
+}
+
+TEST(PathTreeBinary, DecodesToSameTree) {
+    PathTree tree;
+    setupDescriptorTree(tree);
+    auto binary = common::pathTreeToBinary(tree);
+
+    PathTree tree2;
+    ASSERT_NO_THROW(
+        common::binaryToPathTree(tree2, binary.data(), binary.size()));
+    ASSERT_EQ(common::pathTreeToJson(tree, true),
+              common::pathTreeToJson(tree2, true));
+}
+
+TEST(PathTreeBinary, SmallerThanJson) {
+    PathTree tree;
+    setupDescriptorTree(tree);
+    auto binary = common::pathTreeToBinary(tree);
+    auto text = Json::FastWriter().write(common::pathTreeToJson(tree));
+    ASSERT_LT(binary.size(), text.size());
+}
+
+TEST(PathTreeBinary, RejectsBadData) {
+    PathTree tree;
+    setupDescriptorTree(tree);
+    auto binary = common::pathTreeToBinary(tree);
+
+    auto wrongVersion = binary;
+    wrongVersion[0] = static_cast<char>(
+        common::getPathTreeBinaryFormatVersion() + 1);
+    ASSERT_THROW(common::binaryToPathTreeJson(wrongVersion.data(),
+                                              wrongVersion.size()),
+                 std::runtime_error);
+    ASSERT_THROW(
+        common::binaryToPathTreeJson(binary.data(), binary.size() - 1),
+        std::runtime_error);
+}
@@ -0,0 +1,176 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeObserver.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/variant/get.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace common = osvr::common;
+namespace elements = osvr::common::elements;
+using osvr::common::PathTree;
+
+namespace {
+Json::Value makeVersioned(Json::Value delta, Json::UInt base,
+                          Json::UInt version) {
+    delta[common::tree_delta_keys::baseVersion()] = base;
+    delta[common::tree_delta_keys::version()] = version;
+    return delta;
+}
+} // namespace
+
+TEST(PathTreeDelta, IdenticalTreesGiveEmptyDelta) {
+    PathTree tree;
+    setupDummyTree(tree);
+    auto json = common::pathTreeToJson(tree);
+    auto delta = common::pathTreeDelta(json, json);
+    ASSERT_TRUE(common::isPathTreeDeltaEmpty(delta));
+    ASSERT_TRUE(common::getPathTreeDeltaPaths(delta).empty());
+}
+
+TEST(PathTreeDelta, DeltaContainsOnlyChanges) {
+    PathTree before;
+    setupDummyTree(before);
+    PathTree after;
+    setupDummyTree(after);
+    after.getNodeByPath("/me/hands/left").value() =
+        elements::AliasElement("/some/other/source");
+    after.getNodeByPath("/me/head", elements::AliasElement("/a/b"));
+
+    auto delta = common::pathTreeDelta(common::pathTreeToJson(before),
+                                       common::pathTreeToJson(after));
+    ASSERT_FALSE(common::isPathTreeDeltaEmpty(delta));
+    auto paths = common::getPathTreeDeltaPaths(delta);
+    ASSERT_EQ(2u, paths.size());
+    ASSERT_NE(end(paths), std::find(begin(paths), end(paths), "/me/head"));
+    ASSERT_NE(end(paths),
+              std::find(begin(paths), end(paths), "/me/hands/left"));
+}
+
+TEST(PathTreeDelta, ApplyDeltaMatchesNewTree) {
+    PathTree before;
+    setupDummyTree(before);
+    before.getNodeByPath("/me/head", elements::AliasElement("/a/b"));
+    PathTree after;
+    setupDummyTree(after);
+    after.getNodeByPath("/me/hands/left").value() =
+        elements::AliasElement("/some/other/source");
+
+    auto delta = common::pathTreeDelta(common::pathTreeToJson(before),
+                                       common::pathTreeToJson(after));
+    ASSERT_EQ(1u, delta[common::tree_delta_keys::removed()].size());
+    common::applyPathTreeDelta(before, delta);
+
+    ASSERT_EQ(
+        "/some/other/source",
+        boost::get<elements::AliasElement>(
+            before.getNodeByPath("/me/hands/left").value()).getSource());
+    ASSERT_TRUE(
+        (boost::get<elements::NullElement>(
+             &before.getNodeByPath("/me/head").value()) != nullptr));
+}
+
+TEST(PathTreeDelta, OwnerAppliesVersionedDeltasInOrder) {
+    common::PathTreeOwner owner;
+    std::vector<std::string> touched;
+    int fullUpdates = 0;
+    auto observer = owner.makeObserver();
+    observer->setEventCallback(common::PathTreeEvents::AfterUpdate,
+                               [&](PathTree &) { ++fullUpdates; });
+    observer->setPartialEventCallback(
+        common::PathTreeEvents::AfterUpdate,
+        [&](PathTree &, std::vector<std::string> const &paths) {
+            touched = paths;
+        });
+
+    PathTree server;
+    setupDummyTree(server);
+    auto v0 = common::pathTreeToJson(server);
+    Json::Value marker(Json::objectValue);
+
+    // A delta before any full tree is ignored.
+    ASSERT_FALSE(owner.applyTreeDelta(makeVersioned(marker, 0, 0)));
+    owner.replaceTree(v0);
+    ASSERT_EQ(1, fullUpdates);
+    ASSERT_TRUE(owner.applyTreeDelta(makeVersioned(marker, 0, 0)));
+
+    server.getNodeByPath("/me/head", elements::AliasElement("/a/b"));
+    auto v1 = common::pathTreeToJson(server);
+    auto delta = common::pathTreeDelta(v0, v1);
+
+    // Wrong base version: ignored.
+    ASSERT_FALSE(owner.applyTreeDelta(makeVersioned(delta, 5, 6)));
+    ASSERT_TRUE(touched.empty());
+
+    ASSERT_TRUE(owner.applyTreeDelta(makeVersioned(delta, 0, 1)));
+    ASSERT_EQ(1, fullUpdates) << "Deltas should give partial updates";
+    ASSERT_EQ(1u, touched.size());
+    ASSERT_EQ("/me/head", touched.front());
+    ASSERT_EQ(v1, common::pathTreeToJson(owner.get()));
+
+    // Re-applying the same delta is rejected: we're now at version 1.
+    ASSERT_FALSE(owner.applyTreeDelta(makeVersioned(delta, 0, 1)));
+}
+
+TEST(PathTreeDelta, ReplacingPopulatedTreeIsPartial) {
+    common::PathTreeOwner owner;
+    std::vector<std::string> touched;
+    int fullUpdates = 0;
+    auto observer = owner.makeObserver();
+    observer->setEventCallback(common::PathTreeEvents::AfterUpdate,
+                               [&](PathTree &) { ++fullUpdates; });
+    observer->setPartialEventCallback(
+        common::PathTreeEvents::AfterUpdate,
+        [&](PathTree &, std::vector<std::string> const &paths) {
+            touched = paths;
+        });
+
+    PathTree server;
+    setupDummyTree(server);
+    owner.replaceTree(common::pathTreeToJson(server));
+    ASSERT_EQ(1, fullUpdates);
+
+    // Same tree again: nothing to notify about.
+    owner.replaceTree(common::pathTreeToJson(server));
+    ASSERT_EQ(1, fullUpdates);
+    ASSERT_TRUE(touched.empty());
+
+    server.getNodeByPath("/me/head", elements::AliasElement("/a/b"));
+    owner.replaceTree(common::pathTreeToJson(server));
+    ASSERT_EQ(1, fullUpdates);
+    ASSERT_EQ(1u, touched.size());
+    ASSERT_EQ(common::pathTreeToJson(server),
+              common::pathTreeToJson(owner.get()));
+}
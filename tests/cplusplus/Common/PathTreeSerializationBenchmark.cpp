@@ -0,0 +1,136 @@
+/** @file
+    @brief Implementation of a manual benchmark comparing the JSON and binary
+   path tree serializations on a large synthetic tree.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/PathNode.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/PathTreeSerialization.h>
+
+// Library/third-party includes
+#include <json/reader.h>
+#include <json/writer.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using osvr::common::PathTree;
+namespace common = osvr::common;
+namespace elements = osvr::common::elements;
+
+/// @brief Builds a tree shaped like a large real configuration: many devices
+/// with descriptors, each with a few interfaces and sensors, and an alias for
+/// each sensor.
+static void buildSyntheticTree(PathTree &tree, int devices) {
+    for (int d = 0; d < devices; ++d) {
+        auto dev = "com_osvr_Synthetic/Device" + std::to_string(d);
+        Json::Value desc(Json::objectValue);
+        desc["deviceVendor"] = "Synthetic";
+        desc["deviceName"] = "Device " + std::to_string(d);
+        auto &ifaces = desc["interfaces"];
+        ifaces["tracker"]["count"] = 4;
+        ifaces["tracker"]["position"] = true;
+        ifaces["tracker"]["orientation"] = true;
+        ifaces["button"]["count"] = 8;
+        ifaces["analog"]["count"] = 2;
+        ifaces["analog"]["range"].append(-1.0);
+        ifaces["analog"]["range"].append(1.0);
+        auto elt = elements::DeviceElement::createVRPNDeviceElement(
+            dev, "localhost:3883");
+        elt.getDescriptor() = desc;
+        tree.getNodeByPath("/" + dev).value() = elt;
+        for (auto iface : {"tracker", "button", "analog"}) {
+            tree.getNodeByPath("/" + dev + "/" + iface).value() =
+                elements::InterfaceElement();
+        }
+        for (int s = 0; s < 4; ++s) {
+            auto sensor = "/" + dev + "/tracker/" + std::to_string(s);
+            tree.getNodeByPath(sensor).value() = elements::SensorElement();
+            tree.getNodeByPath("/synthetic/device" + std::to_string(d) +
+                               "/sensor" + std::to_string(s))
+                .value() = elements::AliasElement(sensor);
+        }
+    }
+}
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+template <typename F> static double timeIt(int iterations, F &&f) {
+    auto begin = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto elapsed = clock_type::now() - begin;
+    return std::chrono::duration<double, std::milli>(elapsed).count() /
+           iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int devices = 200;
+    int iterations = 20;
+    if (argc > 1) {
+        devices = std::atoi(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = std::atoi(argv[2]);
+    }
+    PathTree tree;
+    buildSyntheticTree(tree, devices);
+
+    std::string text;
+    std::string binary;
+
+    /// These match what SystemComponent does with each format.
+    auto jsonEncode = timeIt(iterations, [&] {
+        text = Json::FastWriter().write(common::pathTreeToJson(tree));
+    });
+    auto jsonDecode = timeIt(iterations, [&] {
+        Json::Value nodes;
+        Json::Reader().parse(text, nodes);
+    });
+    auto binaryEncode =
+        timeIt(iterations, [&] { binary = common::pathTreeToBinary(tree); });
+    auto binaryDecode = timeIt(iterations, [&] {
+        common::binaryToPathTreeJson(binary.data(), binary.size());
+    });
+    auto binaryDecodeTree = timeIt(iterations, [&] {
+        PathTree out;
+        common::binaryToPathTree(out, binary.data(), binary.size());
+    });
+
+    std::cout << "Synthetic tree: " << devices << " devices, "
+              << common::pathTreeToJson(tree).size() << " non-null nodes, "
+              << iterations << " iterations each\n";
+    std::cout << "JSON:   " << text.size() << " bytes, encode " << jsonEncode
+              << " ms, decode " << jsonDecode << " ms\n";
+    std::cout << "Binary: " << binary.size() << " bytes, encode "
+              << binaryEncode << " ms, decode to JSON nodes " << binaryDecode
+              << " ms, decode to tree " << binaryDecodeTree << " ms"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,183 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PosePredictor.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::common::PosePredictor;
+
+static OSVR_TimeValue makeTime(int milliseconds) {
+    OSVR_TimeValue ret;
+    ret.seconds = 100 + milliseconds / 1000;
+    ret.microseconds = (milliseconds % 1000) * 1000;
+    return ret;
+}
+
+static OSVR_PoseReport makePose(double x, double yaw = 0) {
+    OSVR_PoseReport report;
+    report.sensor = 0;
+    osvrPose3SetIdentity(&report.pose);
+    report.pose.translation.data[0] = x;
+    report.pose.rotation.data[0] = std::cos(yaw / 2);
+    report.pose.rotation.data[2] = std::sin(yaw / 2);
+    return report;
+}
+
+/// Rotation about Y, from a quaternion known to be about Y.
+static double getYaw(OSVR_PoseState const &pose) {
+    return 2 * std::atan2(pose.rotation.data[2], pose.rotation.data[0]);
+}
+
+TEST(PosePredictor, NoPoseFails) {
+    PosePredictor predictor;
+    OSVR_PoseState pose;
+    ASSERT_FALSE(predictor.predict(makeTime(0), pose));
+}
+
+TEST(PosePredictor, NoMotionGivesLastPose) {
+    PosePredictor predictor;
+    predictor.update(makeTime(0), makePose(1, 0.5));
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(50), pose));
+    ASSERT_DOUBLE_EQ(pose.translation.data[0], 1);
+    ASSERT_NEAR(getYaw(pose), 0.5, 1e-9);
+}
+
+TEST(PosePredictor, UsesReportedVelocity) {
+    PosePredictor predictor;
+    OSVR_VelocityReport vel = {};
+    vel.state.linearVelocity = {{2, 0, 0}};
+    vel.state.linearVelocityValid = OSVR_TRUE;
+    // 1 rad/s about Y, expressed as the rotation over 10 ms.
+    vel.state.angularVelocity.dt = 0.01;
+    vel.state.angularVelocity.incrementalRotation = {
+        {std::cos(0.005), 0, std::sin(0.005), 0}};
+    vel.state.angularVelocityValid = OSVR_TRUE;
+    predictor.update(makeTime(0), vel);
+    predictor.update(makeTime(0), makePose(1));
+
+    // Poses that disagree with the reported velocity don't override it.
+    predictor.update(makeTime(10), makePose(1));
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(60), pose));
+    ASSERT_NEAR(pose.translation.data[0], 1.1, 1e-9);
+    ASSERT_NEAR(getYaw(pose), 0.05, 1e-9);
+}
+
+TEST(PosePredictor, EstimatesVelocityFromPoses) {
+    PosePredictor predictor;
+    predictor.update(makeTime(0), makePose(0, 0));
+    predictor.update(makeTime(10), makePose(0.01, 0.02));
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(30), pose));
+    ASSERT_NEAR(pose.translation.data[0], 0.03, 1e-9);
+    ASSERT_NEAR(getYaw(pose), 0.06, 1e-9);
+}
+
+TEST(PosePredictor, StalePosesGiveNoVelocity) {
+    PosePredictor predictor;
+    predictor.update(makeTime(0), makePose(0));
+    predictor.update(makeTime(500), makePose(1));
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(600), pose));
+    ASSERT_DOUBLE_EQ(pose.translation.data[0], 1);
+}
+
+TEST(PosePredictor, PredictionIsCapped) {
+    PosePredictor predictor;
+    predictor.update(makeTime(0), makePose(0));
+    predictor.update(makeTime(10), makePose(0.01));
+
+    OSVR_PoseState soon;
+    OSVR_PoseState later;
+    ASSERT_TRUE(predictor.predict(makeTime(1000), soon));
+    ASSERT_TRUE(predictor.predict(makeTime(5000), later));
+    ASSERT_LT(soon.translation.data[0], 1);
+    ASSERT_DOUBLE_EQ(soon.translation.data[0], later.translation.data[0]);
+}
+
+TEST(PosePredictor, NoBackwardExtrapolation) {
+    PosePredictor predictor;
+    predictor.update(makeTime(100), makePose(0));
+    predictor.update(makeTime(110), makePose(0.01));
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(0), pose));
+    ASSERT_DOUBLE_EQ(pose.translation.data[0], 0.01);
+}
+
+TEST(PosePredictor, StoppedVelocityReportsFallBackToPoses) {
+    PosePredictor predictor;
+    OSVR_VelocityReport vel = {};
+    vel.state.linearVelocity = {{5, 0, 0}};
+    vel.state.linearVelocityValid = OSVR_TRUE;
+    predictor.update(makeTime(0), vel);
+    predictor.update(makeTime(0), makePose(0));
+
+    // Velocity reports stop, while the poses show 1 m/s.
+    for (int ms = 10; ms <= 300; ms += 10) {
+        predictor.update(makeTime(ms), makePose(ms / 1000.));
+    }
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(400), pose));
+    ASSERT_NEAR(pose.translation.data[0], 0.4, 1e-9);
+}
+
+TEST(PosePredictor, BackwardsTimestampsStillUpdatePose) {
+    PosePredictor predictor;
+    predictor.update(makeTime(1000), makePose(0));
+    predictor.update(makeTime(1010), makePose(0.01));
+
+    // The clock steps back, as after a server restart.
+    predictor.update(makeTime(0), makePose(2));
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(50), pose));
+    ASSERT_DOUBLE_EQ(pose.translation.data[0], 2)
+        << "Should use the latest pose, without the old velocity";
+
+    // And carries on from there.
+    predictor.update(makeTime(10), makePose(2.01));
+    ASSERT_TRUE(predictor.predict(makeTime(30), pose));
+    ASSERT_NEAR(pose.translation.data[0], 2.03, 1e-9);
+}
+
+TEST(PosePredictor, RepeatedTimestampKeepsLatestPose) {
+    PosePredictor predictor;
+    predictor.update(makeTime(0), makePose(0));
+    predictor.update(makeTime(0), makePose(1));
+    OSVR_PoseState pose;
+    ASSERT_TRUE(predictor.predict(makeTime(50), pose));
+    ASSERT_DOUBLE_EQ(pose.translation.data[0], 1);
+}
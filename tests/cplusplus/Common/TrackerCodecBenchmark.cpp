@@ -0,0 +1,185 @@
+/** @file
+    @brief Implementation of a manual benchmark comparing encoding and
+   decoding pose reports as VRPN tracker messages with the native tracker
+   messages, in double and single precision, singly and in batches.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerComponentSerialization.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Util/QuatlibInteropC.h>
+
+// Library/third-party includes
+#include <vrpn_Shared.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace common = osvr::common;
+namespace messages = osvr::common::messages;
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+template <typename F> static double timeIt(int iterations, F &&f) {
+    auto begin = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        f(i);
+    }
+    auto elapsed = clock_type::now() - begin;
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           iterations;
+}
+
+/// @brief Lays out a pose the way vrpn_Tracker::encode_to does.
+static vrpn_int32 vrpnEncode(char *buf, vrpn_int32 sensor,
+                             q_vec_type const pos, q_type const quat) {
+    char *bufptr = buf;
+    vrpn_int32 buflen = 1000;
+    vrpn_buffer(&bufptr, &buflen, sensor);
+    vrpn_buffer(&bufptr, &buflen, sensor); // padding
+    for (int i = 0; i < 3; ++i) {
+        vrpn_buffer(&bufptr, &buflen, pos[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        vrpn_buffer(&bufptr, &buflen, quat[i]);
+    }
+    return 1000 - buflen;
+}
+
+/// @brief What vrpn_Tracker_Remote and the tracker remote handler do with a
+/// VRPN pose message: unbuffer into quatlib types, then convert.
+static OSVR_PoseReport vrpnDecode(const char *buf) {
+    vrpn_int32 sensor;
+    vrpn_int32 padding;
+    q_vec_type pos;
+    q_type quat;
+    vrpn_unbuffer(&buf, &sensor);
+    vrpn_unbuffer(&buf, &padding);
+    for (int i = 0; i < 3; ++i) {
+        vrpn_unbuffer(&buf, &pos[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        vrpn_unbuffer(&buf, &quat[i]);
+    }
+    OSVR_PoseReport report;
+    report.sensor = sensor;
+    osvrVec3FromQuatlib(&(report.pose.translation), pos);
+    osvrQuatFromQuatlib(&(report.pose.rotation), quat);
+    return report;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = 1000000;
+    if (argc > 1) {
+        iterations = std::atoi(argv[1]);
+    }
+    OSVR_PoseReport report;
+    report.sensor = 0;
+    report.pose.translation = {{0.1, 0.2, 0.3}};
+    report.pose.rotation = {{1, 0, 0, 0}};
+    q_vec_type pos = {0.1, 0.2, 0.3};
+    q_type quat = {0, 0, 0, 1};
+
+    /// Sum something from each decoded report so nothing gets optimized out.
+    double sink = 0;
+
+    char vrpnBuf[1000];
+    vrpn_int32 vrpnBytes = 0;
+    auto vrpnEnc = timeIt(iterations, [&](int i) {
+        pos[0] = i;
+        vrpnBytes = vrpnEncode(vrpnBuf, 0, pos, quat);
+    });
+    auto vrpnDec = timeIt(iterations, [&](int) {
+        sink += vrpnDecode(vrpnBuf).pose.translation.data[0];
+    });
+    std::cout << "VRPN:          " << vrpnBytes << " bytes, encode " << vrpnEnc
+              << " ns, decode " << vrpnDec << " ns\n";
+
+    for (auto precision :
+         {common::TrackerPrecision::Double, common::TrackerPrecision::Float}) {
+        common::Buffer<> buf;
+        auto enc = timeIt(iterations, [&](int i) {
+            report.pose.translation.data[0] = i;
+            // As TrackerComponent does, reusing the buffer's storage.
+            buf.getContents().clear();
+            messages::TrackerPoseRecord::MessageSerialization msg(report,
+                                                                  precision);
+            common::serialize(buf, msg);
+        });
+        auto dec = timeIt(iterations, [&](int) {
+            auto reader = buf.startReading();
+            messages::TrackerPoseRecord::MessageSerialization msg;
+            common::deserialize(reader, msg);
+            sink += msg.getReport().pose.translation.data[0];
+        });
+        std::cout << "Native "
+                  << (precision == common::TrackerPrecision::Float ? "float: "
+                                                                   : "double:")
+                  << " " << buf.size() << " bytes, encode " << enc
+                  << " ns, decode " << dec << " ns\n";
+    }
+
+    /// A skeleton's worth of sensors updated at once: separate messages, each
+    /// also paying for its own header on the wire, versus one batch.
+    const int sensors = 20;
+    std::vector<OSVR_PoseReport> skeleton(sensors, report);
+    for (int s = 0; s < sensors; ++s) {
+        skeleton[s].sensor = s;
+    }
+    std::size_t separateBytes = 0;
+    auto separateEnc = timeIt(iterations / sensors, [&](int) {
+        separateBytes = 0;
+        for (auto const &r : skeleton) {
+            vrpnEncode(vrpnBuf, r.sensor, pos, quat);
+            separateBytes += vrpnBytes;
+        }
+    });
+    common::Buffer<> batchBuf;
+    auto batchEnc = timeIt(iterations / sensors, [&](int i) {
+        skeleton[0].pose.translation.data[0] = i;
+        batchBuf.getContents().clear();
+        messages::TrackerPoseBatchRecord::MessageSerialization msg(
+            skeleton, common::TrackerPrecision::Double);
+        common::serialize(batchBuf, msg);
+    });
+    auto batchDec = timeIt(iterations / sensors, [&](int) {
+        auto reader = batchBuf.startReading();
+        messages::TrackerPoseBatchRecord::MessageSerialization msg(
+            reader.bytesRemaining());
+        common::deserialize(reader, msg);
+        sink += msg.getReports().back().pose.translation.data[0];
+    });
+    std::cout << sensors << " sensors, VRPN: " << sensors
+              << " messages, " << separateBytes << " bytes, encode "
+              << separateEnc << " ns\n";
+    std::cout << sensors << " sensors, batch: 1 message, " << batchBuf.size()
+              << " bytes, encode " << batchEnc << " ns, decode " << batchDec
+              << " ns\n";
+
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,223 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerComponentSerialization.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::Buffer;
+using osvr::common::TrackerPrecision;
+namespace messages = osvr::common::messages;
+
+static OSVR_PoseReport makePoseReport() {
+    OSVR_PoseReport report;
+    report.sensor = 3;
+    report.pose.translation = {{0.1, -2.5, 1e-3}};
+    report.pose.rotation = {{0.5, -0.5, 0.5, 0.5}};
+    return report;
+}
+
+template <typename Message, typename Report>
+static Report roundTrip(Report const &report, TrackerPrecision precision,
+                        std::size_t *bytes = nullptr) {
+    Buffer<> buf;
+    Message out(report, precision);
+    osvr::common::serialize(buf, out);
+    if (bytes) {
+        *bytes = buf.size();
+    }
+    auto reader = buf.startReading();
+    Message in;
+    osvr::common::deserialize(reader, in);
+    EXPECT_EQ(reader.bytesRemaining(), 0);
+    return in.getReport();
+}
+
+TEST(TrackerComponentSerialization, PoseDoubleIsExact) {
+    auto report = makePoseReport();
+    auto result = roundTrip<messages::TrackerPoseRecord::MessageSerialization>(
+        report, TrackerPrecision::Double);
+    ASSERT_EQ(result.sensor, report.sensor);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(result.pose.translation.data[i],
+                  report.pose.translation.data[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(result.pose.rotation.data[i], report.pose.rotation.data[i]);
+    }
+}
+
+TEST(TrackerComponentSerialization, PoseFloatIsCloseAndSmaller) {
+    auto report = makePoseReport();
+    std::size_t doubleBytes = 0;
+    std::size_t floatBytes = 0;
+    roundTrip<messages::TrackerPoseRecord::MessageSerialization>(
+        report, TrackerPrecision::Double, &doubleBytes);
+    auto result = roundTrip<messages::TrackerPoseRecord::MessageSerialization>(
+        report, TrackerPrecision::Float, &floatBytes);
+    ASSERT_LT(floatBytes, doubleBytes);
+    ASSERT_EQ(result.sensor, report.sensor);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_FLOAT_EQ(result.pose.translation.data[i],
+                        report.pose.translation.data[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_FLOAT_EQ(result.pose.rotation.data[i],
+                        report.pose.rotation.data[i]);
+    }
+}
+
+TEST(TrackerComponentSerialization, VelocityCarriesOnlyValidParts) {
+    OSVR_VelocityReport both = {};
+    both.sensor = 1;
+    both.state.linearVelocity = {{1, 2, 3}};
+    both.state.linearVelocityValid = OSVR_TRUE;
+    both.state.angularVelocity.incrementalRotation = {{1, 0, 0, 0}};
+    both.state.angularVelocity.dt = 0.01;
+    both.state.angularVelocityValid = OSVR_TRUE;
+
+    auto linearOnly = both;
+    linearOnly.state.angularVelocityValid = OSVR_FALSE;
+
+    std::size_t bothBytes = 0;
+    std::size_t linearBytes = 0;
+    roundTrip<messages::TrackerVelocityRecord::MessageSerialization>(
+        both, TrackerPrecision::Double, &bothBytes);
+    auto result =
+        roundTrip<messages::TrackerVelocityRecord::MessageSerialization>(
+            linearOnly, TrackerPrecision::Double, &linearBytes);
+    ASSERT_LT(linearBytes, bothBytes);
+    ASSERT_EQ(result.sensor, 1);
+    ASSERT_TRUE(result.state.linearVelocityValid);
+    ASSERT_FALSE(result.state.angularVelocityValid);
+    ASSERT_EQ(result.state.linearVelocity.data[2], 3);
+}
+
+TEST(TrackerComponentSerialization, AccelerationFloat) {
+    OSVR_AccelerationReport report = {};
+    report.sensor = 0;
+    report.state.angularAcceleration.incrementalRotation = {
+        {0.9999, 0.01, 0, 0}};
+    report.state.angularAcceleration.dt = 0.002;
+    report.state.angularAccelerationValid = OSVR_TRUE;
+
+    auto result =
+        roundTrip<messages::TrackerAccelerationRecord::MessageSerialization>(
+            report, TrackerPrecision::Float);
+    ASSERT_FALSE(result.state.linearAccelerationValid);
+    ASSERT_TRUE(result.state.angularAccelerationValid);
+    ASSERT_FLOAT_EQ(result.state.angularAcceleration.dt, 0.002);
+    ASSERT_FLOAT_EQ(
+        result.state.angularAcceleration.incrementalRotation.data[1], 0.01);
+}
+
+TEST(TrackerComponentSerialization, PoseBatch) {
+    std::vector<OSVR_PoseReport> reports;
+    for (int i = 0; i < 20; ++i) {
+        auto report = makePoseReport();
+        report.sensor = i;
+        report.pose.translation.data[0] = i;
+        reports.push_back(report);
+    }
+    Buffer<> buf;
+    messages::TrackerPoseBatchRecord::MessageSerialization out(
+        reports, TrackerPrecision::Double);
+    osvr::common::serialize(buf, out);
+
+    auto reader = buf.startReading();
+    messages::TrackerPoseBatchRecord::MessageSerialization in(
+        reader.bytesRemaining());
+    osvr::common::deserialize(reader, in);
+    ASSERT_EQ(reader.bytesRemaining(), 0);
+    auto const &result = in.getReports();
+    ASSERT_EQ(result.size(), reports.size());
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        ASSERT_EQ(result[i].sensor, reports[i].sensor);
+        ASSERT_EQ(result[i].pose.translation.data[0],
+                  reports[i].pose.translation.data[0]);
+        ASSERT_EQ(result[i].pose.rotation.data[3],
+                  reports[i].pose.rotation.data[3]);
+    }
+}
+
+TEST(TrackerComponentSerialization, EmptyPoseBatch) {
+    Buffer<> buf;
+    messages::TrackerPoseBatchRecord::MessageSerialization out(
+        std::vector<OSVR_PoseReport>(), TrackerPrecision::Float);
+    osvr::common::serialize(buf, out);
+
+    auto reader = buf.startReading();
+    messages::TrackerPoseBatchRecord::MessageSerialization in(
+        reader.bytesRemaining());
+    osvr::common::deserialize(reader, in);
+    ASSERT_EQ(reader.bytesRemaining(), 0);
+    ASSERT_TRUE(in.getReports().empty());
+}
+
+TEST(TrackerComponentSerialization, TruncatedPoseBatch) {
+    std::vector<OSVR_PoseReport> reports(5, makePoseReport());
+    for (auto precision :
+         {TrackerPrecision::Float, TrackerPrecision::Double}) {
+        Buffer<> buf;
+        messages::TrackerPoseBatchRecord::MessageSerialization out(reports,
+                                                                   precision);
+        osvr::common::serialize(buf, out);
+
+        {
+            auto reader = buf.startReading();
+            messages::TrackerPoseBatchRecord::MessageSerialization in(
+                buf.size());
+            osvr::common::deserialize(reader, in);
+            ASSERT_TRUE(in.isValid());
+            ASSERT_EQ(in.getReports().size(), reports.size());
+        }
+        auto reader = buf.startReading();
+        messages::TrackerPoseBatchRecord::MessageSerialization in(buf.size() -
+                                                                  1);
+        osvr::common::deserialize(reader, in);
+        ASSERT_FALSE(in.isValid());
+        ASSERT_TRUE(in.getReports().empty());
+    }
+}
+
+TEST(TrackerComponentSerialization, OversizedPoseBatch) {
+    /// A count claiming far more entries than the message holds.
+    Buffer<> buf;
+    osvr::common::serialization::serializeRaw(
+        buf, TrackerPrecision::Double,
+        messages::detail::TrackerPrecisionTag());
+    osvr::common::serialization::serializeRaw(buf, uint32_t(0xffffffff));
+    auto reader = buf.startReading();
+    messages::TrackerPoseBatchRecord::MessageSerialization in(buf.size());
+    osvr::common::deserialize(reader, in);
+    ASSERT_FALSE(in.isValid());
+    ASSERT_TRUE(in.getReports().empty());
+}
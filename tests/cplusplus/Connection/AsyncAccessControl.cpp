@@ -82,6 +82,27 @@ TEST(AsyncAccessControl, simple) {
         << "CTS should have no tasks waiting.";
 }
 
+TEST(AsyncAccessControl, wakeupFollowsRequest) {
+    AsyncAccessControl control;
+    volatile bool woken = false;
+    volatile bool sent = false;
+
+    ScopedThread asyncThread(new boost::thread([&] {
+        RequestToSend rts(control);
+        ASSERT_TRUE(rts.request([&] { woken = true; }))
+            << "Request should be approved";
+        sent = true;
+    }));
+
+    while (!woken) {
+        pleaseYield();
+    }
+    // A main thread woken by the callback must find the request already
+    // there: a single CTS has to handle it.
+    ASSERT_TRUE(control.mainThreadCTS()) << "Request should be visible";
+    ASSERT_TRUE(sent) << "Should have sent";
+}
+
 TEST(AsyncAccessControl, serialRequests) {
     AsyncAccessControl control;
     volatile bool sent1 = false;
@@ -0,0 +1,124 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/AsyncSendQueue.h"
+#include "../../../src/osvr/Connection/AsyncSendQueue.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+using namespace osvr::connection;
+
+namespace {
+/// We never dereference message types in the queue, so any distinct pointer
+/// will do.
+MessageType *fakeType(int i) {
+    return reinterpret_cast<MessageType *>(static_cast<std::size_t>(i + 1));
+}
+osvr::util::time::TimeValue makeTime(int i) {
+    osvr::util::time::TimeValue ret;
+    ret.seconds = i;
+    ret.microseconds = 0;
+    return ret;
+}
+} // namespace
+
+TEST(AsyncSendQueue, rejectsZeroCapacity) {
+    ASSERT_THROW(AsyncSendQueue(0), std::invalid_argument);
+}
+
+TEST(AsyncSendQueue, drainsInOrder) {
+    AsyncSendQueue queue(8);
+    for (int i = 0; i < 5; ++i) {
+        auto payload = std::to_string(i);
+        ASSERT_TRUE(queue.push(makeTime(i), fakeType(i), payload.data(),
+                               payload.size()));
+    }
+    ASSERT_EQ(5u, queue.getStats().depth);
+
+    int expected = 0;
+    auto n = queue.drain([&](AsyncSendQueue::Message const &msg) {
+        ASSERT_EQ(expected, msg.timestamp.seconds);
+        ASSERT_EQ(fakeType(expected), msg.type);
+        ASSERT_EQ(std::to_string(expected),
+                  std::string(msg.data.begin(), msg.data.end()));
+        ++expected;
+    });
+    ASSERT_EQ(5u, n);
+
+    auto stats = queue.getStats();
+    ASSERT_EQ(5u, stats.enqueued);
+    ASSERT_EQ(5u, stats.drained);
+    ASSERT_EQ(0u, stats.dropped);
+    ASSERT_EQ(0u, stats.depth);
+    ASSERT_EQ(5u, stats.maxDepth);
+}
+
+TEST(AsyncSendQueue, dropsWhenFull) {
+    AsyncSendQueue queue(2);
+    const char data[] = "abc";
+    ASSERT_TRUE(queue.push(makeTime(0), fakeType(0), data, sizeof(data)));
+    ASSERT_TRUE(queue.push(makeTime(1), fakeType(0), data, sizeof(data)));
+    ASSERT_FALSE(queue.push(makeTime(2), fakeType(0), data, sizeof(data)));
+    ASSERT_EQ(1u, queue.getStats().dropped);
+
+    ASSERT_EQ(2u, queue.drain([](AsyncSendQueue::Message const &) {}));
+    ASSERT_TRUE(queue.push(makeTime(3), fakeType(0), data, sizeof(data)))
+        << "Slots should be recycled after a drain";
+}
+
+TEST(AsyncSendQueue, multipleProducers) {
+    static const int PER_THREAD = 1000;
+    static const int THREADS = 4;
+    AsyncSendQueue queue(THREADS * PER_THREAD);
+    std::vector<boost::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&queue, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                queue.push(makeTime(i), fakeType(t), "x", 1);
+            }
+        });
+    }
+    std::vector<int> lastSeen(THREADS, -1);
+    std::size_t total = 0;
+    auto consume = [&](AsyncSendQueue::Message const &msg) {
+        auto t = static_cast<int>(reinterpret_cast<std::size_t>(msg.type)) - 1;
+        ASSERT_LT(lastSeen[t], msg.timestamp.seconds)
+            << "Messages from one producer should stay in order";
+        lastSeen[t] = static_cast<int>(msg.timestamp.seconds);
+    };
+    for (auto &thread : producers) {
+        thread.join();
+    }
+    total += queue.drain(consume);
+    ASSERT_EQ(std::size_t(THREADS * PER_THREAD), total);
+    ASSERT_EQ(0u, queue.getStats().dropped);
+}
@@ -0,0 +1,259 @@
+/** @file
+    @brief Implementation of a benchmark comparing a Kalman correction with
+   many image-point (beacon) measurements applied one at a time against
+   applying them all in a single batch correction.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/FlexibleKalmanBatchCorrection.h>
+#include <osvr/Kalman/PoseDampedConstantVelocity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using ProcessModel = osvr::kalman::PoseDampedConstantVelocityProcessModel;
+using State = ProcessModel::State;
+namespace types = osvr::kalman::types;
+
+static const double FOCAL_LENGTH = 700.;
+static const double MEASUREMENT_VARIANCE = 0.25;
+
+/// A beacon at a known location on the body, seen by a pinhole camera at the
+/// origin looking down +z: much like the video tracker's measurements, minus
+/// the beacon autocalibration.
+class ImagePointMeasurement {
+  public:
+    static const types::DimensionType DIMENSION = 2;
+    using Vector = types::Vector<DIMENSION>;
+    using SquareMatrix = types::SquareMatrix<DIMENSION>;
+    using Jacobian = types::Matrix<DIMENSION, 12>;
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    ImagePointMeasurement(Eigen::Vector3d const &beacon,
+                          Vector const &measurement)
+        : m_beacon(beacon), m_measurement(measurement) {}
+
+    static Vector project(Eigen::Vector3d const &pt) {
+        return pt.head<2>() / pt.z() * FOCAL_LENGTH;
+    }
+
+    Eigen::Vector3d rotatedBeacon(State const &state) const {
+        return state.getCombinedQuaternion() * m_beacon;
+    }
+
+    Vector getResidual(State const &state) const {
+        return m_measurement -
+               project(rotatedBeacon(state) + state.position());
+    }
+
+    Jacobian getJacobian(State const &state) const {
+        Eigen::Vector3d rotated = rotatedBeacon(state);
+        Eigen::Vector3d pt = rotated + state.position();
+        types::Matrix<2, 3> projection;
+        projection << 1. / pt.z(), 0, -pt.x() / (pt.z() * pt.z()), 0,
+            1. / pt.z(), -pt.y() / (pt.z() * pt.z());
+        projection *= FOCAL_LENGTH;
+        Eigen::Matrix3d cross;
+        cross << 0, -rotated.z(), rotated.y(), rotated.z(), 0, -rotated.x(),
+            -rotated.y(), rotated.x(), 0;
+        // The incremental rotation's exponential map rotates by twice its
+        // magnitude.
+        Jacobian ret;
+        ret << projection, -2. * projection * cross,
+            types::Matrix<2, 6>::Zero();
+        return ret;
+    }
+
+    SquareMatrix getCovariance(State const &) const {
+        return Vector::Constant(MEASUREMENT_VARIANCE).asDiagonal();
+    }
+
+  private:
+    Eigen::Vector3d m_beacon;
+    Vector m_measurement;
+};
+
+using Measurements =
+    std::vector<ImagePointMeasurement,
+                Eigen::aligned_allocator<ImagePointMeasurement>>;
+
+/// A frame's worth of measurements of beacons spread over the front of a
+/// head-sized body a meter from the camera, along with a prior state a few
+/// millimeters and a degree or so off.
+struct Frame {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    State truth;
+    State prior;
+    Measurements measurements;
+};
+
+Frame makeFrame(std::size_t numBeacons, std::mt19937 &gen) {
+    std::normal_distribution<double> normal;
+    Frame ret;
+    ret.truth.position() = Eigen::Vector3d(0.05, -0.02, 1.);
+    ret.truth.setQuaternion(Eigen::Quaterniond(
+        Eigen::AngleAxisd(0.3, Eigen::Vector3d(0.2, 1, 0.1).normalized())));
+
+    ret.prior = ret.truth;
+    ret.prior.position() +=
+        Eigen::Vector3d(normal(gen), normal(gen), normal(gen)) * 0.005;
+    ret.prior.setQuaternion(
+        Eigen::Quaterniond(Eigen::AngleAxisd(
+            0.02, Eigen::Vector3d(normal(gen), normal(gen), normal(gen))
+                      .normalized())) *
+        ret.truth.getQuaternion());
+    ret.prior.setErrorCovariance(
+        (types::Vector<12>() << Eigen::Vector3d::Constant(1e-4),
+         Eigen::Vector3d::Constant(1e-3), Eigen::Vector3d::Constant(1e-2),
+         Eigen::Vector3d::Constant(1e-1))
+            .finished()
+            .asDiagonal());
+
+    for (std::size_t i = 0; i < numBeacons; ++i) {
+        Eigen::Vector3d beacon(normal(gen), normal(gen),
+                               -std::abs(normal(gen)));
+        beacon = beacon.normalized() * 0.1;
+        ImagePointMeasurement::Vector noise(normal(gen), normal(gen));
+        Eigen::Vector3d inCamera =
+            ret.truth.getCombinedQuaternion() * beacon + ret.truth.position();
+        ImagePointMeasurement::Vector measured =
+            ImagePointMeasurement::project(inCamera) +
+            noise * std::sqrt(MEASUREMENT_VARIANCE);
+        ret.measurements.emplace_back(beacon, measured);
+    }
+    return ret;
+}
+
+/// The way the SCAAT estimator does it: one full correction per beacon, each
+/// re-linearized about the state left by the last.
+void correctSequentially(Frame const &frame, State &state) {
+    ProcessModel model;
+    state = frame.prior;
+    for (auto meas : frame.measurements) {
+        osvr::kalman::correct(state, model, meas);
+    }
+}
+
+void correctBatched(Frame const &frame, State &state,
+                    osvr::kalman::CovarianceUpdate update) {
+    state = frame.prior;
+    osvr::kalman::BatchCorrection<State> batch;
+    for (auto meas : frame.measurements) {
+        batch.add(state, meas);
+    }
+    batch.correct(state, update);
+}
+
+/// In degrees.
+double orientationDifference(State const &a, State const &b) {
+    return a.getCombinedQuaternion().angularDistance(
+               b.getCombinedQuaternion()) *
+           180. / M_PI;
+}
+
+/// In millimeters.
+double positionDifference(State const &a, State const &b) {
+    return (a.position() - b.position()).norm() * 1000.;
+}
+
+/// Frobenius norm of the difference, relative to that of b.
+double covarianceDifference(State const &a, State const &b) {
+    return (a.errorCovariance() - b.errorCovariance()).norm() /
+           b.errorCovariance().norm();
+}
+
+typedef std::chrono::steady_clock clock_type;
+
+template <typename F> double microsecondsPerFrame(int frames, F &&f) {
+    auto begin = clock_type::now();
+    for (int i = 0; i < frames; ++i) {
+        f();
+    }
+    return std::chrono::duration<double, std::micro>(clock_type::now() -
+                                                      begin)
+               .count() /
+           frames;
+}
+
+int main() {
+    static const int FRAMES = 20000;
+    std::mt19937 gen(5489u);
+    for (std::size_t numBeacons = 10; numBeacons <= 40; numBeacons += 10) {
+        auto frame = makeFrame(numBeacons, gen);
+        State sequential;
+        State batched;
+        State joseph;
+        correctSequentially(frame, sequential);
+        correctBatched(frame, batched,
+                       osvr::kalman::CovarianceUpdate::Standard);
+        correctBatched(frame, joseph, osvr::kalman::CovarianceUpdate::Joseph);
+
+        std::cout << numBeacons << " beacons:\n";
+        std::cout << "  Position error (mm): prior "
+                  << positionDifference(frame.prior, frame.truth)
+                  << ", sequential "
+                  << positionDifference(sequential, frame.truth)
+                  << ", batched " << positionDifference(batched, frame.truth)
+                  << "\n";
+        std::cout << "  Orientation error (deg): prior "
+                  << orientationDifference(frame.prior, frame.truth)
+                  << ", sequential "
+                  << orientationDifference(sequential, frame.truth)
+                  << ", batched "
+                  << orientationDifference(batched, frame.truth) << "\n";
+        std::cout << "  Batched vs sequential: position "
+                  << positionDifference(batched, sequential)
+                  << " mm, orientation "
+                  << orientationDifference(batched, sequential)
+                  << " deg, covariance relative difference "
+                  << covarianceDifference(batched, sequential) << "\n";
+        std::cout << "  Joseph form vs standard: covariance relative "
+                     "difference "
+                  << covarianceDifference(joseph, batched) << "\n";
+
+        State state;
+        auto sequentialTime = microsecondsPerFrame(
+            FRAMES, [&] { correctSequentially(frame, state); });
+        auto batchedTime = microsecondsPerFrame(FRAMES, [&] {
+            correctBatched(frame, state,
+                           osvr::kalman::CovarianceUpdate::Standard);
+        });
+        auto josephTime = microsecondsPerFrame(FRAMES, [&] {
+            correctBatched(frame, state,
+                           osvr::kalman::CovarianceUpdate::Joseph);
+        });
+        std::cout << "  Per frame: sequential " << sequentialTime
+                  << " us, batched " << batchedTime
+                  << " us, batched (Joseph form) " << josephTime << " us"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/** @file
+    @brief Implementation of a benchmark comparing Kalman predictions made
+   with the dense A P A^T + Q error covariance update against those made with
+   the kernel for constant-velocity process models.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/PoseConstantVelocity.h>
+#include <osvr/Kalman/PoseDampedConstantVelocity.h>
+#include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <iostream>
+
+namespace kalman = osvr::kalman;
+
+/// About the IMU sample interval.
+static const double DT = 0.002;
+static const int PREDICTIONS = 1000000;
+
+/// What predictState() did before it could pick a kernel: the same state
+/// prediction, with the error covariance done the dense way.
+template <typename ProcessModel>
+void predictDense(typename ProcessModel::State &state, ProcessModel &model,
+                  double dt) {
+    auto Pminus = kalman::predictErrorCovariance(
+        state, model, dt, kalman::DenseStateTransition{});
+    state.setStateVector(model.computeEstimate(state, dt));
+    state.setErrorCovariance(Pminus);
+}
+
+typedef std::chrono::steady_clock clock_type;
+
+/// Starting from a state with some velocity and correlation, predict over
+/// and over. Returns predictions per second.
+template <typename ProcessModel, typename F>
+double predictionsPerSecond(ProcessModel &model, F &&predictFunc,
+                            typename ProcessModel::State &state) {
+    state = typename ProcessModel::State{};
+    state.velocity() = Eigen::Vector3d(0.1, -0.2, 0.05);
+    state.angularVelocity() = Eigen::Vector3d(0.3, 0.1, -0.2);
+    auto begin = clock_type::now();
+    for (int i = 0; i < PREDICTIONS; ++i) {
+        predictFunc(state, model, DT);
+    }
+    return PREDICTIONS / std::chrono::duration<double>(clock_type::now() -
+                                                        begin)
+                             .count();
+}
+
+template <typename ProcessModel> void benchmark(const char name[]) {
+    using State = typename ProcessModel::State;
+    ProcessModel model;
+    State dense;
+    State structured;
+    auto denseRate = predictionsPerSecond(
+        model, [](State &s, ProcessModel &m,
+                  double dt) { predictDense(s, m, dt); },
+        dense);
+    auto structuredRate = predictionsPerSecond(
+        model, [](State &s, ProcessModel &m,
+                  double dt) { kalman::predict(s, m, dt); },
+        structured);
+    std::cout << name << ":\n"
+              << "  Predictions per second: dense " << denseRate
+              << ", structured " << structuredRate << " ("
+              << structuredRate / denseRate << "x)\n"
+              << "  Covariance relative difference after " << PREDICTIONS
+              << " predictions: "
+              << (structured.errorCovariance() - dense.errorCovariance())
+                         .norm() /
+                     dense.errorCovariance().norm()
+              << std::endl;
+}
+
+int main() {
+    benchmark<kalman::PoseConstantVelocityProcessModel>(
+        "PoseConstantVelocityProcessModel");
+    benchmark<kalman::PoseDampedConstantVelocityProcessModel>(
+        "PoseDampedConstantVelocityProcessModel");
+    benchmark<kalman::PoseSeparatelyDampedConstantVelocityProcessModel>(
+        "PoseSeparatelyDampedConstantVelocityProcessModel");
+    return 0;
+}
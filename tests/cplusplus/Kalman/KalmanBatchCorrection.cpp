@@ -0,0 +1,132 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ContentsInvalid.h"
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/FlexibleKalmanBatchCorrection.h>
+#include <osvr/Kalman/PoseConstantVelocity.h>
+#include <osvr/Kalman/AbsolutePositionMeasurement.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using ProcessModel = osvr::kalman::PoseConstantVelocityProcessModel;
+using State = ProcessModel::State;
+using AbsolutePositionMeasurement =
+    osvr::kalman::AbsolutePositionMeasurement<State>;
+using BatchCorrection = osvr::kalman::BatchCorrection<State>;
+using osvr::kalman::CovarianceUpdate;
+
+namespace {
+/// A state with some correlation between position and velocity, as after a
+/// few predictions.
+State makeState() {
+    State state;
+    ProcessModel model;
+    state.velocity() = Eigen::Vector3d(0.1, -0.2, 0.05);
+    osvr::kalman::predict(state, model, 0.1);
+    osvr::kalman::predict(state, model, 0.1);
+    return state;
+}
+
+/// Position measurements: linear in the state, so applying them one at a
+/// time or all at once should agree.
+std::vector<AbsolutePositionMeasurement> makeMeasurements() {
+    std::vector<AbsolutePositionMeasurement> ret;
+    ret.emplace_back(Eigen::Vector3d(0.1, 0.2, 0.3),
+                     Eigen::Vector3d(0.01, 0.02, 0.03));
+    ret.emplace_back(Eigen::Vector3d(0.12, 0.18, 0.31),
+                     Eigen::Vector3d(0.05, 0.01, 0.02));
+    ret.emplace_back(Eigen::Vector3d(0.09, 0.21, 0.29),
+                     Eigen::Vector3d(0.02, 0.02, 0.01));
+    return ret;
+}
+} // namespace
+
+TEST(BatchCorrection, EmptyBatchLeavesStateAlone) {
+    auto state = makeState();
+    auto orig = state;
+    BatchCorrection batch;
+    ASSERT_TRUE(batch.empty());
+    ASSERT_TRUE(batch.correct(state));
+    ASSERT_TRUE(state.stateVector().isApprox(orig.stateVector()));
+    ASSERT_TRUE(state.errorCovariance().isApprox(orig.errorCovariance()));
+}
+
+TEST(BatchCorrection, RejectsNonPositiveDefiniteCovariance) {
+    BatchCorrection batch;
+    ASSERT_FALSE(batch.add(Eigen::Matrix<double, 1, 12>::Ones(),
+                           Eigen::Matrix<double, 1, 1>::Ones(),
+                           Eigen::Matrix<double, 1, 1>::Zero()));
+    ASSERT_TRUE(batch.empty());
+}
+
+TEST(BatchCorrection, MatchesSequentialForLinearMeasurements) {
+    auto sequential = makeState();
+    auto batched = sequential;
+    ProcessModel model;
+    auto measurements = makeMeasurements();
+
+    BatchCorrection batch;
+    for (auto &meas : measurements) {
+        ASSERT_TRUE(batch.add(batched, meas));
+        osvr::kalman::correct(sequential, model, meas);
+    }
+    ASSERT_EQ(measurements.size(), batch.size());
+    ASSERT_TRUE(batch.correct(batched));
+
+    ASSERT_FALSE(stateContentsInvalid(batched));
+    ASSERT_FALSE(covarianceContentsInvalid(batched));
+    ASSERT_TRUE(batched.stateVector().isApprox(sequential.stateVector(), 1e-9))
+        << "Batched:\n"
+        << batched.stateVector().transpose() << "\nSequential:\n"
+        << sequential.stateVector().transpose();
+    ASSERT_TRUE(
+        batched.errorCovariance().isApprox(sequential.errorCovariance(), 1e-9))
+        << "Batched:\n"
+        << batched.errorCovariance() << "\nSequential:\n"
+        << sequential.errorCovariance();
+}
+
+TEST(BatchCorrection, JosephFormMatchesStandard) {
+    auto standard = makeState();
+    auto joseph = standard;
+    auto measurements = makeMeasurements();
+
+    BatchCorrection batch;
+    for (auto &meas : measurements) {
+        ASSERT_TRUE(batch.add(standard, meas));
+    }
+    ASSERT_TRUE(batch.correct(standard, CovarianceUpdate::Standard));
+    ASSERT_TRUE(batch.correct(joseph, CovarianceUpdate::Joseph));
+
+    ASSERT_FALSE(covarianceContentsInvalid(joseph));
+    ASSERT_TRUE(joseph.stateVector().isApprox(standard.stateVector()));
+    ASSERT_TRUE(
+        joseph.errorCovariance().isApprox(standard.errorCovariance(), 1e-9));
+}
@@ -0,0 +1,116 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "ContentsInvalid.h"
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/OrientationConstantVelocity.h>
+#include <osvr/Kalman/PoseConstantVelocity.h>
+#include <osvr/Kalman/PoseDampedConstantVelocity.h>
+#include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <random>
+#include <type_traits>
+
+namespace kalman = osvr::kalman;
+namespace types = osvr::kalman::types;
+
+namespace {
+/// A symmetric positive-definite matrix with plenty of correlation between
+/// all the values and derivatives.
+template <typename Matrix> Matrix makeCovariance(std::mt19937 &gen) {
+    std::uniform_real_distribution<double> dist(-1., 1.);
+    Matrix M;
+    for (typename Matrix::Index i = 0; i < M.size(); ++i) {
+        M(i) = dist(gen);
+    }
+    return M * M.transpose() + Matrix::Identity() * 0.1;
+}
+} // namespace
+
+template <typename T> class StructuredPredict : public ::testing::Test {};
+
+typedef ::testing::Types<
+    kalman::PoseConstantVelocityProcessModel,
+    kalman::PoseDampedConstantVelocityProcessModel,
+    kalman::PoseSeparatelyDampedConstantVelocityProcessModel,
+    kalman::OrientationConstantVelocityProcessModel>
+    ConstantVelocityProcessModelTypes;
+
+TYPED_TEST_CASE(StructuredPredict, ConstantVelocityProcessModelTypes);
+
+TYPED_TEST(StructuredPredict, SelectedAtCompileTime) {
+    ASSERT_TRUE((std::is_same<types::StateTransitionStructure<TypeParam>,
+                              kalman::ConstantVelocityStateTransition>::value));
+}
+
+TYPED_TEST(StructuredPredict, MatchesDenseErrorCovariance) {
+    using State = typename TypeParam::State;
+    using StateSquareMatrix = types::DimSquareMatrix<State>;
+    std::mt19937 gen(5489u);
+    TypeParam model;
+    for (double dt : {0.001, 0.01, 0.1, 1., 3.}) {
+        State state;
+        state.setErrorCovariance(makeCovariance<StateSquareMatrix>(gen));
+        StateSquareMatrix dense = kalman::predictErrorCovariance(
+            state, model, dt, kalman::DenseStateTransition{});
+        StateSquareMatrix structured = kalman::predictErrorCovariance(
+            state, model, dt, kalman::ConstantVelocityStateTransition{});
+        ASSERT_FALSE(covarianceContentsInvalid(structured));
+        ASSERT_TRUE(structured.isApprox(dense, 1e-12))
+            << "dt = " << dt << "\nStructured:\n"
+            << structured << "\nDense:\n"
+            << dense;
+    }
+}
+
+TYPED_TEST(StructuredPredict, RepeatedPredictionMatchesDense) {
+    using State = typename TypeParam::State;
+    TypeParam model;
+    State structured;
+    structured.setStateVector(
+        types::DimVector<State>::LinSpaced(-0.5, 0.5));
+    State dense = structured;
+    for (int i = 0; i < 100; ++i) {
+        kalman::predict(structured, model, 0.01);
+        // The state prediction itself is the same either way: just do the
+        // covariance the dense way.
+        auto P = kalman::predictErrorCovariance(
+            dense, model, 0.01, kalman::DenseStateTransition{});
+        dense.setStateVector(model.computeEstimate(dense, 0.01));
+        dense.setErrorCovariance(P);
+    }
+    ASSERT_FALSE(covarianceContentsInvalid(structured.errorCovariance()));
+    ASSERT_TRUE(structured.stateVector().isApprox(dense.stateVector()));
+    ASSERT_TRUE(
+        structured.errorCovariance().isApprox(dense.errorCovariance(), 1e-12))
+        << "Structured:\n"
+        << structured.errorCovariance() << "\nDense:\n"
+        << dense.errorCovariance();
+}
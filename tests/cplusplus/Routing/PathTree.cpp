@@ -34,7 +34,8 @@
 #include "gtest/gtest.h"
 
 // Standard includes
-// - none
+#include <string>
+#include <vector>
 
 using std::string;
 using namespace osvr::common;
@@ -103,3 +104,40 @@ TEST(PathTree, getPathTwoLevel) {
     ASSERT_EQ(tree.getNodeByPath("/test1/test2"), *test2)
         << "Identity should be preserved";
 }
+
+TEST(PathTree, repeatedLookupsAfterReset) {
+    PathTree tree;
+    PathNode *before = &tree.getNodeByPath("/test1/test2");
+    ASSERT_EQ(tree.getNodeByPath("/test1/test2"), *before)
+        << "Repeated lookup should give the same node";
+
+    tree.reset();
+    ASSERT_FALSE(tree.getRoot().hasChildren());
+    PathNode *after = nullptr;
+    ASSERT_NO_THROW(after = &tree.getNodeByPath("/test1/test2"));
+    ASSERT_EQ(after->getParent()->getParent(), &tree.getRoot())
+        << "Lookup after reset must give a node in the new tree";
+}
+
+TEST(PathTree, constLookupSharesNodes) {
+    PathTree tree;
+    PathTree const &constTree = tree;
+    ASSERT_THROW(constTree.getNodeByPath("/test1"),
+                 osvr::util::tree::NoSuchChild);
+    PathNode *node = &tree.getNodeByPath("/test1/test2");
+    ASSERT_EQ(&constTree.getNodeByPath("/test1/test2"), node);
+    ASSERT_EQ(&constTree.getNodeByPath("/test1"), node->getParent())
+        << "Nodes created along the way are found, cached or not";
+}
+
+TEST(PathTree, wideTree) {
+    PathTree tree;
+    std::vector<PathNode *> nodes;
+    for (int i = 0; i < 1000; ++i) {
+        nodes.push_back(&tree.getNodeByPath("/wide/" + std::to_string(i)));
+    }
+    ASSERT_EQ(1000, tree.getNodeByPath("/wide").numChildren());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(nodes[i], &tree.getNodeByPath("/wide/" + std::to_string(i)));
+    }
+}